@@ -0,0 +1,205 @@
+#ifndef __BENCH_COMMON_H___
+#define __BENCH_COMMON_H___
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+
+#ifndef PIM_BENCH_REVISION
+#define PIM_BENCH_REVISION "unknown"   ///< Source revision of the benchmark build, set by bench/Makefile
+#endif
+
+#define BENCH_MAX_LIST 32        ///< Largest number of values in a sweep list
+#define BENCH_MAX_FIELDS 64      ///< Largest number of fields in a report row
+#define BENCH_MAX_VALUE 64       ///< Largest formatted field value
+
+/**
+ * @brief Deterministic xorshift64* generator, so every run of a benchmark sees the same matrices.
+ */
+typedef struct {
+    uint64_t state;
+} bench_rng_t;
+
+static inline void bench_rng_seed(bench_rng_t* rng, uint64_t seed) {
+    // splitmix64 step so that small seeds still give well-mixed states
+    uint64_t z = seed + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    rng->state = (z ^ (z >> 31)) | 1;
+}
+
+static inline uint64_t bench_rng_next(bench_rng_t* rng) {
+    rng->state ^= rng->state >> 12;
+    rng->state ^= rng->state << 25;
+    rng->state ^= rng->state >> 27;
+    return rng->state * 0x2545f4914f6cdd1dull;
+}
+
+/**
+ * @brief Fill a buffer with random bytes.
+ */
+static inline void bench_fill_random(void* data, size_t bytes, bench_rng_t* rng) {
+    uint8_t* out = (uint8_t*)data;
+    for (size_t i = 0; i < bytes; i++) {
+        out[i] = (uint8_t)(bench_rng_next(rng) >> 56);
+    }
+}
+
+/**
+ * @brief Parse a comma separated list of unsigned integers, e.g. "64,128,256".
+ * @param text List to parse.
+ * @param values Destination of at most BENCH_MAX_LIST values.
+ * @return Number of values parsed, or -1 on malformed input.
+ */
+static inline int bench_parse_uint_list(const char* text, uint32_t* values) {
+    int count = 0;
+    const char* cursor = text;
+    while (*cursor) {
+        char* end;
+        unsigned long value = strtoul(cursor, &end, 0);
+        if (end == cursor || count == BENCH_MAX_LIST || (*end != ',' && *end != '\0')) return -1;
+        values[count++] = (uint32_t)value;
+        cursor = *end == ',' ? end + 1 : end;
+    }
+    return count;
+}
+
+/**
+ * @brief Split a comma separated list of names in place.
+ * @param text List to split; commas are replaced by terminators.
+ * @param names Destination of at most BENCH_MAX_LIST pointers into `text`.
+ * @return Number of names.
+ */
+static inline int bench_split_list(char* text, char** names) {
+    int count = 0;
+    char* save = NULL;
+    for (char* token = strtok_r(text, ",", &save); token && count < BENCH_MAX_LIST; token = strtok_r(NULL, ",", &save)) {
+        names[count++] = token;
+    }
+    return count;
+}
+
+/**
+ * @brief Writer of benchmark result rows to a CSV and a JSON file.
+ * @details Every row is a list of named fields. The CSV header is taken from the first row, so all rows of a report
+ *          must have the same fields in the same order. The JSON file holds
+ *          `{"benchmark": name, "revision": rev, "timestamp": utc, "seed": seed, "results": [ {field: value, ...}, ... ]}`,
+ *          so reports kept over time can be matched to the source revision they measured.
+ */
+typedef struct {
+    FILE* csv;
+    FILE* json;
+    uint32_t rows;
+    uint32_t num_fields;
+    char keys[BENCH_MAX_FIELDS][BENCH_MAX_VALUE];
+    char values[BENCH_MAX_FIELDS][BENCH_MAX_VALUE];
+    bool quoted[BENCH_MAX_FIELDS];
+} bench_report_t;
+
+/**
+ * @brief Open the report files.
+ * @param report Report to initialise.
+ * @param name Benchmark name written into the JSON file.
+ * @param seed Seed of the input data, written into the JSON file.
+ * @param csv_path CSV destination, "-" for stdout or NULL for none.
+ * @param json_path JSON destination, "-" for stdout or NULL for none.
+ * @return 0 on success, -1 if a file cannot be opened.
+ */
+static inline int bench_report_open(bench_report_t* report, const char* name, uint64_t seed, const char* csv_path, const char* json_path) {
+    memset(report, 0, sizeof(*report));
+    if (csv_path) {
+        report->csv = strcmp(csv_path, "-") == 0 ? stdout : fopen(csv_path, "w");
+        if (!report->csv) {
+            fprintf(stderr, "Failed to open %s\n", csv_path);
+            return -1;
+        }
+    }
+    if (json_path) {
+        report->json = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (!report->json) {
+            fprintf(stderr, "Failed to open %s\n", json_path);
+            if (report->csv && report->csv != stdout) fclose(report->csv);
+            report->csv = NULL;
+            return -1;
+        }
+        char timestamp[32];
+        time_t now = time(NULL);
+        strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+        fprintf(report->json, "{\"benchmark\": \"%s\", \"revision\": \"%s\", \"timestamp\": \"%s\", \"seed\": %llu, \"results\": [",
+                name, PIM_BENCH_REVISION, timestamp, (unsigned long long)seed);
+    }
+    return 0;
+}
+
+static inline void bench_report_field(bench_report_t* report, const char* key, bool quoted, const char* format, ...) {
+    if (report->num_fields == BENCH_MAX_FIELDS) return;
+    uint32_t field = report->num_fields++;
+    snprintf(report->keys[field], BENCH_MAX_VALUE, "%s", key);
+    va_list args;
+    va_start(args, format);
+    vsnprintf(report->values[field], BENCH_MAX_VALUE, format, args);
+    va_end(args);
+    report->quoted[field] = quoted;
+}
+
+static inline void bench_report_string(bench_report_t* report, const char* key, const char* value) {
+    bench_report_field(report, key, true, "%s", value);
+}
+
+static inline void bench_report_uint(bench_report_t* report, const char* key, uint64_t value) {
+    bench_report_field(report, key, false, "%llu", (unsigned long long)value);
+}
+
+static inline void bench_report_double(bench_report_t* report, const char* key, double value) {
+    // JSON has no representation of inf/nan
+    bench_report_field(report, key, false, "%.6g", isfinite(value) ? value : 0.0);
+}
+
+/**
+ * @brief Write the fields added since the previous row as one row.
+ */
+static inline void bench_report_end_row(bench_report_t* report) {
+    if (report->csv) {
+        if (report->rows == 0) {
+            for (uint32_t f = 0; f < report->num_fields; f++) {
+                fprintf(report->csv, "%s%s", f ? "," : "", report->keys[f]);
+            }
+            fprintf(report->csv, "\n");
+        }
+        for (uint32_t f = 0; f < report->num_fields; f++) {
+            fprintf(report->csv, "%s%s", f ? "," : "", report->values[f]);
+        }
+        fprintf(report->csv, "\n");
+        fflush(report->csv);
+    }
+    if (report->json) {
+        fprintf(report->json, "%s\n  {", report->rows ? "," : "");
+        for (uint32_t f = 0; f < report->num_fields; f++) {
+            const char* quote = report->quoted[f] ? "\"" : "";
+            fprintf(report->json, "%s\"%s\": %s%s%s", f ? ", " : "", report->keys[f], quote, report->values[f], quote);
+        }
+        fprintf(report->json, "}");
+    }
+    report->rows++;
+    report->num_fields = 0;
+}
+
+/**
+ * @brief Finish the JSON document and close the report files.
+ */
+static inline void bench_report_close(bench_report_t* report) {
+    if (report->json) {
+        fprintf(report->json, "\n]}\n");
+        if (report->json != stdout) fclose(report->json);
+    }
+    if (report->csv && report->csv != stdout) fclose(report->csv);
+    report->csv = NULL;
+    report->json = NULL;
+}
+
+#endif // __BENCH_COMMON_H___
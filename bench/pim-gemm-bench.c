@@ -0,0 +1,317 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "bench_common.h"
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+#include "pim_matrix_multiplication_frame.h"
+#include "pim_kernel_registry.h"
+#include "pim_dtype.h"
+#include "pim_stats.h"
+#include "pim_dpu_stats.h"
+
+/**
+ * @file pim-gemm-bench.c
+ * @brief End-to-end GEMM benchmark: sweeps shapes, DPU counts, tasklet counts and element types.
+ * @details For every configuration a frame is created once, then `--warmup` untimed and `--reps` timed iterations
+ *          each load both operands, execute and pull the result. Operands are seeded random matrices, and the
+ *          result of every configuration is checked against a host reference whose run time gives the speedup.
+ *          One row per configuration is written to the CSV and JSON reports.
+ */
+
+typedef struct {
+    dpu_pim_dtype_t matrix1_dtype;
+    dpu_pim_dtype_t matrix2_dtype;
+    dpu_pim_dtype_t result_dtype;
+} bench_dtypes_t;
+
+static int64_t load_element(const uint8_t* data, size_t index, dpu_pim_dtype_t dtype) {
+    switch (dtype) {
+        case DPU_PIM_DTYPE_INT8: return ((const int8_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT8: return ((const uint8_t*)data)[index];
+        case DPU_PIM_DTYPE_INT16: return ((const int16_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT16: return ((const uint16_t*)data)[index];
+        case DPU_PIM_DTYPE_INT32: return ((const int32_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT32: return ((const uint32_t*)data)[index];
+        default: return ((const int64_t*)data)[index];
+    }
+}
+
+// Naive host GEMM; B is row-major K x N. Products wrap like the DPU kernel and are narrowed to the result size.
+static void host_gemm(const uint8_t* a, const uint8_t* b, uint8_t* c, uint32_t m, uint32_t n, uint32_t k, const bench_dtypes_t* dtypes) {
+    uint32_t result_size = pim_dtype_size(dtypes->result_dtype);
+    for (uint32_t i = 0; i < m; i++) {
+        for (uint32_t j = 0; j < n; j++) {
+            uint64_t sum = 0;
+            for (uint32_t p = 0; p < k; p++) {
+                sum += (uint64_t)load_element(a, (size_t)i * k + p, dtypes->matrix1_dtype) *
+                       (uint64_t)load_element(b, (size_t)p * n + j, dtypes->matrix2_dtype);
+            }
+            // Little-endian: the low bytes are the narrowed value
+            memcpy(c + ((size_t)i * n + j) * result_size, &sum, result_size);
+        }
+    }
+}
+
+static int parse_dtypes(char* text, bench_dtypes_t* dtypes) {
+    char* save = NULL;
+    char* names[3];
+    for (int i = 0; i < 3; i++) {
+        names[i] = strtok_r(i == 0 ? text : NULL, ":", &save);
+        if (!names[i]) return -1;
+    }
+    if (pim_dtype_from_name(names[0], &dtypes->matrix1_dtype) != 0 ||
+        pim_dtype_from_name(names[1], &dtypes->matrix2_dtype) != 0 ||
+        pim_dtype_from_name(names[2], &dtypes->result_dtype) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+// Restrict the registry to the kernels built for nr_tasklets tasklets, 0 restores every kernel
+static void select_tasklets(const pim_kernel_descriptor_t* kernels, uint32_t num_kernels, uint32_t nr_tasklets) {
+    pim_kernel_registry_clear();
+    for (uint32_t i = 0; i < num_kernels; i++) {
+        if (nr_tasklets == 0 || kernels[i].nr_tasklets == nr_tasklets) {
+            pim_kernel_registry_register(&kernels[i]);
+        }
+    }
+}
+
+static int run_config(bench_report_t* report, uint32_t m, uint32_t n, uint32_t k, uint32_t num_dpus, uint32_t nr_tasklets,
+                      const bench_dtypes_t* dtypes, uint32_t warmup, uint32_t reps, uint64_t seed) {
+    uint32_t matrix1_size = pim_dtype_size(dtypes->matrix1_dtype);
+    uint32_t matrix2_size = pim_dtype_size(dtypes->matrix2_dtype);
+    uint32_t result_size = pim_dtype_size(dtypes->result_dtype);
+
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(num_dpus, 0, m, k, k, n, m, n,
+                                                                                           dtypes->matrix1_dtype, dtypes->matrix2_dtype, dtypes->result_dtype);
+    if (!frame) {
+        fprintf(stderr, "Skipping %ux%ux%u %s:%s:%s on %u DPUs with %u tasklets: no frame\n", m, n, k,
+                pim_dtype_name(dtypes->matrix1_dtype), pim_dtype_name(dtypes->matrix2_dtype), pim_dtype_name(dtypes->result_dtype),
+                num_dpus, nr_tasklets);
+        return 0;
+    }
+
+    uint8_t* a = (uint8_t*)malloc((size_t)m * k * matrix1_size);
+    uint8_t* b = (uint8_t*)malloc((size_t)k * n * matrix2_size);
+    uint8_t* c = (uint8_t*)malloc((size_t)m * n * result_size);
+    uint8_t* expected = (uint8_t*)malloc((size_t)m * n * result_size);
+    int status = -1;
+    if (!a || !b || !c || !expected) {
+        fprintf(stderr, "Failed to allocate benchmark matrices\n");
+        goto cleanup;
+    }
+    bench_rng_t rng;
+    bench_rng_seed(&rng, seed ^ ((uint64_t)m << 40) ^ ((uint64_t)n << 20) ^ k);
+    bench_fill_random(a, (size_t)m * k * matrix1_size, &rng);
+    bench_fill_random(b, (size_t)k * n * matrix2_size, &rng);
+
+    uint64_t pim_ns_total = 0, pim_ns_min = UINT64_MAX;
+    for (uint32_t rep = 0; rep < warmup + reps; rep++) {
+        if (rep == warmup) {
+            pim_matrix_multiplication_frame_reset_stats(frame);
+        }
+        uint64_t start = pim_stats_now_ns();
+        if (pim_matrix_multiplication_frame_load_first_matrix_strided(frame, a, k, false) != 0 ||
+            pim_matrix_multiplication_frame_load_second_matrix_strided(frame, b, n, false) != 0) {
+            goto cleanup;
+        }
+        if (pim_matrix_multiplication_frame_execute(frame) != 0 ||
+            pim_matrix_multiplication_frame_get_result_into(frame, c, n) != 0) {
+            goto cleanup;
+        }
+        uint64_t elapsed = pim_stats_now_ns() - start;
+        if (rep >= warmup) {
+            pim_ns_total += elapsed;
+            if (elapsed < pim_ns_min) pim_ns_min = elapsed;
+        }
+    }
+
+    uint64_t host_ns_total = 0;
+    for (uint32_t rep = 0; rep < reps; rep++) {
+        uint64_t start = pim_stats_now_ns();
+        host_gemm(a, b, expected, m, n, k, dtypes);
+        host_ns_total += pim_stats_now_ns() - start;
+    }
+    bool correct = memcmp(c, expected, (size_t)m * n * result_size) == 0;
+    if (!correct) {
+        fprintf(stderr, "Result mismatch for %ux%ux%u on %u DPUs\n", m, n, k, num_dpus);
+    }
+
+    pim_stats_t stats;
+    bool have_stats = pim_matrix_multiplication_frame_get_stats(frame, &stats) == 0;
+    if (!have_stats) memset(&stats, 0, sizeof(stats));
+    pim_dpu_stats_t dpu_stats;
+    memset(&dpu_stats, 0, sizeof(dpu_stats));
+    pim_matrix_multiplication_frame_get_dpu_stats(frame, &dpu_stats);
+
+    double pim_ns_mean = (double)pim_ns_total / reps;
+    double host_ns_mean = (double)host_ns_total / reps;
+    double ops = 2.0 * m * n * k;
+    // Bytes that crossed the host-DPU link (payload and padding) over the time spent in the transfers
+    static const pim_stats_phase_t transfer_phases[] = {
+        PIM_STATS_PUSH_MATRIX1, PIM_STATS_PUSH_MATRIX2, PIM_STATS_PUSH_EPILOGUE, PIM_STATS_PUSH_ARGS, PIM_STATS_PULL_RESULT,
+    };
+    uint64_t transfer_bytes = 0, transfer_ns = 0;
+    for (uint32_t i = 0; i < sizeof(transfer_phases) / sizeof(transfer_phases[0]); i++) {
+        const pim_stats_phase_counters_t* counters = &stats.phases[transfer_phases[i]];
+        transfer_bytes += counters->payload_bytes + counters->padding_bytes;
+        transfer_ns += counters->nanoseconds;
+    }
+
+    bench_report_uint(report, "m", m);
+    bench_report_uint(report, "n", n);
+    bench_report_uint(report, "k", k);
+    bench_report_string(report, "matrix1_dtype", pim_dtype_name(dtypes->matrix1_dtype));
+    bench_report_string(report, "matrix2_dtype", pim_dtype_name(dtypes->matrix2_dtype));
+    bench_report_string(report, "result_dtype", pim_dtype_name(dtypes->result_dtype));
+    bench_report_uint(report, "num_dpus", num_dpus);
+    bench_report_string(report, "kernel", frame->kernel.name);
+    bench_report_uint(report, "nr_tasklets", frame->kernel.nr_tasklets);
+    bench_report_uint(report, "num_work_groups", frame->num_work_groups);
+    bench_report_uint(report, "work_group_size", frame->work_group_size);
+    bench_report_uint(report, "reps", reps);
+    bench_report_uint(report, "correct", correct);
+    bench_report_double(report, "pim_ns_mean", pim_ns_mean);
+    bench_report_uint(report, "pim_ns_min", pim_ns_min);
+    bench_report_double(report, "host_ns_mean", host_ns_mean);
+    bench_report_double(report, "gops", ops / pim_ns_mean);
+    bench_report_double(report, "host_gops", ops / host_ns_mean);
+    bench_report_double(report, "speedup", host_ns_mean / pim_ns_mean);
+    bench_report_double(report, "transfer_gbps", transfer_ns ? (double)transfer_bytes / transfer_ns : 0.0);
+    for (uint32_t phase = 0; phase < PIM_STATS_NUM_PHASES; phase++) {
+        char key[BENCH_MAX_VALUE];
+        snprintf(key, sizeof(key), "%s_ns", pim_stats_phase_name((pim_stats_phase_t)phase));
+        bench_report_double(report, key, (double)stats.phases[phase].nanoseconds / reps);
+    }
+    bench_report_uint(report, "dpu_cycles_max", dpu_stats.dpu_cycles_max);
+    bench_report_double(report, "dpu_cycles_mean", dpu_stats.dpu_cycles_mean);
+    bench_report_end_row(report);
+    pim_dpu_stats_free(&dpu_stats);
+    status = correct ? 0 : -1;
+
+cleanup:
+    free(a);
+    free(b);
+    free(c);
+    free(expected);
+    destroy_pim_matrix_multiplication_frame(frame);
+    return status;
+}
+
+static void usage(const char* program) {
+    printf("Usage: %s [options]\n"
+           "  --m LIST         rows of A and C (default 16)\n"
+           "  --n LIST         columns of B and C (default 16)\n"
+           "  --k LIST         inner dimension (default 32,48)\n"
+           "  --dpus LIST      DPU counts (default 1,4,16)\n"
+           "  --tasklets LIST  only use kernels built for these tasklet counts, 0 for any (default 0)\n"
+           "  --dtypes LIST    matrix1:matrix2:result element types (default uint8:uint8:uint16,int8:int8:int32)\n"
+           "  --warmup N       untimed iterations per configuration (default 1)\n"
+           "  --reps N         timed iterations per configuration (default 3)\n"
+           "  --seed N         seed of the random operands (default 1)\n"
+           "  --csv PATH       CSV report, - for stdout (default -)\n"
+           "  --json PATH      JSON report (default none)\n", program);
+}
+
+int main(int argc, char** argv) {
+    uint32_t ms[BENCH_MAX_LIST] = {16}, ns[BENCH_MAX_LIST] = {16}, ks[BENCH_MAX_LIST] = {32, 48};
+    uint32_t dpus[BENCH_MAX_LIST] = {1, 4, 16}, tasklets[BENCH_MAX_LIST] = {0};
+    int num_m = 1, num_n = 1, num_k = 2, num_dpus = 3, num_tasklets = 1;
+    char default_dtypes[] = "uint8:uint8:uint16,int8:int8:int32";
+    char* dtype_list = default_dtypes;
+    uint32_t warmup = 1, reps = 3;
+    uint64_t seed = 1;
+    const char* csv_path = "-";
+    const char* json_path = NULL;
+
+    static const struct option options[] = {
+        {"m", required_argument, NULL, 'm'},
+        {"n", required_argument, NULL, 'n'},
+        {"k", required_argument, NULL, 'k'},
+        {"dpus", required_argument, NULL, 'd'},
+        {"tasklets", required_argument, NULL, 't'},
+        {"dtypes", required_argument, NULL, 'y'},
+        {"warmup", required_argument, NULL, 'w'},
+        {"reps", required_argument, NULL, 'r'},
+        {"seed", required_argument, NULL, 's'},
+        {"csv", required_argument, NULL, 'c'},
+        {"json", required_argument, NULL, 'j'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int option;
+    while ((option = getopt_long(argc, argv, "h", options, NULL)) != -1) {
+        switch (option) {
+            case 'm': num_m = bench_parse_uint_list(optarg, ms); break;
+            case 'n': num_n = bench_parse_uint_list(optarg, ns); break;
+            case 'k': num_k = bench_parse_uint_list(optarg, ks); break;
+            case 'd': num_dpus = bench_parse_uint_list(optarg, dpus); break;
+            case 't': num_tasklets = bench_parse_uint_list(optarg, tasklets); break;
+            case 'y': dtype_list = optarg; break;
+            case 'w': warmup = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'r': reps = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 's': seed = strtoull(optarg, NULL, 0); break;
+            case 'c': csv_path = strcmp(optarg, "none") == 0 ? NULL : optarg; break;
+            case 'j': json_path = optarg; break;
+            case 'h': usage(argv[0]); return 0;
+            default: usage(argv[0]); return 1;
+        }
+    }
+    if (num_m <= 0 || num_n <= 0 || num_k <= 0 || num_dpus <= 0 || num_tasklets <= 0 || reps == 0) {
+        fprintf(stderr, "Invalid sweep lists\n");
+        usage(argv[0]);
+        return 1;
+    }
+    char* dtype_names[BENCH_MAX_LIST];
+    int num_dtypes = bench_split_list(dtype_list, dtype_names);
+    bench_dtypes_t dtypes[BENCH_MAX_LIST];
+    for (int i = 0; i < num_dtypes; i++) {
+        if (parse_dtypes(dtype_names[i], &dtypes[i]) != 0) {
+            fprintf(stderr, "Invalid element types in --dtypes\n");
+            return 1;
+        }
+    }
+
+    // Keep a copy of every kernel so the registry can be narrowed per tasklet count
+    uint32_t num_kernels = pim_kernel_registry_count();
+    pim_kernel_descriptor_t* kernels = (pim_kernel_descriptor_t*)malloc(num_kernels * sizeof(pim_kernel_descriptor_t));
+    if (!kernels) return 1;
+    for (uint32_t i = 0; i < num_kernels; i++) {
+        kernels[i] = *pim_kernel_registry_get(i);
+    }
+
+    bench_report_t report;
+    if (bench_report_open(&report, "pim-gemm-bench", seed, csv_path, json_path) != 0) {
+        free(kernels);
+        return 1;
+    }
+    int failures = 0;
+    for (int t = 0; t < num_tasklets; t++) {
+        select_tasklets(kernels, num_kernels, tasklets[t]);
+        for (int y = 0; y < num_dtypes; y++) {
+            for (int d = 0; d < num_dpus; d++) {
+                for (int im = 0; im < num_m; im++) {
+                    for (int in = 0; in < num_n; in++) {
+                        for (int ik = 0; ik < num_k; ik++) {
+                            if (run_config(&report, ms[im], ns[in], ks[ik], dpus[d], tasklets[t], &dtypes[y], warmup, reps, seed) != 0) {
+                                failures++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    bench_report_close(&report);
+    pim_dpu_pool_destroy();
+    free(kernels);
+    if (failures) {
+        fprintf(stderr, "%d benchmark configurations failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
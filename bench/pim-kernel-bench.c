@@ -0,0 +1,351 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "bench_common.h"
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+#include "pim_matrix_multiplication_frame.h"
+#include "pim_kernel_registry.h"
+#include "pim_dtype.h"
+#include "pim_stats.h"
+#include "pim_dpu_stats.h"
+
+/**
+ * @file pim-kernel-bench.c
+ * @brief DPU GEMM kernel benchmark: compares kernel builds and GEMM variants on the same MRAM data.
+ * @details Every kernel of the registry that matches the filters is benchmarked alone. For each shape the operands are
+ *          loaded into MRAM once, then every GEMM variant (`dpu_pim_gemm_variant_t`) is launched `--warmup` untimed
+ *          and `--reps` timed times without any other host-DPU transfer than the kernel arguments. The DPU cycle
+ *          counters of the timed launches give the cycles per multiply-accumulate of the slowest DPU, along with the
+ *          MRAM and compute cycles summed over its tasklets. Results are checked against a host reference.
+ *          Build a tasklet and tile sweep with `make bench-kernels`, which uses defn/bench_dpu_kernels.yaml.
+ */
+
+static const char* variant_names[DPU_PIM_NUM_GEMM_VARIANTS] = {
+    [DPU_PIM_GEMM_NAIVE] = "naive",
+    [DPU_PIM_GEMM_THREAD_MEMORY_MANAGER] = "thread_memory_manager",
+    [DPU_PIM_GEMM_TILED] = "tiled",
+    [DPU_PIM_GEMM_LUT] = "lut",
+    [DPU_PIM_GEMM_PIPELINED] = "pipelined",
+    [DPU_PIM_GEMM_OUTER] = "outer",
+};
+
+static int64_t load_element(const uint8_t* data, size_t index, dpu_pim_dtype_t dtype) {
+    switch (dtype) {
+        case DPU_PIM_DTYPE_INT8: return ((const int8_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT8: return ((const uint8_t*)data)[index];
+        case DPU_PIM_DTYPE_INT16: return ((const int16_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT16: return ((const uint16_t*)data)[index];
+        case DPU_PIM_DTYPE_INT32: return ((const int32_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT32: return ((const uint32_t*)data)[index];
+        default: return ((const int64_t*)data)[index];
+    }
+}
+
+// Wrap every element into a signed or unsigned integer of value_bits bits, as the element type is signed or not
+static void limit_value_bits(uint8_t* data, size_t count, dpu_pim_dtype_t dtype, uint32_t value_bits) {
+    uint32_t size = pim_dtype_size(dtype);
+    if (value_bits == 0 || value_bits >= 8 * size) return;
+    int64_t mask = ((int64_t)1 << value_bits) - 1;
+    int64_t half = (int64_t)1 << (value_bits - 1);
+    for (size_t i = 0; i < count; i++) {
+        int64_t value = load_element(data, i, dtype) & mask;
+        if (pim_dtype_is_signed(dtype)) value = (value ^ half) - half;
+        // Little-endian: the low bytes are the narrowed value
+        memcpy(data + i * size, &value, size);
+    }
+}
+
+// Naive host GEMM; B is row-major K x N. Products wrap like the DPU kernel and are narrowed to the result size.
+static void host_gemm(const uint8_t* a, const uint8_t* b, uint8_t* c, uint32_t m, uint32_t n, uint32_t k,
+                      const pim_kernel_descriptor_t* kernel) {
+    uint32_t result_size = pim_dtype_size(kernel->result_dtype);
+    for (uint32_t i = 0; i < m; i++) {
+        for (uint32_t j = 0; j < n; j++) {
+            uint64_t sum = 0;
+            for (uint32_t p = 0; p < k; p++) {
+                sum += (uint64_t)load_element(a, (size_t)i * k + p, kernel->matrix1_dtype) *
+                       (uint64_t)load_element(b, (size_t)p * n + j, kernel->matrix2_dtype);
+            }
+            // Little-endian: the low bytes are the narrowed value
+            memcpy(c + ((size_t)i * n + j) * result_size, &sum, result_size);
+        }
+    }
+}
+
+static int parse_variants(char* text, bool* enabled) {
+    char* names[BENCH_MAX_LIST];
+    int count = bench_split_list(text, names);
+    memset(enabled, 0, DPU_PIM_NUM_GEMM_VARIANTS * sizeof(bool));
+    for (int i = 0; i < count; i++) {
+        uint32_t variant = 0;
+        while (variant < DPU_PIM_NUM_GEMM_VARIANTS && strcmp(names[i], variant_names[variant]) != 0) variant++;
+        if (variant == DPU_PIM_NUM_GEMM_VARIANTS) {
+            fprintf(stderr, "Unknown GEMM variant %s\n", names[i]);
+            return -1;
+        }
+        enabled[variant] = true;
+    }
+    return count > 0 ? 0 : -1;
+}
+
+static bool list_contains(const uint32_t* values, int count, uint32_t value) {
+    for (int i = 0; i < count; i++) {
+        if (values[i] == 0 || values[i] == value) return true;
+    }
+    return false;
+}
+
+static bool kernel_matches_dtypes(const pim_kernel_descriptor_t* kernel, char* dtype_list) {
+    if (!dtype_list) return true;
+    char name[3 * 16];
+    snprintf(name, sizeof(name), "%s:%s:%s", pim_dtype_name(kernel->matrix1_dtype), pim_dtype_name(kernel->matrix2_dtype),
+             pim_dtype_name(kernel->result_dtype));
+    char copy[512];
+    snprintf(copy, sizeof(copy), "%s", dtype_list);
+    char* names[BENCH_MAX_LIST];
+    int count = bench_split_list(copy, names);
+    for (int i = 0; i < count; i++) {
+        if (strcmp(names[i], name) == 0) return true;
+    }
+    return false;
+}
+
+// Benchmark every enabled variant of one kernel on one shape; returns the number of incorrect variants
+static int run_kernel(bench_report_t* report, const pim_kernel_descriptor_t* kernel, uint32_t m, uint32_t n, uint32_t k,
+                      uint32_t num_dpus, const bool* variants, uint32_t warmup, uint32_t reps, uint64_t seed,
+                      uint32_t value_bits) {
+    uint32_t matrix1_size = pim_dtype_size(kernel->matrix1_dtype);
+    uint32_t matrix2_size = pim_dtype_size(kernel->matrix2_dtype);
+    uint32_t result_size = pim_dtype_size(kernel->result_dtype);
+
+    // The frame can only select this kernel
+    pim_kernel_registry_clear();
+    pim_kernel_registry_register(kernel);
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(num_dpus, 0, m, k, k, n, m, n,
+                                                                                           kernel->matrix1_dtype, kernel->matrix2_dtype, kernel->result_dtype);
+    if (!frame) {
+        fprintf(stderr, "Skipping %s on %ux%ux%u: no frame\n", kernel->name, m, n, k);
+        return 0;
+    }
+
+    uint8_t* a = (uint8_t*)malloc((size_t)m * k * matrix1_size);
+    uint8_t* b = (uint8_t*)malloc((size_t)k * n * matrix2_size);
+    uint8_t* c = (uint8_t*)malloc((size_t)m * n * result_size);
+    uint8_t* expected = (uint8_t*)malloc((size_t)m * n * result_size);
+    int failures = 0;
+    if (!a || !b || !c || !expected) {
+        fprintf(stderr, "Failed to allocate benchmark matrices\n");
+        failures = 1;
+        goto cleanup;
+    }
+    bench_rng_t rng;
+    bench_rng_seed(&rng, seed ^ ((uint64_t)m << 40) ^ ((uint64_t)n << 20) ^ k);
+    bench_fill_random(a, (size_t)m * k * matrix1_size, &rng);
+    bench_fill_random(b, (size_t)k * n * matrix2_size, &rng);
+    limit_value_bits(a, (size_t)m * k, kernel->matrix1_dtype, value_bits);
+    limit_value_bits(b, (size_t)k * n, kernel->matrix2_dtype, value_bits);
+    host_gemm(a, b, expected, m, n, k, kernel);
+    if (pim_matrix_multiplication_frame_load_first_matrix_strided(frame, a, k, false) != 0 ||
+        pim_matrix_multiplication_frame_load_second_matrix_strided(frame, b, n, false) != 0) {
+        failures = 1;
+        goto cleanup;
+    }
+
+    // Multiply-accumulates of one DPU, padding of the slices included
+    uint64_t slice_rows = (m + frame->work_group_size - 1) / frame->work_group_size;
+    uint64_t slice_cols = (n + frame->num_work_groups - 1) / frame->num_work_groups;
+    uint64_t macs_per_dpu = slice_rows * slice_cols * k;
+
+    for (uint32_t variant = 0; variant < DPU_PIM_NUM_GEMM_VARIANTS; variant++) {
+        if (!variants[variant]) continue;
+        // Unsupported variants, e.g. operands outside the lookup-table range, would silently run the tiled GEMM
+        if (!pim_matrix_multiplication_frame_supports_gemm_variant(frame, (dpu_pim_gemm_variant_t)variant)) continue;
+        pim_matrix_multiplication_frame_set_gemm_variant(frame, (dpu_pim_gemm_variant_t)variant);
+        uint64_t execute_ns = 0, dpu_cycles_max = 0, tasklet_cycles_max = 0;
+        double dpu_cycles_mean = 0;
+        uint64_t mram_read_cycles = 0, compute_cycles = 0, mram_write_cycles = 0;
+        for (uint32_t rep = 0; rep < warmup + reps; rep++) {
+            uint64_t start = pim_stats_now_ns();
+            // A failed launch leaves no result, so it is reported as a mismatch below
+            if (pim_matrix_multiplication_frame_execute(frame) != 0) break;
+            uint64_t elapsed = pim_stats_now_ns() - start;
+            if (rep < warmup) continue;
+            pim_dpu_stats_t dpu_stats;
+            memset(&dpu_stats, 0, sizeof(dpu_stats));
+            pim_matrix_multiplication_frame_get_dpu_stats(frame, &dpu_stats);
+            execute_ns += elapsed;
+            dpu_cycles_max += dpu_stats.dpu_cycles_max;
+            dpu_cycles_mean += dpu_stats.dpu_cycles_mean;
+            tasklet_cycles_max += dpu_stats.tasklet_cycles_max;
+            // Summed over the tasklets of all DPUs, reported per DPU
+            mram_read_cycles += dpu_stats.mram_read_cycles / frame->num_dpus;
+            compute_cycles += dpu_stats.compute_cycles / frame->num_dpus;
+            mram_write_cycles += dpu_stats.mram_write_cycles / frame->num_dpus;
+            pim_dpu_stats_free(&dpu_stats);
+        }
+        memset(c, 0, (size_t)m * n * result_size);
+        bool correct = pim_matrix_multiplication_frame_get_result_into(frame, c, n) == 0 &&
+                       memcmp(c, expected, (size_t)m * n * result_size) == 0;
+        if (!correct) {
+            fprintf(stderr, "Result mismatch for %s (%s) on %ux%ux%u\n", kernel->name, variant_names[variant], m, n, k);
+            failures++;
+        }
+
+        bench_report_string(report, "kernel", kernel->name);
+        bench_report_string(report, "variant", variant_names[variant]);
+        bench_report_string(report, "matrix1_dtype", pim_dtype_name(kernel->matrix1_dtype));
+        bench_report_string(report, "matrix2_dtype", pim_dtype_name(kernel->matrix2_dtype));
+        bench_report_string(report, "result_dtype", pim_dtype_name(kernel->result_dtype));
+        bench_report_uint(report, "nr_tasklets", kernel->nr_tasklets);
+        bench_report_uint(report, "tile_rows", kernel->tile_rows);
+        bench_report_uint(report, "tile_cols", kernel->tile_cols);
+        bench_report_uint(report, "m", m);
+        bench_report_uint(report, "n", n);
+        bench_report_uint(report, "k", k);
+        bench_report_uint(report, "num_dpus", frame->num_dpus);
+        bench_report_uint(report, "value_bits", value_bits);
+        bench_report_uint(report, "reps", reps);
+        bench_report_uint(report, "correct", correct);
+        bench_report_double(report, "execute_ns_mean", (double)execute_ns / reps);
+        bench_report_double(report, "dpu_cycles_max", (double)dpu_cycles_max / reps);
+        bench_report_double(report, "dpu_cycles_mean", dpu_cycles_mean / reps);
+        bench_report_double(report, "tasklet_cycles_max", (double)tasklet_cycles_max / reps);
+        bench_report_double(report, "cycles_per_mac", (double)dpu_cycles_max / reps / macs_per_dpu);
+        bench_report_double(report, "mram_read_cycles", (double)mram_read_cycles / reps);
+        bench_report_double(report, "compute_cycles", (double)compute_cycles / reps);
+        bench_report_double(report, "mram_write_cycles", (double)mram_write_cycles / reps);
+        bench_report_end_row(report);
+    }
+
+cleanup:
+    free(a);
+    free(b);
+    free(c);
+    free(expected);
+    destroy_pim_matrix_multiplication_frame(frame);
+    return failures;
+}
+
+static void usage(const char* program) {
+    printf("Usage: %s [options]\n"
+           "  --manifest PATH  kernel manifest to benchmark (default: the registry's manifest)\n"
+           "  --m LIST         rows of A and C (default 16)\n"
+           "  --n LIST         columns of B and C (default 16)\n"
+           "  --k LIST         inner dimension (default 64)\n"
+           "  --dpus N         DPUs per launch (default 1)\n"
+           "  --tasklets LIST  only kernels built for these tasklet counts, 0 for any (default 0)\n"
+           "  --dtypes LIST    only kernels for these matrix1:matrix2:result element types (default any)\n"
+           "  --variants LIST  GEMM variants: naive,thread_memory_manager,tiled,lut,pipelined,outer (default all; lut only\n"
+           "                   runs on operands within its value range, see --value-bits, and outer on slices no wider\n"
+           "                   than the bands of the kernel)\n"
+           "  --value-bits N   limit the random operands to N-bit signed or unsigned values, 0 for full range (default 0)\n"
+           "  --warmup N       untimed launches per variant (default 1)\n"
+           "  --reps N         timed launches per variant (default 3)\n"
+           "  --seed N         seed of the random operands (default 1)\n"
+           "  --csv PATH       CSV report, - for stdout (default -)\n"
+           "  --json PATH      JSON report (default none)\n", program);
+}
+
+int main(int argc, char** argv) {
+    uint32_t ms[BENCH_MAX_LIST] = {16}, ns[BENCH_MAX_LIST] = {16}, ks[BENCH_MAX_LIST] = {64};
+    uint32_t tasklets[BENCH_MAX_LIST] = {0};
+    int num_m = 1, num_n = 1, num_k = 1, num_tasklets = 1;
+    uint32_t num_dpus = 1;
+    const char* manifest = NULL;
+    char* dtype_list = NULL;
+    bool variants[DPU_PIM_NUM_GEMM_VARIANTS];
+    for (uint32_t i = 0; i < DPU_PIM_NUM_GEMM_VARIANTS; i++) variants[i] = true;
+    uint32_t warmup = 1, reps = 3;
+    uint64_t seed = 1;
+    uint32_t value_bits = 0;
+    const char* csv_path = "-";
+    const char* json_path = NULL;
+
+    static const struct option options[] = {
+        {"manifest", required_argument, NULL, 'f'},
+        {"m", required_argument, NULL, 'm'},
+        {"n", required_argument, NULL, 'n'},
+        {"k", required_argument, NULL, 'k'},
+        {"dpus", required_argument, NULL, 'd'},
+        {"tasklets", required_argument, NULL, 't'},
+        {"dtypes", required_argument, NULL, 'y'},
+        {"variants", required_argument, NULL, 'v'},
+        {"warmup", required_argument, NULL, 'w'},
+        {"reps", required_argument, NULL, 'r'},
+        {"seed", required_argument, NULL, 's'},
+        {"value-bits", required_argument, NULL, 'b'},
+        {"csv", required_argument, NULL, 'c'},
+        {"json", required_argument, NULL, 'j'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int option;
+    while ((option = getopt_long(argc, argv, "h", options, NULL)) != -1) {
+        switch (option) {
+            case 'f': manifest = optarg; break;
+            case 'm': num_m = bench_parse_uint_list(optarg, ms); break;
+            case 'n': num_n = bench_parse_uint_list(optarg, ns); break;
+            case 'k': num_k = bench_parse_uint_list(optarg, ks); break;
+            case 'd': num_dpus = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 't': num_tasklets = bench_parse_uint_list(optarg, tasklets); break;
+            case 'y': dtype_list = optarg; break;
+            case 'v':
+                if (parse_variants(optarg, variants) != 0) return 1;
+                break;
+            case 'w': warmup = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'r': reps = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 's': seed = strtoull(optarg, NULL, 0); break;
+            case 'b': value_bits = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'c': csv_path = strcmp(optarg, "none") == 0 ? NULL : optarg; break;
+            case 'j': json_path = optarg; break;
+            case 'h': usage(argv[0]); return 0;
+            default: usage(argv[0]); return 1;
+        }
+    }
+    if (num_m <= 0 || num_n <= 0 || num_k <= 0 || num_tasklets <= 0 || num_dpus == 0 || reps == 0) {
+        fprintf(stderr, "Invalid sweep lists\n");
+        usage(argv[0]);
+        return 1;
+    }
+    if (manifest && pim_kernel_registry_load(manifest) < 0) {
+        return 1;
+    }
+
+    // Keep a copy of every kernel, as the registry is narrowed to one kernel per measurement
+    uint32_t num_kernels = pim_kernel_registry_count();
+    pim_kernel_descriptor_t* kernels = (pim_kernel_descriptor_t*)malloc((num_kernels ? num_kernels : 1) * sizeof(pim_kernel_descriptor_t));
+    if (!kernels) return 1;
+    for (uint32_t i = 0; i < num_kernels; i++) {
+        kernels[i] = *pim_kernel_registry_get(i);
+    }
+
+    bench_report_t report;
+    if (bench_report_open(&report, "pim-kernel-bench", seed, csv_path, json_path) != 0) {
+        free(kernels);
+        return 1;
+    }
+    int failures = 0;
+    for (uint32_t i = 0; i < num_kernels; i++) {
+        if (!list_contains(tasklets, num_tasklets, kernels[i].nr_tasklets) || !kernel_matches_dtypes(&kernels[i], dtype_list)) {
+            continue;
+        }
+        for (int im = 0; im < num_m; im++) {
+            for (int in = 0; in < num_n; in++) {
+                for (int ik = 0; ik < num_k; ik++) {
+                    failures += run_kernel(&report, &kernels[i], ms[im], ns[in], ks[ik], num_dpus, variants, warmup, reps, seed, value_bits);
+                }
+            }
+        }
+    }
+    bench_report_close(&report);
+    pim_dpu_pool_destroy();
+    free(kernels);
+    if (failures) {
+        fprintf(stderr, "%d kernel measurements failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
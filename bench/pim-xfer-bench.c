@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include "bench_common.h"
+
+#include <dpu.h>
+
+#include "pim_stats.h"
+#include "pim_xfer_model.h"
+
+/**
+ * @file pim-xfer-bench.c
+ * @brief Host-DPU transfer microbenchmark.
+ * @details Measures MRAM transfers across payload sizes per DPU and DPU set sizes. Every measurement covers three
+ *          transfer kinds: per-DPU buffers pushed with dpu_prepare_xfer/dpu_push_xfer, per-DPU buffers pulled the
+ *          same way, and one buffer sent with dpu_broadcast_to. Each kind runs both synchronously and as
+ *          DPU_XFER_ASYNC followed by dpu_sync. Host buffers come from malloc and, when the system has them
+ *          reserved, from 2 MiB hugepages. Sets spanning several ranks are also measured one rank at a time.
+ *          With `--calibration`, the synchronous malloc measurements of the whole set are written as a calibration
+ *          file for the transfer cost model (pim_xfer_model.h).
+ */
+
+#ifndef DPU_MATRIX_MULTIPLICATION_BIN
+#define DPU_MATRIX_MULTIPLICATION_BIN "/workspace/bin/matrix_multiply_dpu"
+#endif
+
+#define HUGEPAGE_SIZE (2u << 20)
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t mapped_size;   ///< Non-zero when the buffer is a hugepage mapping
+} host_buffer_t;
+
+static int host_buffer_alloc(host_buffer_t* buffer, size_t size, bool hugepages) {
+    memset(buffer, 0, sizeof(*buffer));
+    buffer->size = size;
+    if (hugepages) {
+        size_t mapped_size = (size + HUGEPAGE_SIZE - 1) & ~(size_t)(HUGEPAGE_SIZE - 1);
+        void* data = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (data == MAP_FAILED) return -1;
+        buffer->data = (uint8_t*)data;
+        buffer->mapped_size = mapped_size;
+    } else {
+        buffer->data = (uint8_t*)malloc(size);
+        if (!buffer->data) return -1;
+    }
+    // Touch every page so page faults are not measured
+    memset(buffer->data, 0x5a, size);
+    return 0;
+}
+
+static void host_buffer_free(host_buffer_t* buffer) {
+    if (buffer->mapped_size) {
+        munmap(buffer->data, buffer->mapped_size);
+    } else {
+        free(buffer->data);
+    }
+    buffer->data = NULL;
+}
+
+static void transfer(struct dpu_set_t set, pim_xfer_direction_t direction, uint8_t* data, uint32_t bytes_per_dpu, bool async) {
+    dpu_xfer_flags_t flags = async ? DPU_XFER_ASYNC : DPU_XFER_DEFAULT;
+    if (direction == PIM_XFER_BROADCAST) {
+        DPU_ASSERT(dpu_broadcast_to(set, DPU_MRAM_HEAP_POINTER_NAME, 0, data, bytes_per_dpu, flags));
+    } else {
+        uint32_t i;
+        struct dpu_set_t dpu;
+        DPU_FOREACH(set, dpu, i) {
+            DPU_ASSERT(dpu_prepare_xfer(dpu, data + (size_t)i * bytes_per_dpu));
+        }
+        DPU_ASSERT(dpu_push_xfer(set, direction == PIM_XFER_TO_DPU ? DPU_XFER_TO_DPU : DPU_XFER_FROM_DPU,
+                                 DPU_MRAM_HEAP_POINTER_NAME, 0, bytes_per_dpu, flags));
+    }
+    if (async) {
+        DPU_ASSERT(dpu_sync(set));
+    }
+}
+
+// Mean nanoseconds of one transfer over `reps` timed repetitions
+static double time_transfer(struct dpu_set_t set, pim_xfer_direction_t direction, uint8_t* data, uint32_t bytes_per_dpu,
+                            bool async, uint32_t warmup, uint32_t reps) {
+    for (uint32_t rep = 0; rep < warmup; rep++) {
+        transfer(set, direction, data, bytes_per_dpu, async);
+    }
+    uint64_t start = pim_stats_now_ns();
+    for (uint32_t rep = 0; rep < reps; rep++) {
+        transfer(set, direction, data, bytes_per_dpu, async);
+    }
+    return (double)(pim_stats_now_ns() - start) / reps;
+}
+
+static void report_row(bench_report_t* report, pim_xfer_direction_t direction, bool async, bool hugepages, uint32_t num_dpus,
+                       uint32_t num_ranks, const char* rank, uint32_t rank_dpus, uint32_t bytes_per_dpu, uint32_t reps, double nanoseconds) {
+    // A broadcast moves one copy of the buffer from the host, but writes it to every DPU
+    uint64_t bytes = (uint64_t)bytes_per_dpu * rank_dpus;
+    bench_report_string(report, "direction", pim_xfer_direction_name(direction));
+    bench_report_string(report, "sync", async ? "async" : "sync");
+    bench_report_uint(report, "hugepages", hugepages);
+    bench_report_uint(report, "num_dpus", num_dpus);
+    bench_report_uint(report, "num_ranks", num_ranks);
+    bench_report_string(report, "rank", rank);
+    bench_report_uint(report, "rank_dpus", rank_dpus);
+    bench_report_uint(report, "bytes_per_dpu", bytes_per_dpu);
+    bench_report_uint(report, "reps", reps);
+    bench_report_double(report, "ns", nanoseconds);
+    bench_report_double(report, "gbps", (double)bytes / nanoseconds);
+    bench_report_end_row(report);
+}
+
+static void usage(const char* program) {
+    printf("Usage: %s [options]\n"
+           "  --sizes LIST        bytes per DPU, multiples of 8 (default 512,4096,32768,262144)\n"
+           "  --dpus LIST         DPU set sizes (default 1,8,64)\n"
+           "  --warmup N          untimed transfers per measurement (default 2)\n"
+           "  --reps N            timed transfers per measurement (default 10)\n"
+           "  --csv PATH          CSV report, - for stdout (default -)\n"
+           "  --json PATH         JSON report (default none)\n"
+           "  --calibration PATH  write the transfer cost model calibration file\n", program);
+}
+
+int main(int argc, char** argv) {
+    uint32_t sizes[BENCH_MAX_LIST] = {512, 4096, 32768, 262144};
+    uint32_t dpu_counts[BENCH_MAX_LIST] = {1, 8, 64};
+    int num_sizes = 4, num_dpu_counts = 3;
+    uint32_t warmup = 2, reps = 10;
+    const char* csv_path = "-";
+    const char* json_path = NULL;
+    const char* calibration_path = NULL;
+
+    static const struct option options[] = {
+        {"sizes", required_argument, NULL, 'b'},
+        {"dpus", required_argument, NULL, 'd'},
+        {"warmup", required_argument, NULL, 'w'},
+        {"reps", required_argument, NULL, 'r'},
+        {"csv", required_argument, NULL, 'c'},
+        {"json", required_argument, NULL, 'j'},
+        {"calibration", required_argument, NULL, 'o'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int option;
+    while ((option = getopt_long(argc, argv, "h", options, NULL)) != -1) {
+        switch (option) {
+            case 'b': num_sizes = bench_parse_uint_list(optarg, sizes); break;
+            case 'd': num_dpu_counts = bench_parse_uint_list(optarg, dpu_counts); break;
+            case 'w': warmup = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'r': reps = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'c': csv_path = strcmp(optarg, "none") == 0 ? NULL : optarg; break;
+            case 'j': json_path = optarg; break;
+            case 'o': calibration_path = optarg; break;
+            case 'h': usage(argv[0]); return 0;
+            default: usage(argv[0]); return 1;
+        }
+    }
+    if (num_sizes <= 0 || num_dpu_counts <= 0 || reps == 0) {
+        fprintf(stderr, "Invalid sweep lists\n");
+        usage(argv[0]);
+        return 1;
+    }
+    for (int s = 0; s < num_sizes; s++) {
+        if (sizes[s] == 0 || sizes[s] % 8 != 0) {
+            fprintf(stderr, "Transfer size %u is not a positive multiple of 8\n", sizes[s]);
+            return 1;
+        }
+    }
+
+    FILE* calibration = NULL;
+    if (calibration_path) {
+        calibration = fopen(calibration_path, "w");
+        if (!calibration) {
+            fprintf(stderr, "Failed to open %s\n", calibration_path);
+            return 1;
+        }
+        fprintf(calibration, "# Transfer calibration written by pim-xfer-bench, read by pim_xfer_model_load\n");
+        fprintf(calibration, "# direction num_dpus bytes_per_dpu nanoseconds\n");
+    }
+    bench_report_t report;
+    if (bench_report_open(&report, "pim-xfer-bench", 0, csv_path, json_path) != 0) {
+        if (calibration) fclose(calibration);
+        return 1;
+    }
+
+    bool hugepages_available = true;
+    for (int d = 0; d < num_dpu_counts; d++) {
+        uint32_t num_dpus = dpu_counts[d];
+        struct dpu_set_t set;
+        if (dpu_alloc(num_dpus, NULL, &set) != DPU_OK) {
+            fprintf(stderr, "Skipping %u DPUs: allocation failed\n", num_dpus);
+            continue;
+        }
+        DPU_ASSERT(dpu_load(set, DPU_MATRIX_MULTIPLICATION_BIN, NULL));
+        uint32_t num_ranks;
+        DPU_ASSERT(dpu_get_nr_ranks(set, &num_ranks));
+
+        for (int s = 0; s < num_sizes; s++) {
+            uint32_t bytes_per_dpu = sizes[s];
+            for (int huge = 0; huge < 2; huge++) {
+                host_buffer_t buffer;
+                if (host_buffer_alloc(&buffer, (size_t)bytes_per_dpu * num_dpus, huge) != 0) {
+                    if (huge && hugepages_available) {
+                        fprintf(stderr, "Hugepages unavailable, measuring malloc buffers only\n");
+                    }
+                    hugepages_available = hugepages_available && !huge;
+                    continue;
+                }
+                for (uint32_t direction = 0; direction < PIM_XFER_NUM_DIRECTIONS; direction++) {
+                    for (int async = 0; async < 2; async++) {
+                        double nanoseconds = time_transfer(set, (pim_xfer_direction_t)direction, buffer.data, bytes_per_dpu, async, warmup, reps);
+                        report_row(&report, (pim_xfer_direction_t)direction, async, huge, num_dpus, num_ranks, "all", num_dpus,
+                                   bytes_per_dpu, reps, nanoseconds);
+                        if (calibration && !huge && !async) {
+                            fprintf(calibration, "%s %u %u %.1f\n", pim_xfer_direction_name((pim_xfer_direction_t)direction),
+                                    num_dpus, bytes_per_dpu, nanoseconds);
+                        }
+                        if (num_ranks < 2) continue;
+                        uint32_t r;
+                        struct dpu_set_t rank;
+                        DPU_RANK_FOREACH(set, rank, r) {
+                            uint32_t rank_dpus;
+                            DPU_ASSERT(dpu_get_nr_dpus(rank, &rank_dpus));
+                            char rank_name[16];
+                            snprintf(rank_name, sizeof(rank_name), "%u", r);
+                            nanoseconds = time_transfer(rank, (pim_xfer_direction_t)direction, buffer.data, bytes_per_dpu, async, warmup, reps);
+                            report_row(&report, (pim_xfer_direction_t)direction, async, huge, num_dpus, num_ranks, rank_name, rank_dpus,
+                                       bytes_per_dpu, reps, nanoseconds);
+                        }
+                    }
+                }
+                host_buffer_free(&buffer);
+            }
+        }
+        DPU_ASSERT(dpu_free(set));
+    }
+
+    bench_report_close(&report);
+    if (calibration) {
+        fclose(calibration);
+        printf("Transfer calibration written to %s\n", calibration_path);
+    }
+    return 0;
+}
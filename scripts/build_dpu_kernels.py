@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+DPU kernel family builder.
+Compiles every variant listed in defn/dpu_kernels.yaml (or the file given with
+--kernels) and writes the manifest read by the host kernel registry
+(src/pim_kernel_registry.c).
+"""
+
+import argparse
+import itertools
+import os
+import shlex
+import subprocess
+import sys
+
+import yaml
+
+ROOT = os.environ.get('PIM_MATMUL_BENCHMARKS_ROOT', os.getcwd())
+KERNELS_YAML = os.path.join(ROOT, 'defn', 'dpu_kernels.yaml')
+PARAMS_YAML = os.path.join(ROOT, 'defn', 'params.yaml')
+KERNEL_SOURCE = os.path.join(ROOT, 'src', 'dpu', 'pim_dpu_matrix_multiply.c')
+
+# Element type names (as used by pim_dtype_name) -> (C type, dpu_pim_dtype_t enumerator)
+DTYPES = {
+    'int8': ('int8_t', 'DPU_PIM_DTYPE_INT8'),
+    'uint8': ('uint8_t', 'DPU_PIM_DTYPE_UINT8'),
+    'int16': ('int16_t', 'DPU_PIM_DTYPE_INT16'),
+    'uint16': ('uint16_t', 'DPU_PIM_DTYPE_UINT16'),
+    'int32': ('int32_t', 'DPU_PIM_DTYPE_INT32'),
+    'uint32': ('uint32_t', 'DPU_PIM_DTYPE_UINT32'),
+    'int64': ('int64_t', 'DPU_PIM_DTYPE_INT64'),
+}
+
+# Element type parameters set per variant: field -> (type macro, dtype macro)
+DTYPE_PARAMS = {
+    'matrix1_dtype': ('PIM_DPU_MATRIX1_TYPE', 'PIM_DPU_MATRIX1_DTYPE'),
+    'matrix2_dtype': ('PIM_DPU_MATRIX2_TYPE', 'PIM_DPU_MATRIX2_DTYPE'),
+    'result_dtype': ('PIM_DPU_RESULT_TYPE', 'PIM_DPU_RESULT_DTYPE'),
+}
+
+# Multiplications of the tiled GEMM micro-kernel: field value -> PIM_DPU_MULTIPLY value
+MULTIPLY = {
+    'c': 'PIM_DPU_MULTIPLY_C',
+    'builtin': 'PIM_DPU_MULTIPLY_BUILTIN',
+    'packed_builtin': 'PIM_DPU_MULTIPLY_PACKED_BUILTIN',
+}
+
+# Parameters set per variant; they override the global runtime parameters
+VARIANT_PARAMS = {
+    'nr_tasklets': 'NR_TASKLETS',
+    'accumulator_type': 'PIM_DPU_ACCUMULATOR_TYPE',
+    'tile_rows': 'PIM_DPU_TILE_ROWS',
+    'tile_cols': 'PIM_DPU_TILE_COLS',
+    'micro_rows': 'PIM_DPU_MICRO_ROWS',
+    'micro_cols': 'PIM_DPU_MICRO_COLS',
+    'multiply': 'PIM_DPU_MULTIPLY',
+    'fetch_tasklets': 'PIM_DPU_PIPELINE_FETCH_TASKLETS',
+}
+
+# Parameters that may list several values; a variant is built for every combination
+SWEEP_PARAMS = {
+    'nr_tasklets': 't',
+    'tile_rows': 'r',
+    'tile_cols': 'c',
+    'micro_rows': 'mr',
+    'micro_cols': 'mc',
+    'multiply': 'mul_',
+    'fetch_tasklets': 'f',
+}
+
+def expand_sweeps(kernel):
+    """Expand the list-valued sweep parameters of a variant into one variant per combination.
+
+    Every expanded name gets a suffix per swept parameter, e.g. `_t16_r8_c4`.
+    """
+    swept = [field for field in SWEEP_PARAMS if isinstance(kernel.get(field), list)]
+    if not swept:
+        return [kernel]
+    variants = []
+    for values in itertools.product(*(kernel[field] for field in swept)):
+        variant = dict(kernel)
+        variant.update(zip(swept, values))
+        variant['name'] = kernel['name'] + ''.join(f'_{SWEEP_PARAMS[f]}{v}' for f, v in zip(swept, values))
+        variants.append(variant)
+    return variants
+
+def load_runtime_params():
+    """Load global runtime parameters as a name -> value dict."""
+    with open(PARAMS_YAML) as f:
+        params = yaml.safe_load(f)
+    result = {}
+    for item in params.get('runtime_params', []):
+        for key, value in item.items():
+            result[key] = os.path.expandvars(str(value)).replace('\\"', '"')
+    return result
+
+def accumulator_type(kernel):
+    """Default accumulator: 64 bits for 64-bit results, unsigned 32 bits for unsigned inputs, signed 32 bits otherwise."""
+    if kernel['result_dtype'] == 'int64':
+        return 'int64_t'
+    if kernel['matrix1_dtype'].startswith('u') and kernel['matrix2_dtype'].startswith('u'):
+        return 'uint32_t'
+    return 'int32_t'
+
+def variant_flags(kernel, runtime_params):
+    """Build the -D flags for one kernel variant."""
+    defines = dict(runtime_params)
+    for field, (type_macro, dtype_macro) in DTYPE_PARAMS.items():
+        c_type, dtype = DTYPES[kernel[field]]
+        defines[type_macro] = c_type
+        defines[dtype_macro] = dtype
+    defines['PIM_DPU_ACCUMULATOR_TYPE'] = accumulator_type(kernel)
+    for field, macro in VARIANT_PARAMS.items():
+        if field in kernel:
+            defines[macro] = MULTIPLY[kernel[field]] if field == 'multiply' else str(kernel[field])
+    return [f'-D{k}={v}' for k, v in defines.items()]
+
+def manifest_line(kernel, binary):
+    """Format one manifest entry (see pim_kernel_registry.h for the format)."""
+    return ' '.join(str(x) for x in [
+        kernel['name'],
+        binary,
+        kernel['matrix1_dtype'],
+        kernel['matrix2_dtype'],
+        kernel['result_dtype'],
+        kernel['nr_tasklets'],
+        kernel['tile_rows'],
+        kernel['tile_cols'],
+        kernel.get('micro_rows', 2),
+        kernel.get('micro_cols', 2),
+        kernel.get('multiply', 'c'),
+    ])
+
+def main():
+    parser = argparse.ArgumentParser(description='Build the DPU kernel family and its manifest.')
+    parser.add_argument('--compiler', default='dpu-upmem-dpurte-clang', help='DPU compiler')
+    parser.add_argument('--cflags', default='-O2 -g', help='Additional compiler flags')
+    parser.add_argument('--bin-dir', default=os.path.join(ROOT, 'bin'), help='Output directory')
+    parser.add_argument('--kernels', default=KERNELS_YAML, help='Kernel variant list')
+    args = parser.parse_args()
+
+    with open(args.kernels) as f:
+        kernels = [variant for kernel in yaml.safe_load(f)['kernels'] for variant in expand_sweeps(kernel)]
+
+    runtime_params = load_runtime_params()
+    os.makedirs(args.bin_dir, exist_ok=True)
+
+    manifest = ['# name binary matrix1_dtype matrix2_dtype result_dtype nr_tasklets tile_rows tile_cols micro_rows micro_cols multiply']
+    for kernel in kernels:
+        for field in DTYPE_PARAMS:
+            if kernel.get(field) not in DTYPES:
+                print(f"Unknown {field} '{kernel.get(field)}' for DPU kernel {kernel['name']}", file=sys.stderr)
+                return 1
+        if kernel.get('multiply', 'c') not in MULTIPLY:
+            print(f"Unknown multiply '{kernel['multiply']}' for DPU kernel {kernel['name']}", file=sys.stderr)
+            return 1
+        binary = os.path.join(args.bin_dir, kernel['name'])
+        cmd = [args.compiler] + shlex.split(args.cflags) + variant_flags(kernel, runtime_params)
+        cmd += ['-I', os.path.join(ROOT, 'src'), '-o', binary, KERNEL_SOURCE]
+        print(f"Building DPU kernel {kernel['name']}")
+        if subprocess.call(cmd) != 0:
+            print(f"Failed to build DPU kernel {kernel['name']}", file=sys.stderr)
+            return 1
+        manifest.append(manifest_line(kernel, binary))
+
+    manifest_path = os.path.join(args.bin_dir, 'dpu_kernels.manifest')
+    with open(manifest_path, 'w') as f:
+        f.write('\n'.join(manifest) + '\n')
+    print(f"Wrote {len(kernels)} kernels to {manifest_path}")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""
+Benchmark regression checker.
+Compares the JSON reports written by the benchmarks (bench/*.c) against stored
+baselines with the per-metric tolerances of defn/bench_tolerances.yaml and
+exits non-zero when a throughput or latency metric regressed.
+"""
+
+import argparse
+import glob
+import json
+import os
+import shutil
+import sys
+
+import yaml
+
+ROOT = os.environ.get('PIM_MATMUL_BENCHMARKS_ROOT', os.getcwd())
+REPORT_DIR = os.path.join(ROOT, 'scratch', 'bench')
+BASELINE_DIR = os.path.join(ROOT, 'bench', 'baselines')
+TOLERANCES_YAML = os.path.join(ROOT, 'defn', 'bench_tolerances.yaml')
+
+def load_report(path):
+    """Load a benchmark JSON report."""
+    with open(path) as f:
+        return json.load(f)
+
+def index_rows(rows, key_fields):
+    """Map every row to its key; repeated keys are numbered in order of appearance."""
+    indexed = {}
+    for row in rows:
+        key = tuple(str(row.get(field)) for field in key_fields)
+        occurrence = 0
+        while key + (occurrence,) in indexed:
+            occurrence += 1
+        indexed[key + (occurrence,)] = row
+    return indexed
+
+def format_key(key_fields, key):
+    """Format a row key as field=value pairs."""
+    text = ' '.join(f'{field}={value}' for field, value in zip(key_fields, key))
+    return text + (f' #{key[-1]}' if key[-1] else '')
+
+def relative_change(baseline, current, better):
+    """Relative change in the worse direction; positive values are regressions."""
+    if baseline == 0:
+        return 0.0 if current == baseline else float('inf')
+    change = (current - baseline) / abs(baseline)
+    return -change if better == 'higher' else change
+
+def compare_report(name, current, baseline, config, overrides):
+    """Compare one report with its baseline; returns (regressions, improvements, missing row count)."""
+    key_fields = config['key']
+    current_rows = index_rows(current.get('results', []), key_fields)
+    baseline_rows = index_rows(baseline.get('results', []), key_fields)
+    regressions, improvements = [], []
+    missing = [key for key in baseline_rows if key not in current_rows]
+    for key, base_row in baseline_rows.items():
+        row = current_rows.get(key)
+        if row is None:
+            continue
+        for metric, rule in config['metrics'].items():
+            if metric not in row or metric not in base_row:
+                continue
+            better = rule.get('better', 'higher')
+            tolerance = overrides.get(metric, rule.get('tolerance', 0.0))
+            change = relative_change(float(base_row[metric]), float(row[metric]), better)
+            entry = (format_key(key_fields, key), metric, base_row[metric], row[metric], change)
+            if change > tolerance:
+                regressions.append(entry)
+            elif change < -tolerance:
+                improvements.append(entry)
+    return regressions, improvements, missing
+
+def print_entries(title, entries, limit):
+    """Print regressions or improvements, worst first."""
+    if not entries:
+        return
+    print(f"{title}:")
+    for row, metric, base, current, change in sorted(entries, key=lambda e: -abs(e[4]))[:limit]:
+        print(f"  {row}: {metric} {base} -> {current} ({-change:+.1%} better)" if change < 0 else
+              f"  {row}: {metric} {base} -> {current} ({change:+.1%} worse)")
+    if len(entries) > limit:
+        print(f"  ... and {len(entries) - limit} more")
+
+def parse_overrides(values):
+    """Parse metric=tolerance overrides."""
+    overrides = {}
+    for value in values:
+        metric, _, tolerance = value.partition('=')
+        overrides[metric] = float(tolerance)
+    return overrides
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare benchmark reports against stored baselines.')
+    parser.add_argument('reports', nargs='*', help='JSON reports (default: scratch/bench/*.json)')
+    parser.add_argument('--baseline-dir', default=BASELINE_DIR, help='Directory of baseline reports, one <benchmark>.json each')
+    parser.add_argument('--tolerances', default=TOLERANCES_YAML, help='Per-benchmark keys and metric tolerances')
+    parser.add_argument('--tolerance', action='append', default=[], metavar='METRIC=FRACTION',
+                        help='Override the tolerance of a metric for every benchmark')
+    parser.add_argument('--update-baseline', action='store_true', help='Store the reports as the new baselines')
+    parser.add_argument('--strict', action='store_true', help='Also fail on baseline rows missing from a report')
+    parser.add_argument('--limit', type=int, default=20, help='Largest number of rows printed per list')
+    args = parser.parse_args()
+
+    reports = args.reports or sorted(glob.glob(os.path.join(REPORT_DIR, '*.json')))
+    if not reports:
+        print(f"No benchmark reports found in {REPORT_DIR}")
+        return 1
+
+    if args.update_baseline:
+        os.makedirs(args.baseline_dir, exist_ok=True)
+        for path in reports:
+            name = load_report(path)['benchmark']
+            shutil.copyfile(path, os.path.join(args.baseline_dir, f"{name}.json"))
+            print(f"Stored {path} as the {name} baseline")
+        return 0
+
+    with open(args.tolerances) as f:
+        tolerances = yaml.safe_load(f)['benchmarks']
+    overrides = parse_overrides(args.tolerance)
+
+    print("==== BENCHMARK REGRESSION CHECK ====\n")
+    overall_success = True
+    for path in reports:
+        current = load_report(path)
+        name = current.get('benchmark', os.path.basename(path))
+        print(f"=== {name} ({current.get('revision', 'unknown')}, {current.get('timestamp', 'unknown')}) ===")
+        config = tolerances.get(name)
+        if config is None:
+            print(f"No tolerances for {name} in {args.tolerances}, skipped.\n")
+            continue
+        baseline_path = os.path.join(args.baseline_dir, f"{name}.json")
+        if not os.path.exists(baseline_path):
+            print(f"No baseline at {baseline_path}, skipped.\n")
+            continue
+        baseline = load_report(baseline_path)
+        print(f"Baseline: {baseline.get('revision', 'unknown')}, {baseline.get('timestamp', 'unknown')}")
+
+        regressions, improvements, missing = compare_report(name, current, baseline, config, overrides)
+        print(f"Rows: {len(current.get('results', []))} current, {len(baseline.get('results', []))} baseline, {len(missing)} missing")
+        print(f"Metrics: {len(regressions)} regressed, {len(improvements)} improved")
+        print_entries("Regressions", regressions, args.limit)
+        print_entries("Improvements", improvements, args.limit)
+        if missing:
+            print("Baseline rows missing from the report:")
+            for key in missing[:args.limit]:
+                print(f"  {format_key(config['key'], key)}")
+        if regressions or (args.strict and missing):
+            overall_success = False
+        print()
+
+    # Overall summary
+    print("==== OVERALL SUMMARY ====")
+    if overall_success:
+        print("No benchmark regressions beyond tolerance.")
+        return 0
+    else:
+        print("Benchmark regressions beyond tolerance found.")
+        return 1
+
+if __name__ == "__main__":
+    sys.exit(main())
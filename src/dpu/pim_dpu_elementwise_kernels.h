@@ -0,0 +1,118 @@
+#ifndef __PIM_DPU_ELEMENTWISE_KERNELS_H__
+#define __PIM_DPU_ELEMENTWISE_KERNELS_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <alloc.h>
+#include <defs.h>
+#include <mram.h>
+
+#include "pim_dpu_kernel_config.h"
+#include "pim_dpu_log.h"
+#include "pim_dpu_perf.h"
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+/**
+ * @brief Elementwise addition of two matrices stored in MRAM.
+ *
+ * Every tasklet streams blocks of PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS elements of both inputs into its own WRAM
+ * buffers, adds them and writes the block back. Blocks are distributed round-robin across tasklets.
+ * The host must pad all three regions to a multiple of 8 elements.
+ *
+ * @param inputs1 Pointer to first matrix data in MRAM
+ * @param inputs2 Pointer to second matrix data in MRAM
+ * @param outputs Pointer to result matrix data in MRAM
+ * @param num_elements Number of elements to add
+ * @return 0 on success, -1 on failure
+ */
+int pim_dpu_elementwise_add(__mram_ptr void* inputs1, __mram_ptr void* inputs2, __mram_ptr void* outputs, uint32_t num_elements) {
+    uint32_t pid = me();
+
+    pim_dpu_matrix1_t* buffer1 = (pim_dpu_matrix1_t*)mem_alloc(PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS * sizeof(pim_dpu_matrix1_t));
+    pim_dpu_matrix2_t* buffer2 = (pim_dpu_matrix2_t*)mem_alloc(PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS * sizeof(pim_dpu_matrix2_t));
+    pim_dpu_result_t* result_buffer = (pim_dpu_result_t*)mem_alloc(PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS * sizeof(pim_dpu_result_t));
+    if (buffer1 == NULL || buffer2 == NULL || result_buffer == NULL) {
+        PIM_DPU_LOG_ERROR("Failed to allocate WRAM for elementwise buffers");
+        return -1;
+    }
+
+    for (uint32_t block_start = pid * PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS; block_start < num_elements;
+         block_start += NR_TASKLETS * PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS) {
+        uint32_t block_elements = num_elements - block_start;
+        if (block_elements > PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS) {
+            block_elements = PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS;
+        }
+        uint32_t padded_elements = (block_elements + 7) & ~7u;
+
+        PIM_DPU_PERF_SAMPLE(read_start);
+        mram_read((__mram_ptr uint8_t*)inputs1 + block_start * sizeof(pim_dpu_matrix1_t), buffer1, padded_elements * sizeof(pim_dpu_matrix1_t));
+        mram_read((__mram_ptr uint8_t*)inputs2 + block_start * sizeof(pim_dpu_matrix2_t), buffer2, padded_elements * sizeof(pim_dpu_matrix2_t));
+        PIM_DPU_PERF_ADD(mram_read_cycles, read_start);
+        PIM_DPU_PERF_SAMPLE(compute_start);
+        for (uint32_t i = 0; i < padded_elements; i++) {
+            result_buffer[i] = (pim_dpu_result_t)((pim_dpu_accumulator_t)buffer1[i] + (pim_dpu_accumulator_t)buffer2[i]);
+        }
+        PIM_DPU_PERF_ADD(compute_cycles, compute_start);
+        PIM_DPU_PERF_SAMPLE(write_start);
+        mram_write(result_buffer, (__mram_ptr uint8_t*)outputs + block_start * sizeof(pim_dpu_result_t), padded_elements * sizeof(pim_dpu_result_t));
+        PIM_DPU_PERF_ADD(mram_write_cycles, write_start);
+    }
+    return 0;
+}
+
+/**
+ * @brief Sum every row of a matrix stored in MRAM.
+ *
+ * Rows are processed in groups of DPU_PIM_REDUCE_ROWS_PER_WRITE so that every result write-back is a whole
+ * number of 8-byte words owned by a single tasklet. Groups are distributed round-robin across tasklets and
+ * every row is streamed in blocks of PIM_DPU_REDUCE_BLOCK_ELEMENTS elements.
+ * The host must pad the row count to a multiple of DPU_PIM_REDUCE_ROWS_PER_WRITE and every row to 8 bytes.
+ *
+ * @param inputs Pointer to matrix data in MRAM (row-major)
+ * @param outputs Pointer to the result vector in MRAM
+ * @param rows Number of rows (multiple of DPU_PIM_REDUCE_ROWS_PER_WRITE)
+ * @param cols Number of columns, including row padding
+ * @return 0 on success, -1 on failure
+ */
+int pim_dpu_reduce_rows(__mram_ptr void* inputs, __mram_ptr void* outputs, uint32_t rows, uint32_t cols) {
+    uint32_t pid = me();
+
+    pim_dpu_matrix1_t* row_buffer = (pim_dpu_matrix1_t*)mem_alloc(PIM_DPU_REDUCE_BLOCK_ELEMENTS * sizeof(pim_dpu_matrix1_t));
+    pim_dpu_result_t* result_buffer = (pim_dpu_result_t*)mem_alloc(DPU_PIM_REDUCE_ROWS_PER_WRITE * sizeof(pim_dpu_result_t));
+    if (row_buffer == NULL || result_buffer == NULL) {
+        PIM_DPU_LOG_ERROR("Failed to allocate WRAM for reduction buffers");
+        return -1;
+    }
+
+    uint32_t row_size = cols * sizeof(pim_dpu_matrix1_t);
+    for (uint32_t group_start = pid * DPU_PIM_REDUCE_ROWS_PER_WRITE; group_start < rows;
+         group_start += NR_TASKLETS * DPU_PIM_REDUCE_ROWS_PER_WRITE) {
+        for (uint32_t r = 0; r < DPU_PIM_REDUCE_ROWS_PER_WRITE; r++) {
+            __mram_ptr uint8_t* row = (__mram_ptr uint8_t*)inputs + (group_start + r) * row_size;
+            pim_dpu_accumulator_t sum = 0;
+            for (uint32_t col_start = 0; col_start < cols; col_start += PIM_DPU_REDUCE_BLOCK_ELEMENTS) {
+                uint32_t block_elements = cols - col_start;
+                if (block_elements > PIM_DPU_REDUCE_BLOCK_ELEMENTS) {
+                    block_elements = PIM_DPU_REDUCE_BLOCK_ELEMENTS;
+                }
+                PIM_DPU_PERF_SAMPLE(read_start);
+                mram_read(row + col_start * sizeof(pim_dpu_matrix1_t), row_buffer, block_elements * sizeof(pim_dpu_matrix1_t));
+                PIM_DPU_PERF_ADD(mram_read_cycles, read_start);
+                PIM_DPU_PERF_SAMPLE(compute_start);
+                for (uint32_t c = 0; c < block_elements; c++) {
+                    sum += row_buffer[c];
+                }
+                PIM_DPU_PERF_ADD(compute_cycles, compute_start);
+            }
+            result_buffer[r] = (pim_dpu_result_t)sum;
+        }
+        PIM_DPU_PERF_SAMPLE(write_start);
+        mram_write(result_buffer, (__mram_ptr uint8_t*)outputs + group_start * sizeof(pim_dpu_result_t),
+                   DPU_PIM_REDUCE_ROWS_PER_WRITE * sizeof(pim_dpu_result_t));
+        PIM_DPU_PERF_ADD(mram_write_cycles, write_start);
+    }
+    return 0;
+}
+
+#endif // __PIM_DPU_ELEMENTWISE_KERNELS_H__
@@ -0,0 +1,121 @@
+#ifndef __PIM_DPU_EPILOGUE_H__
+#define __PIM_DPU_EPILOGUE_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <alloc.h>
+#include <mram.h>
+
+#include "pim_dpu_kernel_config.h"
+#include "pim_dpu_log.h"
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+/**
+ * @brief WRAM state of the fused GEMM epilogue
+ */
+typedef struct {
+    uint32_t flags;          ///< dpu_pim_epilogue_flags_t bitmask
+    int32_t clamp_min;
+    int32_t clamp_max;
+    int32_t* bias;           ///< Per-column bias (NULL when no stage needs parameters)
+    int32_t* multiplier;     ///< Per-column requantisation multiplier
+    int32_t* shift;          ///< Per-column requantisation right shift
+} pim_dpu_epilogue_t;
+
+/**
+ * @brief Load the epilogue configuration and its per-column parameters into WRAM
+ *
+ * Parameters are read only when the bias or requantisation stage is enabled.
+ *
+ * @param epilogue Epilogue state to fill
+ * @param args Kernel arguments passed by the host
+ * @return 0 on success, -1 on failure
+ */
+int pim_dpu_epilogue_load(pim_dpu_epilogue_t* epilogue, const dpu_pim_matrix_multiply_kernel_arguments_t* args) {
+    epilogue->flags = args->epilogue_flags;
+    epilogue->clamp_min = args->clamp_min;
+    epilogue->clamp_max = args->clamp_max;
+    epilogue->bias = NULL;
+    epilogue->multiplier = NULL;
+    epilogue->shift = NULL;
+    if (!(epilogue->flags & (DPU_PIM_EPILOGUE_BIAS | DPU_PIM_EPILOGUE_REQUANTIZE))) {
+        return 0;
+    }
+
+    uint32_t param_count = dpu_pim_epilogue_param_count(args->result_cols);
+    uint32_t params_size = 3 * param_count * sizeof(int32_t);
+    int32_t* params = (int32_t*)mem_alloc(params_size);
+    if (params == NULL) {
+        PIM_DPU_LOG_ERROR("Failed to allocate WRAM for epilogue parameters");
+        return -1;
+    }
+    __mram_ptr uint8_t* params_mram = (__mram_ptr uint8_t*)DPU_MRAM_HEAP_POINTER + args->epilogue_start_offset;
+    for (uint32_t offset = 0; offset < params_size; offset += PIM_DPU_MRAM_DMA_MAX) {
+        uint32_t chunk = params_size - offset < PIM_DPU_MRAM_DMA_MAX ? params_size - offset : PIM_DPU_MRAM_DMA_MAX;
+        mram_read(params_mram + offset, (uint8_t*)params + offset, chunk);
+    }
+    epilogue->bias = params;
+    epilogue->multiplier = params + param_count;
+    epilogue->shift = params + 2 * param_count;
+    return 0;
+}
+
+/**
+ * @brief Apply the enabled epilogue stages to one accumulated value
+ * @param epilogue Loaded epilogue state
+ * @param value Accumulated dot product
+ * @param col Result column of the value within the DPU slice
+ * @return Value after the epilogue, before narrowing to the output type
+ */
+static inline int64_t pim_dpu_epilogue_apply(const pim_dpu_epilogue_t* epilogue, int64_t value, uint32_t col) {
+    if (epilogue->flags & DPU_PIM_EPILOGUE_BIAS) {
+        value += epilogue->bias[col];
+    }
+    if (epilogue->flags & DPU_PIM_EPILOGUE_REQUANTIZE) {
+        int32_t shift = epilogue->shift[col];
+        value *= epilogue->multiplier[col];
+        if (shift > 0) {
+            value = (value + ((int64_t)1 << (shift - 1))) >> shift;
+        }
+        value = value < INT8_MIN ? INT8_MIN : (value > INT8_MAX ? INT8_MAX : value);
+    }
+    if ((epilogue->flags & DPU_PIM_EPILOGUE_RELU) && value < 0) {
+        value = 0;
+    }
+    if (epilogue->flags & DPU_PIM_EPILOGUE_CLAMP) {
+        value = value < epilogue->clamp_min ? epilogue->clamp_min : (value > epilogue->clamp_max ? epilogue->clamp_max : value);
+    }
+    return value;
+}
+
+/**
+ * @brief Size of the elements written back to MRAM
+ */
+static inline uint32_t pim_dpu_epilogue_output_size(const pim_dpu_epilogue_t* epilogue) {
+    return (epilogue->flags & DPU_PIM_EPILOGUE_REQUANTIZE) ? sizeof(int8_t) : sizeof(pim_dpu_result_t);
+}
+
+/**
+ * @brief Store one accumulated value in a WRAM output buffer, running the epilogue first
+ * @param epilogue Loaded epilogue state
+ * @param output Output buffer of pim_dpu_result_t, or int8_t when requantising
+ * @param index Element index in the output buffer
+ * @param value Accumulated dot product
+ * @param col Result column of the value within the DPU slice
+ */
+static inline void pim_dpu_epilogue_store(const pim_dpu_epilogue_t* epilogue, void* output, uint32_t index,
+                                          pim_dpu_accumulator_t value, uint32_t col) {
+    if (epilogue->flags == 0) {
+        ((pim_dpu_result_t*)output)[index] = (pim_dpu_result_t)value;
+        return;
+    }
+    int64_t result = pim_dpu_epilogue_apply(epilogue, (int64_t)value, col);
+    if (epilogue->flags & DPU_PIM_EPILOGUE_REQUANTIZE) {
+        ((int8_t*)output)[index] = (int8_t)result;
+    } else {
+        ((pim_dpu_result_t*)output)[index] = (pim_dpu_result_t)result;
+    }
+}
+
+#endif // __PIM_DPU_EPILOGUE_H__
@@ -0,0 +1,91 @@
+#ifndef __PIM_DPU_GEMM_LUT_H__
+#define __PIM_DPU_GEMM_LUT_H__
+
+#include <stdint.h>
+
+#include "pim_dpu_kernel_config.h"
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+#define PIM_DPU_GEMM_LUT_VALUES (1u << DPU_PIM_GEMM_LUT_BITS)                  ///< Operand values of the product table
+#define PIM_DPU_GEMM_LUT_MASK ((PIM_DPU_GEMM_LUT_VALUES - 1) * 0x01010101u)    ///< Low value bits of every byte of a word
+/// Products in the table: one per operand pair when both operands are 8-bit, none otherwise
+#define PIM_DPU_GEMM_LUT_ENTRIES \
+    (sizeof(pim_dpu_matrix1_t) == 1 && sizeof(pim_dpu_matrix2_t) == 1 ? PIM_DPU_GEMM_LUT_VALUES * PIM_DPU_GEMM_LUT_VALUES : 1)
+
+_Static_assert(2 * DPU_PIM_GEMM_LUT_BITS <= 8, "Product table index must fit a byte");
+
+static int16_t gemm_lut[PIM_DPU_GEMM_LUT_ENTRIES];   // Product table shared by all tasklets, built once by tasklet 0
+
+/**
+ * @brief Value of a DPU_PIM_GEMM_LUT_BITS-bit operand code, sign-extended for signed element types
+ */
+static inline int32_t pim_dpu_gemm_lut_value(uint32_t code, int is_signed) {
+    return is_signed && code >= PIM_DPU_GEMM_LUT_VALUES / 2 ? (int32_t)code - (int32_t)PIM_DPU_GEMM_LUT_VALUES : (int32_t)code;
+}
+
+/**
+ * @brief Fill the product table: entry (a << DPU_PIM_GEMM_LUT_BITS) | b holds the product of the operand values
+ *        with codes a and b
+ *
+ * Run by a single tasklet before the others start multiplying.
+ */
+static void pim_dpu_gemm_lut_build(void) {
+    if (PIM_DPU_GEMM_LUT_ENTRIES == 1) {
+        return;
+    }
+    for (uint32_t a = 0; a < PIM_DPU_GEMM_LUT_VALUES; a++) {
+        int32_t a_value = pim_dpu_gemm_lut_value(a, PIM_DPU_MATRIX1_SIGNED);
+        for (uint32_t b = 0; b < PIM_DPU_GEMM_LUT_VALUES; b++) {
+            gemm_lut[(a << DPU_PIM_GEMM_LUT_BITS) | b] = (int16_t)(a_value * pim_dpu_gemm_lut_value(b, PIM_DPU_MATRIX2_SIGNED));
+        }
+    }
+}
+
+/**
+ * @brief Lookup-table variant of the register-blocked micro-kernel for 8-bit operands of DPU_PIM_GEMM_LUT_BITS bits
+ *
+ * Same contract as pim_dpu_gemm_micro_kernel, without multiplications. The low bits of the four bytes of a
+ * first-matrix word are shifted next to those of a second-matrix word, so a single OR of the two words yields the
+ * table indices of four products, one per byte.
+ *
+ * @param rows First row segment of the block, rows PIM_DPU_GEMM_BLOCK_ELEMENTS apart
+ * @param cols First column segment of the block, columns PIM_DPU_GEMM_BLOCK_ELEMENTS apart
+ * @param tile First accumulator of the block, rows PIM_DPU_GEMM_TILE_COLS apart
+ * @param elements Segment length, a multiple of 8 bytes
+ */
+static inline void pim_dpu_gemm_lut_micro_kernel(const pim_dpu_matrix1_t* rows, const pim_dpu_matrix2_t* cols,
+                                                 pim_dpu_accumulator_t* tile, uint32_t elements) {
+    if (PIM_DPU_GEMM_LUT_ENTRIES == 1) {
+        return;
+    }
+    pim_dpu_accumulator_t acc[PIM_DPU_MICRO_ROWS][PIM_DPU_MICRO_COLS];
+    for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+        for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+            acc[r][c] = 0;
+        }
+    }
+    for (uint32_t k = 0; k < elements; k += 4) {
+        uint32_t a[PIM_DPU_MICRO_ROWS], b[PIM_DPU_MICRO_COLS];
+        for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+            a[r] = (*(const uint32_t*)(rows + r * PIM_DPU_GEMM_BLOCK_ELEMENTS + k) & PIM_DPU_GEMM_LUT_MASK) << DPU_PIM_GEMM_LUT_BITS;
+        }
+        for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+            b[c] = *(const uint32_t*)(cols + c * PIM_DPU_GEMM_BLOCK_ELEMENTS + k) & PIM_DPU_GEMM_LUT_MASK;
+        }
+        for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+            for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+                uint32_t indices = a[r] | b[c];
+                acc[r][c] += gemm_lut[indices & 0xff] + gemm_lut[(indices >> 8) & 0xff] +
+                             gemm_lut[(indices >> 16) & 0xff] + gemm_lut[indices >> 24];
+            }
+        }
+    }
+    for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+        for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+            tile[r * PIM_DPU_GEMM_TILE_COLS + c] += acc[r][c];
+        }
+    }
+}
+
+#endif // __PIM_DPU_GEMM_LUT_H__
@@ -0,0 +1,191 @@
+#ifndef __PIM_DPU_GEMM_OUTER_KERNEL_H__
+#define __PIM_DPU_GEMM_OUTER_KERNEL_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <alloc.h>
+#include <barrier.h>
+#include <defs.h>
+#include <mram.h>
+
+#include "pim_dpu_kernel_config.h"
+#include "pim_dpu_log.h"
+#include "pim_dpu_perf.h"
+#include "pim_dpu_epilogue.h"
+#include "pim_dpu_gemm_tiled_kernel.h"
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+BARRIER_INIT(gemm_outer_barrier, NR_TASKLETS);
+
+static pim_dpu_epilogue_t gemm_outer_epilogue;   // Epilogue shared by all tasklets, loaded once by tasklet 0
+static int32_t gemm_outer_status;
+static uint8_t* gemm_outer_wram;                 // Shared panel, then PIM_DPU_GEMM_OUTER_WRAM_PER_TASKLET bytes per tasklet
+
+/**
+ * @brief Register-blocked rank-1 updates: adds the outer products of elements columns of a row block and elements
+ *        rows of a panel to a PIM_DPU_MICRO_ROWS x PIM_DPU_MICRO_COLS block of a band
+ *
+ * @param rows First row of the block, rows PIM_DPU_GEMM_OUTER_BLOCK_ROWS apart
+ * @param panel First column of the block in the panel, rows panel_cols apart
+ * @param band First accumulator of the block, rows PIM_DPU_GEMM_OUTER_COLS apart
+ * @param elements Inner-dimension elements of the panel
+ */
+static inline void pim_dpu_gemm_outer_micro_kernel(const pim_dpu_matrix1_t* rows, const pim_dpu_matrix2_t* panel, uint32_t panel_cols,
+                                                   pim_dpu_accumulator_t* band, uint32_t elements) {
+    pim_dpu_accumulator_t acc[PIM_DPU_MICRO_ROWS][PIM_DPU_MICRO_COLS];
+    for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+        for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+            acc[r][c] = 0;
+        }
+    }
+    for (uint32_t k = 0; k < elements; k++) {
+        pim_dpu_accumulator_t a[PIM_DPU_MICRO_ROWS];
+        for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+            a[r] = rows[r * PIM_DPU_GEMM_OUTER_BLOCK_ROWS + k];
+        }
+        const pim_dpu_matrix2_t* panel_row = panel + k * panel_cols;
+        for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+            pim_dpu_matrix2_t b = panel_row[c];
+            for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+                acc[r][c] += a[r] * b;
+            }
+        }
+    }
+    for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+        for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+            band[r * PIM_DPU_GEMM_OUTER_COLS + c] += acc[r][c];
+        }
+    }
+}
+
+/**
+ * @brief Outer-product GEMM of a row slice of the first matrix by a row-major column slice of the second matrix
+ *
+ * The result is split into bands of PIM_DPU_TILE_ROWS full rows distributed round-robin across tasklets, and every
+ * tasklet keeps the accumulators of its band resident in WRAM. All tasklets stream the inner dimension together in
+ * panels of PIM_DPU_GEMM_OUTER_BLOCK_ROWS rows of the second matrix: a panel is one contiguous MRAM region, read in
+ * 2048-byte transfers split across tasklets into WRAM shared by all of them. Every tasklet then adds the rank-1
+ * updates of the panel rows and the matching columns of its band rows to the band, so every second-matrix element is
+ * read from MRAM once per round of bands instead of once per output tile. Finished bands run through the epilogue and
+ * are written back one row at a time. The slice width and the result width must not exceed PIM_DPU_GEMM_OUTER_COLS.
+ *
+ * @param inputs1 Pointer to first matrix data in MRAM (row-major, matrix1_rows x matrix1_cols)
+ * @param inputs2 Pointer to second matrix data in MRAM (row-major, matrix2_cols rows of matrix2_rows)
+ * @param outputs Pointer to result matrix data in MRAM (row-major, result_rows x result_cols of the output type)
+ * @param args Kernel arguments passed by the host, for the dimensions and the epilogue
+ * @return 0 on success, -1 on failure
+ */
+int pim_dpu_gemm_outer(__mram_ptr void* inputs1, __mram_ptr void* inputs2, __mram_ptr void* outputs,
+                       const dpu_pim_matrix_multiply_kernel_arguments_t* args) {
+    uint32_t pid = me();
+    uint32_t inner = args->matrix1_cols;
+    uint32_t panel_cols = args->matrix2_rows;
+    uint32_t result_rows = args->result_rows;
+    uint32_t result_cols = args->result_cols;
+    // The result may be padded wider than the operands when the epilogue narrows it
+    uint32_t compute_rows = result_rows < args->matrix1_rows ? result_rows : args->matrix1_rows;
+    uint32_t compute_cols = result_cols < panel_cols ? result_cols : panel_cols;
+
+    if (args->matrix1_cols != args->matrix2_cols) {
+        if (pid == 0) {
+            PIM_DPU_LOG_ERROR("Matrix dimensions incompatible for multiplication (matrix1_cols=%u != matrix2_cols=%u)",
+                              args->matrix1_cols, args->matrix2_cols);
+        }
+        return -1;
+    }
+    if (panel_cols > PIM_DPU_GEMM_OUTER_COLS || result_cols > PIM_DPU_GEMM_OUTER_COLS) {
+        if (pid == 0) {
+            PIM_DPU_LOG_ERROR("Outer-product GEMM bands hold %u columns (slice has %u, result %u)",
+                              (uint32_t)PIM_DPU_GEMM_OUTER_COLS, panel_cols, result_cols);
+        }
+        return -1;
+    }
+
+    if (pid == 0) {
+        gemm_outer_status = 0;
+        PIM_DPU_PERF_SAMPLE(epilogue_start);
+        if (pim_dpu_epilogue_load(&gemm_outer_epilogue, args) != 0) {
+            gemm_outer_status = -1;
+        }
+        PIM_DPU_PERF_ADD(mram_read_cycles, epilogue_start);
+        gemm_outer_wram = (uint8_t*)mem_alloc(PIM_DPU_GEMM_OUTER_WRAM(PIM_DPU_GEMM_OUTER_COLS));
+        if (gemm_outer_wram == NULL) {
+            PIM_DPU_LOG_ERROR("Failed to allocate WRAM for the outer-product GEMM");
+            gemm_outer_status = -1;
+        }
+    }
+    barrier_wait(&gemm_outer_barrier);
+    if (gemm_outer_status != 0) {
+        return -1;
+    }
+
+    pim_dpu_matrix2_t* panel = (pim_dpu_matrix2_t*)gemm_outer_wram;
+    uint8_t* tasklet_wram = gemm_outer_wram + PIM_DPU_GEMM_OUTER_BLOCK_ROWS * PIM_DPU_GEMM_OUTER_COLS * sizeof(pim_dpu_matrix2_t) +
+                            pid * PIM_DPU_GEMM_OUTER_WRAM_PER_TASKLET(PIM_DPU_GEMM_OUTER_COLS);
+    pim_dpu_matrix1_t* rows_block = (pim_dpu_matrix1_t*)tasklet_wram;
+    pim_dpu_accumulator_t* accumulators =
+        (pim_dpu_accumulator_t*)(rows_block + PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_OUTER_BLOCK_ROWS);
+    uint8_t* tile_row = (uint8_t*)(accumulators + PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_OUTER_COLS);
+    // Register blocks on the band edge also read the rows past the valid rows; their sums are dropped
+    for (uint32_t i = 0; i < PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_OUTER_BLOCK_ROWS; i++) {
+        rows_block[i] = 0;
+    }
+
+    // Every tasklet takes part in every panel, so all of them run the same number of rounds
+    uint32_t bands = (result_rows + PIM_DPU_TILE_ROWS - 1) / PIM_DPU_TILE_ROWS;
+    uint32_t rounds = (bands + NR_TASKLETS - 1) / NR_TASKLETS;
+    for (uint32_t round = 0; round < rounds; round++) {
+        pim_dpu_gemm_tile_t band;
+        band.row_start = (round * NR_TASKLETS + pid) * PIM_DPU_TILE_ROWS;
+        band.col_start = 0;
+        band.rows = result_rows > band.row_start ? result_rows - band.row_start : 0;
+        band.rows = band.rows < PIM_DPU_TILE_ROWS ? band.rows : PIM_DPU_TILE_ROWS;
+        band.cols = result_cols;
+        band.valid_rows = compute_rows > band.row_start ? compute_rows - band.row_start : 0;
+        band.valid_rows = band.valid_rows < band.rows ? band.valid_rows : band.rows;
+        band.valid_cols = compute_cols;
+
+        for (uint32_t i = 0; i < PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_OUTER_COLS; i++) {
+            accumulators[i] = 0;
+        }
+        for (uint32_t block_start = 0; block_start < inner; block_start += PIM_DPU_GEMM_OUTER_BLOCK_ROWS) {
+            uint32_t block_elements = inner - block_start;
+            if (block_elements > PIM_DPU_GEMM_OUTER_BLOCK_ROWS) {
+                block_elements = PIM_DPU_GEMM_OUTER_BLOCK_ROWS;
+            }
+
+            PIM_DPU_PERF_SAMPLE(read_start);
+            uint32_t panel_bytes = block_elements * panel_cols * sizeof(pim_dpu_matrix2_t);
+            __mram_ptr uint8_t* panel_source = (__mram_ptr uint8_t*)inputs2 + block_start * panel_cols * sizeof(pim_dpu_matrix2_t);
+            for (uint32_t offset = pid * PIM_DPU_MRAM_DMA_MAX; offset < panel_bytes; offset += NR_TASKLETS * PIM_DPU_MRAM_DMA_MAX) {
+                uint32_t bytes = panel_bytes - offset < PIM_DPU_MRAM_DMA_MAX ? panel_bytes - offset : PIM_DPU_MRAM_DMA_MAX;
+                mram_read(panel_source + offset, (uint8_t*)panel + offset, bytes);
+            }
+            for (uint32_t r = 0; r < band.valid_rows; r++) {
+                mram_read((__mram_ptr uint8_t*)inputs1 + ((band.row_start + r) * inner + block_start) * sizeof(pim_dpu_matrix1_t),
+                          rows_block + r * PIM_DPU_GEMM_OUTER_BLOCK_ROWS, block_elements * sizeof(pim_dpu_matrix1_t));
+            }
+            PIM_DPU_PERF_ADD(mram_read_cycles, read_start);
+            barrier_wait(&gemm_outer_barrier);
+
+            PIM_DPU_PERF_SAMPLE(compute_start);
+            for (uint32_t r = 0; r < band.valid_rows; r += PIM_DPU_MICRO_ROWS) {
+                for (uint32_t c = 0; c < band.valid_cols; c += PIM_DPU_MICRO_COLS) {
+                    pim_dpu_gemm_outer_micro_kernel(rows_block + r * PIM_DPU_GEMM_OUTER_BLOCK_ROWS, panel + c, panel_cols,
+                                                    accumulators + r * PIM_DPU_GEMM_OUTER_COLS + c, block_elements);
+                }
+            }
+            PIM_DPU_PERF_ADD(compute_cycles, compute_start);
+            // The panel is overwritten by the next block only once every tasklet is done with it
+            barrier_wait(&gemm_outer_barrier);
+        }
+
+        PIM_DPU_PERF_SAMPLE(write_start);
+        pim_dpu_gemm_write_tile(&gemm_outer_epilogue, outputs, accumulators, PIM_DPU_GEMM_OUTER_COLS, tile_row, &band, result_cols);
+        PIM_DPU_PERF_ADD(mram_write_cycles, write_start);
+    }
+    return 0;
+}
+
+#endif // __PIM_DPU_GEMM_OUTER_KERNEL_H__
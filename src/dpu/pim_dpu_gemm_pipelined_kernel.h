@@ -0,0 +1,157 @@
+#ifndef __PIM_DPU_GEMM_PIPELINED_KERNEL_H__
+#define __PIM_DPU_GEMM_PIPELINED_KERNEL_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <alloc.h>
+#include <barrier.h>
+#include <defs.h>
+#include <mram.h>
+
+#include "pim_dpu_kernel_config.h"
+#include "pim_dpu_log.h"
+#include "pim_dpu_perf.h"
+#include "pim_dpu_epilogue.h"
+#include "pim_dpu_gemm_tiled_kernel.h"
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+BARRIER_INIT(gemm_pipelined_barrier, NR_TASKLETS);
+
+static pim_dpu_epilogue_t gemm_pipelined_epilogue;   // Epilogue shared by all tasklets, loaded once by tasklet 0
+static int32_t gemm_pipelined_status;
+static uint8_t* gemm_pipelined_wram;                 // PIM_DPU_PIPELINE_WRAM_PER_TASKLET bytes per compute tasklet
+
+/**
+ * @brief WRAM of a compute tasklet: operand buffer 0, operand buffer 1, accumulator tile, tile row
+ */
+static inline uint8_t* pim_dpu_gemm_pipelined_buffer(uint32_t consumer, uint32_t buffer) {
+    return gemm_pipelined_wram + consumer * PIM_DPU_PIPELINE_WRAM_PER_TASKLET + buffer * PIM_DPU_PIPELINE_BUFFER_BYTES;
+}
+
+/**
+ * @brief Number of output tiles of a compute tasklet; tiles are distributed round-robin across compute tasklets
+ */
+static inline uint32_t pim_dpu_gemm_pipelined_tiles(uint32_t consumer, uint32_t num_tiles) {
+    return num_tiles > consumer ? (num_tiles - consumer + PIM_DPU_PIPELINE_COMPUTE_TASKLETS - 1) / PIM_DPU_PIPELINE_COMPUTE_TASKLETS : 0;
+}
+
+/**
+ * @brief Pipelined GEMM: the tiled GEMM with operand transfers overlapped with computation
+ *
+ * Tasklets 0 to PIM_DPU_PIPELINE_COMPUTE_TASKLETS - 1 compute output tiles as in pim_dpu_gemm_tiled; the remaining
+ * PIM_DPU_PIPELINE_FETCH_TASKLETS tasklets only read operand blocks, each serving every PIM_DPU_PIPELINE_FETCH_TASKLETS-th
+ * compute tasklet. Every compute tasklet owns two operand buffers. The kernel runs in rounds separated by barriers:
+ * in round n, the fetch tasklets read step n of their compute tasklets into buffer n % 2 while the compute tasklets
+ * accumulate step n - 1 from the other buffer, so a compute tasklet never waits for its own transfers. A step is one
+ * inner-dimension block of one tile; the last block of a tile is followed by its epilogue and write-back.
+ *
+ * @param inputs1 Pointer to first matrix data in MRAM (row-major, matrix1_rows x matrix1_cols)
+ * @param inputs2 Pointer to second matrix data in MRAM (column-major, matrix2_rows columns of matrix2_cols)
+ * @param outputs Pointer to result matrix data in MRAM (row-major, result_rows x result_cols of the output type)
+ * @param args Kernel arguments passed by the host, for the dimensions and the epilogue
+ * @return 0 on success, -1 on failure
+ */
+int pim_dpu_gemm_pipelined(__mram_ptr void* inputs1, __mram_ptr void* inputs2, __mram_ptr void* outputs,
+                           const dpu_pim_matrix_multiply_kernel_arguments_t* args) {
+    uint32_t pid = me();
+    uint32_t inner = args->matrix1_cols;
+    uint32_t result_rows = args->result_rows;
+    uint32_t result_cols = args->result_cols;
+    // The result may be padded wider than the operands when the epilogue narrows it
+    uint32_t compute_rows = result_rows < args->matrix1_rows ? result_rows : args->matrix1_rows;
+    uint32_t compute_cols = result_cols < args->matrix2_rows ? result_cols : args->matrix2_rows;
+
+    if (args->matrix1_cols != args->matrix2_cols) {
+        if (pid == 0) {
+            PIM_DPU_LOG_ERROR("Matrix dimensions incompatible for multiplication (matrix1_cols=%u != matrix2_cols=%u)",
+                              args->matrix1_cols, args->matrix2_cols);
+        }
+        return -1;
+    }
+
+    // Buffers are shared between fetch and compute tasklets, so tasklet 0 allocates all of them before the rounds start
+    if (pid == 0) {
+        gemm_pipelined_status = 0;
+        PIM_DPU_PERF_SAMPLE(epilogue_start);
+        if (pim_dpu_epilogue_load(&gemm_pipelined_epilogue, args) != 0) {
+            gemm_pipelined_status = -1;
+        }
+        PIM_DPU_PERF_ADD(mram_read_cycles, epilogue_start);
+        gemm_pipelined_wram = (uint8_t*)mem_alloc(PIM_DPU_PIPELINE_COMPUTE_TASKLETS * PIM_DPU_PIPELINE_WRAM_PER_TASKLET);
+        if (gemm_pipelined_wram == NULL) {
+            PIM_DPU_LOG_ERROR("Failed to allocate WRAM for pipelined GEMM buffers");
+            gemm_pipelined_status = -1;
+        } else {
+            // Register blocks on the tile edge also read the segments past the valid rows and columns; their sums are dropped
+            for (uint32_t i = 0; i < PIM_DPU_PIPELINE_COMPUTE_TASKLETS * PIM_DPU_PIPELINE_WRAM_PER_TASKLET; i++) {
+                gemm_pipelined_wram[i] = 0;
+            }
+        }
+    }
+    barrier_wait(&gemm_pipelined_barrier);
+    if (gemm_pipelined_status != 0) {
+        return -1;
+    }
+
+    uint32_t num_tiles = ((result_rows + PIM_DPU_TILE_ROWS - 1) / PIM_DPU_TILE_ROWS) *
+                         ((result_cols + PIM_DPU_GEMM_TILE_COLS - 1) / PIM_DPU_GEMM_TILE_COLS);
+    uint32_t num_blocks = inner > 0 ? (inner + PIM_DPU_GEMM_BLOCK_ELEMENTS - 1) / PIM_DPU_GEMM_BLOCK_ELEMENTS : 1;
+    uint32_t num_rounds = pim_dpu_gemm_pipelined_tiles(0, num_tiles) * num_blocks + 1;
+
+    // Every tasklet runs every round, so all of them reach the same barriers
+    for (uint32_t round = 0; round < num_rounds; round++) {
+        if (pid >= PIM_DPU_PIPELINE_COMPUTE_TASKLETS) {
+            uint32_t step = round;
+            PIM_DPU_PERF_SAMPLE(read_start);
+            for (uint32_t consumer = pid - PIM_DPU_PIPELINE_COMPUTE_TASKLETS; consumer < PIM_DPU_PIPELINE_COMPUTE_TASKLETS;
+                 consumer += PIM_DPU_PIPELINE_FETCH_TASKLETS) {
+                if (step >= pim_dpu_gemm_pipelined_tiles(consumer, num_tiles) * num_blocks) {
+                    continue;
+                }
+                pim_dpu_gemm_tile_t tile;
+                pim_dpu_gemm_tile_at(&tile, consumer + (step / num_blocks) * PIM_DPU_PIPELINE_COMPUTE_TASKLETS,
+                                     result_rows, result_cols, compute_rows, compute_cols);
+                uint32_t block_start = (step % num_blocks) * PIM_DPU_GEMM_BLOCK_ELEMENTS;
+                uint32_t block_elements = inner - block_start < PIM_DPU_GEMM_BLOCK_ELEMENTS ? inner - block_start : PIM_DPU_GEMM_BLOCK_ELEMENTS;
+                uint8_t* buffer = pim_dpu_gemm_pipelined_buffer(consumer, step % 2);
+                pim_dpu_gemm_read_block(inputs1, inputs2, &tile, inner, block_start, block_elements, (pim_dpu_matrix1_t*)buffer,
+                                        (pim_dpu_matrix2_t*)(buffer + PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_BLOCK_ELEMENTS * sizeof(pim_dpu_matrix1_t)));
+            }
+            PIM_DPU_PERF_ADD(mram_read_cycles, read_start);
+        } else if (round > 0 && round - 1 < pim_dpu_gemm_pipelined_tiles(pid, num_tiles) * num_blocks) {
+            uint32_t step = round - 1;
+            uint32_t block = step % num_blocks;
+            pim_dpu_gemm_tile_t tile;
+            pim_dpu_gemm_tile_at(&tile, pid + (step / num_blocks) * PIM_DPU_PIPELINE_COMPUTE_TASKLETS,
+                                 result_rows, result_cols, compute_rows, compute_cols);
+            uint32_t block_start = block * PIM_DPU_GEMM_BLOCK_ELEMENTS;
+            uint32_t block_elements = inner - block_start < PIM_DPU_GEMM_BLOCK_ELEMENTS ? inner - block_start : PIM_DPU_GEMM_BLOCK_ELEMENTS;
+            uint8_t* buffer = pim_dpu_gemm_pipelined_buffer(pid, step % 2);
+            pim_dpu_accumulator_t* accumulators = (pim_dpu_accumulator_t*)pim_dpu_gemm_pipelined_buffer(pid, 2);
+            uint8_t* tile_row = (uint8_t*)(accumulators + PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_TILE_COLS);
+
+            PIM_DPU_PERF_SAMPLE(compute_start);
+            if (block == 0) {
+                for (uint32_t i = 0; i < PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_TILE_COLS; i++) {
+                    accumulators[i] = 0;
+                }
+            }
+            pim_dpu_gemm_compute_block((const pim_dpu_matrix1_t*)buffer,
+                                       (const pim_dpu_matrix2_t*)(buffer + PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_BLOCK_ELEMENTS * sizeof(pim_dpu_matrix1_t)),
+                                       accumulators, &tile, block_elements, 0);
+            PIM_DPU_PERF_ADD(compute_cycles, compute_start);
+
+            if (block == num_blocks - 1) {
+                PIM_DPU_PERF_SAMPLE(write_start);
+                pim_dpu_gemm_write_tile(&gemm_pipelined_epilogue, outputs, accumulators, PIM_DPU_GEMM_TILE_COLS, tile_row, &tile,
+                                        result_cols);
+                PIM_DPU_PERF_ADD(mram_write_cycles, write_start);
+            }
+        }
+        barrier_wait(&gemm_pipelined_barrier);
+    }
+    return 0;
+}
+
+#endif // __PIM_DPU_GEMM_PIPELINED_KERNEL_H__
@@ -0,0 +1,305 @@
+#ifndef __PIM_DPU_GEMM_TILED_KERNEL_H__
+#define __PIM_DPU_GEMM_TILED_KERNEL_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <alloc.h>
+#include <barrier.h>
+#include <defs.h>
+#include <mram.h>
+
+#include "pim_dpu_kernel_config.h"
+#include "pim_dpu_log.h"
+#include "pim_dpu_perf.h"
+#include "pim_dpu_epilogue.h"
+#include "pim_dpu_mul.h"
+#include "pim_dpu_gemm_lut.h"
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+BARRIER_INIT(gemm_tiled_barrier, NR_TASKLETS);
+
+static pim_dpu_epilogue_t gemm_tiled_epilogue;   // Epilogue shared by all tasklets, loaded once by tasklet 0
+static int32_t gemm_tiled_status;
+
+/**
+ * @brief Register-blocked micro-kernel: adds a PIM_DPU_MICRO_ROWS x PIM_DPU_MICRO_COLS block of dot products to a tile
+ *
+ * Every loaded operand is reused across a whole row or column of the register block. With 8-bit operands, four
+ * elements are loaded per 32-bit WRAM word and unpacked in registers, so one load feeds four multiplications.
+ * PIM_DPU_MULTIPLY selects how they are multiplied: as C integers, with one 8x8-bit multiply instruction per
+ * unpacked byte, or (packed builtin) with the low and high byte multiplies reading both elements of a 16-bit half in
+ * place. The packed form still issues one multiply per byte product and only saves the shifts that extract the high
+ * bytes.
+ *
+ * @param rows First row segment of the block, rows PIM_DPU_GEMM_BLOCK_ELEMENTS apart
+ * @param cols First column segment of the block, columns PIM_DPU_GEMM_BLOCK_ELEMENTS apart
+ * @param tile First accumulator of the block, rows PIM_DPU_GEMM_TILE_COLS apart
+ * @param elements Segment length, a multiple of 8 bytes
+ */
+static inline void pim_dpu_gemm_micro_kernel(const pim_dpu_matrix1_t* rows, const pim_dpu_matrix2_t* cols,
+                                             pim_dpu_accumulator_t* tile, uint32_t elements) {
+    pim_dpu_accumulator_t acc[PIM_DPU_MICRO_ROWS][PIM_DPU_MICRO_COLS];
+    for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+        for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+            acc[r][c] = 0;
+        }
+    }
+    if (sizeof(pim_dpu_matrix1_t) == 1 && sizeof(pim_dpu_matrix2_t) == 1) {
+        // Segments start 8-byte aligned and hold a multiple of 8 bytes, so every word load is aligned
+        for (uint32_t k = 0; k < elements; k += 4) {
+            uint32_t a[PIM_DPU_MICRO_ROWS], b[PIM_DPU_MICRO_COLS];
+            for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+                a[r] = *(const uint32_t*)(rows + r * PIM_DPU_GEMM_BLOCK_ELEMENTS + k);
+            }
+            for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+                b[c] = *(const uint32_t*)(cols + c * PIM_DPU_GEMM_BLOCK_ELEMENTS + k);
+            }
+#if PIM_DPU_MULTIPLY == PIM_DPU_MULTIPLY_PACKED_BUILTIN
+            for (uint32_t half = 0; half < 32; half += 16) {
+                for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+                    uint32_t a_half = a[r] >> half;
+                    for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+                        uint32_t b_half = b[c] >> half;
+                        acc[r][c] += pim_dpu_mul_low(a_half, b_half) + pim_dpu_mul_high(a_half, b_half);
+                    }
+                }
+            }
+#else
+            for (uint32_t byte = 0; byte < 4; byte++) {
+                for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+#if PIM_DPU_MULTIPLY == PIM_DPU_MULTIPLY_BUILTIN
+                    uint32_t a_value = a[r] >> (8 * byte);
+                    for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+                        acc[r][c] += pim_dpu_mul_low(a_value, b[c] >> (8 * byte));
+                    }
+#else
+                    pim_dpu_accumulator_t a_value = (pim_dpu_matrix1_t)(a[r] >> (8 * byte));
+                    for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+                        acc[r][c] += a_value * (pim_dpu_matrix2_t)(b[c] >> (8 * byte));
+                    }
+#endif
+                }
+            }
+#endif
+        }
+    } else {
+        for (uint32_t k = 0; k < elements; k++) {
+            pim_dpu_accumulator_t a[PIM_DPU_MICRO_ROWS];
+            for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+                a[r] = rows[r * PIM_DPU_GEMM_BLOCK_ELEMENTS + k];
+            }
+            for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+                pim_dpu_matrix2_t b = cols[c * PIM_DPU_GEMM_BLOCK_ELEMENTS + k];
+                for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+                    acc[r][c] += a[r] * b;
+                }
+            }
+        }
+    }
+    for (uint32_t r = 0; r < PIM_DPU_MICRO_ROWS; r++) {
+        for (uint32_t c = 0; c < PIM_DPU_MICRO_COLS; c++) {
+            tile[r * PIM_DPU_GEMM_TILE_COLS + c] += acc[r][c];
+        }
+    }
+}
+
+/**
+ * @brief Output tile of the tiled GEMM kernels
+ */
+typedef struct {
+    uint32_t row_start;    ///< First result row of the tile
+    uint32_t col_start;    ///< First result column of the tile
+    uint32_t rows;         ///< Result rows of the tile, fewer on the last tile row
+    uint32_t cols;         ///< Result columns of the tile, fewer on the last tile column
+    uint32_t valid_rows;   ///< Rows backed by operand data; the rest is result padding
+    uint32_t valid_cols;   ///< Columns backed by operand data; the rest is result padding
+} pim_dpu_gemm_tile_t;
+
+/**
+ * @brief Place output tile tile_index of a result_rows x result_cols result, tiles numbered row by row
+ *
+ * @param compute_rows Result rows backed by first-matrix rows
+ * @param compute_cols Result columns backed by second-matrix columns
+ */
+static inline void pim_dpu_gemm_tile_at(pim_dpu_gemm_tile_t* tile, uint32_t tile_index, uint32_t result_rows, uint32_t result_cols,
+                                        uint32_t compute_rows, uint32_t compute_cols) {
+    uint32_t col_tiles = (result_cols + PIM_DPU_GEMM_TILE_COLS - 1) / PIM_DPU_GEMM_TILE_COLS;
+    tile->row_start = (tile_index / col_tiles) * PIM_DPU_TILE_ROWS;
+    tile->col_start = (tile_index % col_tiles) * PIM_DPU_GEMM_TILE_COLS;
+    tile->rows = result_rows - tile->row_start < PIM_DPU_TILE_ROWS ? result_rows - tile->row_start : PIM_DPU_TILE_ROWS;
+    tile->cols = result_cols - tile->col_start < PIM_DPU_GEMM_TILE_COLS ? result_cols - tile->col_start : PIM_DPU_GEMM_TILE_COLS;
+    tile->valid_rows = compute_rows > tile->row_start ? compute_rows - tile->row_start : 0;
+    tile->valid_cols = compute_cols > tile->col_start ? compute_cols - tile->col_start : 0;
+    tile->valid_rows = tile->valid_rows < tile->rows ? tile->valid_rows : tile->rows;
+    tile->valid_cols = tile->valid_cols < tile->cols ? tile->valid_cols : tile->cols;
+}
+
+/**
+ * @brief Read one inner-dimension block of the rows and columns of a tile into WRAM, one transfer per segment
+ *
+ * @param rows_block Destination of the row segments, PIM_DPU_GEMM_BLOCK_ELEMENTS apart
+ * @param cols_block Destination of the column segments, PIM_DPU_GEMM_BLOCK_ELEMENTS apart
+ */
+static inline void pim_dpu_gemm_read_block(__mram_ptr void* inputs1, __mram_ptr void* inputs2, const pim_dpu_gemm_tile_t* tile,
+                                           uint32_t inner, uint32_t block_start, uint32_t block_elements,
+                                           pim_dpu_matrix1_t* rows_block, pim_dpu_matrix2_t* cols_block) {
+    for (uint32_t r = 0; r < tile->valid_rows; r++) {
+        mram_read((__mram_ptr uint8_t*)inputs1 + ((tile->row_start + r) * inner + block_start) * sizeof(pim_dpu_matrix1_t),
+                  rows_block + r * PIM_DPU_GEMM_BLOCK_ELEMENTS, block_elements * sizeof(pim_dpu_matrix1_t));
+    }
+    for (uint32_t c = 0; c < tile->valid_cols; c++) {
+        mram_read((__mram_ptr uint8_t*)inputs2 + ((tile->col_start + c) * inner + block_start) * sizeof(pim_dpu_matrix2_t),
+                  cols_block + c * PIM_DPU_GEMM_BLOCK_ELEMENTS, block_elements * sizeof(pim_dpu_matrix2_t));
+    }
+}
+
+/**
+ * @brief Accumulate one inner-dimension block of a tile with the register-blocked (or lookup-table) micro-kernel
+ *
+ * @param accumulators Tile accumulators, rows PIM_DPU_GEMM_TILE_COLS apart
+ * @param lut Whether to look products up in the table built by pim_dpu_gemm_lut_build
+ */
+static inline void pim_dpu_gemm_compute_block(const pim_dpu_matrix1_t* rows_block, const pim_dpu_matrix2_t* cols_block,
+                                              pim_dpu_accumulator_t* accumulators, const pim_dpu_gemm_tile_t* tile,
+                                              uint32_t block_elements, int lut) {
+    for (uint32_t r = 0; r < tile->valid_rows; r += PIM_DPU_MICRO_ROWS) {
+        for (uint32_t c = 0; c < tile->valid_cols; c += PIM_DPU_MICRO_COLS) {
+            if (lut) {
+                pim_dpu_gemm_lut_micro_kernel(rows_block + r * PIM_DPU_GEMM_BLOCK_ELEMENTS, cols_block + c * PIM_DPU_GEMM_BLOCK_ELEMENTS,
+                                              accumulators + r * PIM_DPU_GEMM_TILE_COLS + c, block_elements);
+            } else {
+                pim_dpu_gemm_micro_kernel(rows_block + r * PIM_DPU_GEMM_BLOCK_ELEMENTS, cols_block + c * PIM_DPU_GEMM_BLOCK_ELEMENTS,
+                                          accumulators + r * PIM_DPU_GEMM_TILE_COLS + c, block_elements);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Run a finished tile through the epilogue and write it back one tile row at a time
+ *
+ * Tile rows start at a multiple of PIM_DPU_GEMM_TILE_COLS and end at one or at the padded row end, so every write is
+ * 8-byte aligned. Result padding outside the operands is written as zero.
+ *
+ * @param accumulators Tile accumulators, rows accumulator_stride apart
+ * @param tile_row WRAM buffer of tile->cols results
+ */
+static inline void pim_dpu_gemm_write_tile(const pim_dpu_epilogue_t* epilogue, __mram_ptr void* outputs,
+                                           const pim_dpu_accumulator_t* accumulators, uint32_t accumulator_stride, uint8_t* tile_row,
+                                           const pim_dpu_gemm_tile_t* tile, uint32_t result_cols) {
+    uint32_t output_size = pim_dpu_epilogue_output_size(epilogue);
+    for (uint32_t r = 0; r < tile->rows; r++) {
+        for (uint32_t i = 0; i < tile->cols * output_size; i++) {
+            tile_row[i] = 0;
+        }
+        for (uint32_t c = 0; r < tile->valid_rows && c < tile->valid_cols; c++) {
+            pim_dpu_epilogue_store(epilogue, tile_row, c, accumulators[r * accumulator_stride + c], tile->col_start + c);
+        }
+        mram_write(tile_row, (__mram_ptr uint8_t*)outputs + ((tile->row_start + r) * result_cols + tile->col_start) * output_size,
+                   tile->cols * output_size);
+    }
+}
+
+/**
+ * @brief Tiled GEMM of a row slice of the first matrix by a column slice of the second matrix stored in MRAM
+ *
+ * The result is split into output tiles of PIM_DPU_TILE_ROWS x PIM_DPU_GEMM_TILE_COLS distributed round-robin
+ * across tasklets. For its tile, a tasklet streams the inner dimension in blocks of PIM_DPU_GEMM_BLOCK_ELEMENTS:
+ * every block of the tile's first-matrix rows and second-matrix columns is read into per-tasklet WRAM buffers and
+ * accumulated into the tile by the register-blocked micro-kernel. The finished tile runs through the epilogue and is
+ * written back one tile row at a time, so WRAM use does not depend on the matrix sizes. Result padding outside the
+ * operands is written as zero. For DPU_PIM_GEMM_LUT, tasklet 0 first builds the product table and blocks are
+ * accumulated by the lookup-table micro-kernel instead.
+ *
+ * @param inputs1 Pointer to first matrix data in MRAM (row-major, matrix1_rows x matrix1_cols)
+ * @param inputs2 Pointer to second matrix data in MRAM (column-major, matrix2_rows columns of matrix2_cols)
+ * @param outputs Pointer to result matrix data in MRAM (row-major, result_rows x result_cols of the output type)
+ * @param args Kernel arguments passed by the host, for the dimensions, the epilogue and the GEMM variant
+ * @return 0 on success, -1 on failure
+ */
+int pim_dpu_gemm_tiled(__mram_ptr void* inputs1, __mram_ptr void* inputs2, __mram_ptr void* outputs,
+                       const dpu_pim_matrix_multiply_kernel_arguments_t* args) {
+    uint32_t pid = me();
+    uint32_t inner = args->matrix1_cols;
+    uint32_t result_rows = args->result_rows;
+    uint32_t result_cols = args->result_cols;
+    // The result may be padded wider than the operands when the epilogue narrows it
+    uint32_t compute_rows = result_rows < args->matrix1_rows ? result_rows : args->matrix1_rows;
+    uint32_t compute_cols = result_cols < args->matrix2_rows ? result_cols : args->matrix2_rows;
+    int lut = args->gemm_variant == DPU_PIM_GEMM_LUT;
+
+    if (args->matrix1_cols != args->matrix2_cols) {
+        if (pid == 0) {
+            PIM_DPU_LOG_ERROR("Matrix dimensions incompatible for multiplication (matrix1_cols=%u != matrix2_cols=%u)",
+                              args->matrix1_cols, args->matrix2_cols);
+        }
+        return -1;
+    }
+
+    if (pid == 0) {
+        gemm_tiled_status = 0;
+        PIM_DPU_PERF_SAMPLE(epilogue_start);
+        if (pim_dpu_epilogue_load(&gemm_tiled_epilogue, args) != 0) {
+            gemm_tiled_status = -1;
+        }
+        PIM_DPU_PERF_ADD(mram_read_cycles, epilogue_start);
+        if (lut) {
+            PIM_DPU_PERF_SAMPLE(lut_start);
+            pim_dpu_gemm_lut_build();
+            PIM_DPU_PERF_ADD(compute_cycles, lut_start);
+        }
+    }
+    barrier_wait(&gemm_tiled_barrier);
+    if (gemm_tiled_status != 0) {
+        return -1;
+    }
+
+    pim_dpu_matrix1_t* rows_block = (pim_dpu_matrix1_t*)mem_alloc(PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_BLOCK_ELEMENTS * sizeof(pim_dpu_matrix1_t));
+    pim_dpu_matrix2_t* cols_block = (pim_dpu_matrix2_t*)mem_alloc(PIM_DPU_GEMM_TILE_COLS * PIM_DPU_GEMM_BLOCK_ELEMENTS * sizeof(pim_dpu_matrix2_t));
+    pim_dpu_accumulator_t* accumulators = (pim_dpu_accumulator_t*)mem_alloc(PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_TILE_COLS * sizeof(pim_dpu_accumulator_t));
+    uint8_t* tile_row = (uint8_t*)mem_alloc(PIM_DPU_GEMM_TILE_COLS * sizeof(pim_dpu_result_t));
+    if (rows_block == NULL || cols_block == NULL || accumulators == NULL || tile_row == NULL) {
+        PIM_DPU_LOG_ERROR("Failed to allocate WRAM for GEMM tile buffers");
+        return -1;
+    }
+    // Register blocks on the tile edge also read the segments past the valid rows and columns; their sums are dropped
+    for (uint32_t i = 0; i < PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_BLOCK_ELEMENTS; i++) {
+        rows_block[i] = 0;
+    }
+    for (uint32_t i = 0; i < PIM_DPU_GEMM_TILE_COLS * PIM_DPU_GEMM_BLOCK_ELEMENTS; i++) {
+        cols_block[i] = 0;
+    }
+
+    uint32_t row_tiles = (result_rows + PIM_DPU_TILE_ROWS - 1) / PIM_DPU_TILE_ROWS;
+    uint32_t col_tiles = (result_cols + PIM_DPU_GEMM_TILE_COLS - 1) / PIM_DPU_GEMM_TILE_COLS;
+    for (uint32_t tile_index = pid; tile_index < row_tiles * col_tiles; tile_index += NR_TASKLETS) {
+        pim_dpu_gemm_tile_t tile;
+        pim_dpu_gemm_tile_at(&tile, tile_index, result_rows, result_cols, compute_rows, compute_cols);
+
+        for (uint32_t i = 0; i < PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_TILE_COLS; i++) {
+            accumulators[i] = 0;
+        }
+        for (uint32_t block_start = 0; block_start < inner && tile.valid_rows > 0 && tile.valid_cols > 0;
+             block_start += PIM_DPU_GEMM_BLOCK_ELEMENTS) {
+            uint32_t block_elements = inner - block_start;
+            if (block_elements > PIM_DPU_GEMM_BLOCK_ELEMENTS) {
+                block_elements = PIM_DPU_GEMM_BLOCK_ELEMENTS;
+            }
+            PIM_DPU_PERF_SAMPLE(read_start);
+            pim_dpu_gemm_read_block(inputs1, inputs2, &tile, inner, block_start, block_elements, rows_block, cols_block);
+            PIM_DPU_PERF_ADD(mram_read_cycles, read_start);
+
+            PIM_DPU_PERF_SAMPLE(compute_start);
+            pim_dpu_gemm_compute_block(rows_block, cols_block, accumulators, &tile, block_elements, lut);
+            PIM_DPU_PERF_ADD(compute_cycles, compute_start);
+        }
+
+        PIM_DPU_PERF_SAMPLE(write_start);
+        pim_dpu_gemm_write_tile(&gemm_tiled_epilogue, outputs, accumulators, PIM_DPU_GEMM_TILE_COLS, tile_row, &tile, result_cols);
+        PIM_DPU_PERF_ADD(mram_write_cycles, write_start);
+    }
+    return 0;
+}
+
+#endif // __PIM_DPU_GEMM_TILED_KERNEL_H__
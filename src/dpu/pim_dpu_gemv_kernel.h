@@ -0,0 +1,99 @@
+#ifndef __PIM_DPU_GEMV_KERNEL_H__
+#define __PIM_DPU_GEMV_KERNEL_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <alloc.h>
+#include <barrier.h>
+#include <defs.h>
+#include <mram.h>
+
+#include "pim_dpu_kernel_config.h"
+#include "pim_dpu_log.h"
+#include "pim_dpu_perf.h"
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+BARRIER_INIT(gemv_barrier, NR_TASKLETS);
+
+static pim_dpu_matrix2_t* gemv_vector_wram;   // Vector shared by all tasklets, loaded once by tasklet 0
+static int32_t gemv_status;
+
+/**
+ * @brief Matrix-vector product of a row slice stored in MRAM
+ *
+ * The vector is read into WRAM once and shared by all tasklets. Rows are processed in groups of
+ * DPU_PIM_GEMV_ROWS_PER_WRITE distributed round-robin across tasklets; every row is streamed in blocks of
+ * PIM_DPU_GEMV_BLOCK_ELEMENTS elements so the matrix is read exactly once at full MRAM bandwidth.
+ * The host pads the row count to a multiple of DPU_PIM_GEMV_ROWS_PER_WRITE and every row and the vector to 8 bytes.
+ *
+ * @param matrix Pointer to matrix data in MRAM (row-major)
+ * @param vector Pointer to the vector in MRAM
+ * @param outputs Pointer to the result vector in MRAM
+ * @param rows Number of rows (multiple of DPU_PIM_GEMV_ROWS_PER_WRITE)
+ * @param cols Number of columns, including row padding
+ * @return 0 on success, -1 on failure
+ */
+int pim_dpu_gemv(__mram_ptr void* matrix, __mram_ptr void* vector, __mram_ptr void* outputs, uint32_t rows, uint32_t cols) {
+    uint32_t pid = me();
+
+    if (pid == 0) {
+        uint32_t vector_size = cols * sizeof(pim_dpu_matrix2_t);
+        gemv_status = 0;
+        gemv_vector_wram = vector_size <= DPU_PIM_GEMV_MAX_VECTOR_BYTES ? (pim_dpu_matrix2_t*)mem_alloc(vector_size) : NULL;
+        if (gemv_vector_wram == NULL) {
+            PIM_DPU_LOG_ERROR("GEMV vector of %u bytes does not fit WRAM", vector_size);
+            gemv_status = -1;
+        } else {
+            PIM_DPU_PERF_SAMPLE(read_start);
+            for (uint32_t offset = 0; offset < vector_size; offset += PIM_DPU_MRAM_DMA_MAX) {
+                uint32_t chunk = vector_size - offset < PIM_DPU_MRAM_DMA_MAX ? vector_size - offset : PIM_DPU_MRAM_DMA_MAX;
+                mram_read((__mram_ptr uint8_t*)vector + offset, (uint8_t*)gemv_vector_wram + offset, chunk);
+            }
+            PIM_DPU_PERF_ADD(mram_read_cycles, read_start);
+        }
+    }
+    barrier_wait(&gemv_barrier);
+    if (gemv_status != 0) {
+        return -1;
+    }
+
+    pim_dpu_matrix1_t* row_buffer = (pim_dpu_matrix1_t*)mem_alloc(PIM_DPU_GEMV_BLOCK_ELEMENTS * sizeof(pim_dpu_matrix1_t));
+    pim_dpu_result_t* result_buffer = (pim_dpu_result_t*)mem_alloc(DPU_PIM_GEMV_ROWS_PER_WRITE * sizeof(pim_dpu_result_t));
+    if (row_buffer == NULL || result_buffer == NULL) {
+        PIM_DPU_LOG_ERROR("Failed to allocate WRAM for GEMV buffers");
+        return -1;
+    }
+
+    uint32_t row_size = cols * sizeof(pim_dpu_matrix1_t);
+    for (uint32_t group_start = pid * DPU_PIM_GEMV_ROWS_PER_WRITE; group_start < rows;
+         group_start += NR_TASKLETS * DPU_PIM_GEMV_ROWS_PER_WRITE) {
+        for (uint32_t r = 0; r < DPU_PIM_GEMV_ROWS_PER_WRITE; r++) {
+            __mram_ptr uint8_t* row = (__mram_ptr uint8_t*)matrix + (group_start + r) * row_size;
+            pim_dpu_accumulator_t sum = 0;
+            for (uint32_t col_start = 0; col_start < cols; col_start += PIM_DPU_GEMV_BLOCK_ELEMENTS) {
+                uint32_t block_elements = cols - col_start;
+                if (block_elements > PIM_DPU_GEMV_BLOCK_ELEMENTS) {
+                    block_elements = PIM_DPU_GEMV_BLOCK_ELEMENTS;
+                }
+                PIM_DPU_PERF_SAMPLE(read_start);
+                mram_read(row + col_start * sizeof(pim_dpu_matrix1_t), row_buffer, block_elements * sizeof(pim_dpu_matrix1_t));
+                PIM_DPU_PERF_ADD(mram_read_cycles, read_start);
+                PIM_DPU_PERF_SAMPLE(compute_start);
+                pim_dpu_matrix2_t* vector_block = gemv_vector_wram + col_start;
+                for (uint32_t c = 0; c < block_elements; c++) {
+                    sum += (pim_dpu_accumulator_t)row_buffer[c] * vector_block[c];
+                }
+                PIM_DPU_PERF_ADD(compute_cycles, compute_start);
+            }
+            result_buffer[r] = (pim_dpu_result_t)sum;
+        }
+        PIM_DPU_PERF_SAMPLE(write_start);
+        mram_write(result_buffer, (__mram_ptr uint8_t*)outputs + group_start * sizeof(pim_dpu_result_t),
+                   DPU_PIM_GEMV_ROWS_PER_WRITE * sizeof(pim_dpu_result_t));
+        PIM_DPU_PERF_ADD(mram_write_cycles, write_start);
+    }
+    return 0;
+}
+
+#endif // __PIM_DPU_GEMV_KERNEL_H__
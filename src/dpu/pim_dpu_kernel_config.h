@@ -0,0 +1,291 @@
+#ifndef __PIM_DPU_KERNEL_CONFIG_H__
+#define __PIM_DPU_KERNEL_CONFIG_H__
+
+#include <stdint.h>
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+/**
+ * @brief Compile-time configuration of a DPU kernel variant.
+ * @details Every variant listed in defn/dpu_kernels.yaml is built with its own values of these macros
+ *          (see scripts/build_dpu_kernels.py). The defaults describe the original uint8 x uint8 -> uint16 kernel.
+ */
+
+#ifndef PIM_DPU_MATRIX1_TYPE
+#define PIM_DPU_MATRIX1_TYPE uint8_t   ///< Element type of the first matrix
+#endif
+
+#ifndef PIM_DPU_MATRIX2_TYPE
+#define PIM_DPU_MATRIX2_TYPE uint8_t   ///< Element type of the second matrix
+#endif
+
+#ifndef PIM_DPU_RESULT_TYPE
+#define PIM_DPU_RESULT_TYPE uint16_t   ///< Element type of the result matrix
+#endif
+
+#ifndef PIM_DPU_MATRIX1_DTYPE
+#define PIM_DPU_MATRIX1_DTYPE DPU_PIM_DTYPE_UINT8   ///< dpu_pim_dtype_t matching PIM_DPU_MATRIX1_TYPE
+#endif
+
+#ifndef PIM_DPU_MATRIX2_DTYPE
+#define PIM_DPU_MATRIX2_DTYPE DPU_PIM_DTYPE_UINT8   ///< dpu_pim_dtype_t matching PIM_DPU_MATRIX2_TYPE
+#endif
+
+#ifndef PIM_DPU_RESULT_DTYPE
+#define PIM_DPU_RESULT_DTYPE DPU_PIM_DTYPE_UINT16   ///< dpu_pim_dtype_t matching PIM_DPU_RESULT_TYPE
+#endif
+
+#ifndef PIM_DPU_ACCUMULATOR_TYPE
+#define PIM_DPU_ACCUMULATOR_TYPE uint32_t   ///< Type used to accumulate dot products (at least 32 bits)
+#endif
+
+#ifndef PIM_DPU_TILE_ROWS
+#define PIM_DPU_TILE_ROWS 8   ///< Rows of the output tile computed by a tasklet at a time
+#endif
+
+#ifndef PIM_DPU_TILE_COLS
+#define PIM_DPU_TILE_COLS 8   ///< Columns of the output tile computed by a tasklet at a time
+#endif
+
+#ifndef PIM_DPU_MICRO_ROWS
+#define PIM_DPU_MICRO_ROWS 2   ///< Rows of the register block computed per pass over the inner dimension
+#endif
+
+#ifndef PIM_DPU_MICRO_COLS
+#define PIM_DPU_MICRO_COLS 2   ///< Columns of the register block computed per pass over the inner dimension
+#endif
+
+// Values of dpu_pim_multiply_t, as macros so the micro-kernel can be chosen by the preprocessor
+#define PIM_DPU_MULTIPLY_C 0                ///< Multiply 8-bit operands as C integers
+#define PIM_DPU_MULTIPLY_BUILTIN 1          ///< Multiply 8-bit operands with the 8x8-bit multiply instructions, one byte at a time
+#define PIM_DPU_MULTIPLY_PACKED_BUILTIN 2   ///< Like BUILTIN, but the high byte of every 16-bit half is multiplied in place, saving its shift
+
+#ifndef PIM_DPU_MULTIPLY
+#define PIM_DPU_MULTIPLY PIM_DPU_MULTIPLY_C   ///< Multiplication used by the tiled GEMM micro-kernel for 8-bit operands
+#endif
+
+/**
+ * @brief WRAM budgets of the operations served by the multiplexed DPU program.
+ * @details Operations never run at the same time, so by default each one may use the whole heap left after the
+ *          tasklet stacks. Every operation is checked against a budget of its own, which a build may lower to
+ *          bound one operation without touching the others. Streaming operations size their per-tasklet buffers
+ *          from a block size in elements.
+ */
+
+#ifndef STACK_SIZE_DEFAULT
+#define STACK_SIZE_DEFAULT 1024
+#endif
+
+#define PIM_DPU_WRAM_SIZE (64 * 1024)                 ///< Total WRAM of a DPU
+#define PIM_DPU_WRAM_STATIC_RESERVE 4096              ///< WRAM kept for globals and the runtime
+#define PIM_DPU_MRAM_DMA_MAX 2048                     ///< Largest single MRAM<->WRAM transfer
+
+#define PIM_DPU_WRAM_HEAP_BUDGET (PIM_DPU_WRAM_SIZE - NR_TASKLETS * STACK_SIZE_DEFAULT - PIM_DPU_WRAM_STATIC_RESERVE)
+
+#ifndef PIM_DPU_GEMM_WRAM_BUDGET
+#define PIM_DPU_GEMM_WRAM_BUDGET PIM_DPU_WRAM_HEAP_BUDGET          ///< Heap bytes available to the GEMM operation and its layout conversion
+#endif
+#ifndef PIM_DPU_GEMV_WRAM_BUDGET
+#define PIM_DPU_GEMV_WRAM_BUDGET PIM_DPU_WRAM_HEAP_BUDGET          ///< Heap bytes available to the GEMV operation
+#endif
+#ifndef PIM_DPU_ELEMENTWISE_WRAM_BUDGET
+#define PIM_DPU_ELEMENTWISE_WRAM_BUDGET PIM_DPU_WRAM_HEAP_BUDGET   ///< Heap bytes available to the elementwise addition
+#endif
+#ifndef PIM_DPU_REDUCE_WRAM_BUDGET
+#define PIM_DPU_REDUCE_WRAM_BUDGET PIM_DPU_WRAM_HEAP_BUDGET        ///< Heap bytes available to the row reduction
+#endif
+
+#ifndef PIM_DPU_GEMV_BLOCK_ELEMENTS
+#define PIM_DPU_GEMV_BLOCK_ELEMENTS 256               ///< Matrix row elements streamed per block by GEMV
+#endif
+#define PIM_DPU_GEMV_WRAM_PER_TASKLET \
+    (PIM_DPU_GEMV_BLOCK_ELEMENTS * sizeof(PIM_DPU_MATRIX1_TYPE) + DPU_PIM_GEMV_ROWS_PER_WRITE * sizeof(PIM_DPU_RESULT_TYPE))
+/// Heap footprint of the GEMV operation: row blocks of every tasklet and the largest resident vector
+#define PIM_DPU_GEMV_WRAM (NR_TASKLETS * PIM_DPU_GEMV_WRAM_PER_TASKLET + DPU_PIM_GEMV_MAX_VECTOR_BYTES)
+
+#ifndef PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS
+#define PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS 64         ///< Elements streamed per block by the elementwise addition
+#endif
+#define PIM_DPU_ELEMENTWISE_WRAM_PER_TASKLET \
+    (PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS * (sizeof(PIM_DPU_MATRIX1_TYPE) + sizeof(PIM_DPU_MATRIX2_TYPE) + sizeof(PIM_DPU_RESULT_TYPE)))
+#define PIM_DPU_ELEMENTWISE_WRAM (NR_TASKLETS * PIM_DPU_ELEMENTWISE_WRAM_PER_TASKLET)
+
+#ifndef PIM_DPU_REDUCE_BLOCK_ELEMENTS
+#define PIM_DPU_REDUCE_BLOCK_ELEMENTS 128             ///< Row elements streamed per block by the row reduction
+#endif
+#define PIM_DPU_REDUCE_WRAM_PER_TASKLET \
+    (PIM_DPU_REDUCE_BLOCK_ELEMENTS * sizeof(PIM_DPU_MATRIX1_TYPE) + DPU_PIM_REDUCE_ROWS_PER_WRITE * sizeof(PIM_DPU_RESULT_TYPE))
+#define PIM_DPU_REDUCE_WRAM (NR_TASKLETS * PIM_DPU_REDUCE_WRAM_PER_TASKLET)
+
+/// Narrowest element written back by a GEMM: int8 when a 32-bit result may be requantised
+#define PIM_DPU_GEMM_MIN_OUTPUT_SIZE (sizeof(PIM_DPU_RESULT_TYPE) == sizeof(int32_t) ? sizeof(int8_t) : sizeof(PIM_DPU_RESULT_TYPE))
+/// Output tile columns of the tiled GEMM, rounded up so every tile row is written back as a multiple of 8 bytes
+#define PIM_DPU_GEMM_TILE_COLS \
+    ((PIM_DPU_TILE_COLS + 8 / PIM_DPU_GEMM_MIN_OUTPUT_SIZE - 1) / (8 / PIM_DPU_GEMM_MIN_OUTPUT_SIZE) * (8 / PIM_DPU_GEMM_MIN_OUTPUT_SIZE))
+/// Accumulator tile and one requantised tile row, kept by every tasklet computing an output tile
+#define PIM_DPU_GEMM_TILE_WRAM \
+    (PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_TILE_COLS * sizeof(PIM_DPU_ACCUMULATOR_TYPE) + PIM_DPU_GEMM_TILE_COLS * sizeof(PIM_DPU_RESULT_TYPE))
+
+#ifndef PIM_DPU_PIPELINE_FETCH_TASKLETS
+#define PIM_DPU_PIPELINE_FETCH_TASKLETS (NR_TASKLETS / 2)   ///< Tasklets of the pipelined GEMM that only fetch operand blocks
+#endif
+#define PIM_DPU_PIPELINE_COMPUTE_TASKLETS (NR_TASKLETS - PIM_DPU_PIPELINE_FETCH_TASKLETS)
+
+#ifndef PIM_DPU_TMM_PANEL_ROWS
+#define PIM_DPU_TMM_PANEL_ROWS 16                     ///< Result rows of the panel cached by the thread memory manager
+#endif
+#ifndef PIM_DPU_TMM_PANEL_COLS
+#define PIM_DPU_TMM_PANEL_COLS 16                     ///< Result columns of the panel cached by the thread memory manager
+#endif
+#define PIM_DPU_TMM_WRAM_PER_TASKLET (PIM_DPU_TMM_PANEL_COLS * sizeof(PIM_DPU_RESULT_TYPE))
+
+/**
+ * @brief Compile-time WRAM planner of the GEMM variants.
+ * @details The heap footprint of every GEMM variant is a function of the inner-dimension block streamed from MRAM.
+ *          The planner picks the largest block, from 256 elements down to 8, with which all variants fit the heap
+ *          left by NR_TASKLETS stacks of STACK_SIZE_DEFAULT bytes; defining PIM_DPU_GEMM_BLOCK_ELEMENTS bypasses it.
+ *          The plan is published to the host in the `KERNEL_PLAN` symbol of the binary.
+ */
+
+/// Tiled GEMM: a block of the tile's rows and one of its columns, plus the tile, for every tasklet
+#define PIM_DPU_GEMM_TILED_WRAM(block) \
+    (NR_TASKLETS * ((block) * (PIM_DPU_TILE_ROWS * sizeof(PIM_DPU_MATRIX1_TYPE) + PIM_DPU_GEMM_TILE_COLS * sizeof(PIM_DPU_MATRIX2_TYPE)) + \
+                    PIM_DPU_GEMM_TILE_WRAM))
+/// Pipelined GEMM: two operand buffers and the tile for every compute tasklet (none without fetch tasklets, which run the tiled GEMM)
+#define PIM_DPU_GEMM_PIPELINED_WRAM(block) \
+    (PIM_DPU_PIPELINE_FETCH_TASKLETS == 0 ? 0 : \
+     PIM_DPU_PIPELINE_COMPUTE_TASKLETS * \
+         (2 * (block) * (PIM_DPU_TILE_ROWS * sizeof(PIM_DPU_MATRIX1_TYPE) + PIM_DPU_GEMM_TILE_COLS * sizeof(PIM_DPU_MATRIX2_TYPE)) + \
+          PIM_DPU_GEMM_TILE_WRAM))
+/// Thread memory manager: shared row and column segment slots and panel accumulators, one panel row per tasklet
+#define PIM_DPU_GEMM_TMM_WRAM(block) \
+    ((block) * (PIM_DPU_TMM_PANEL_ROWS * sizeof(PIM_DPU_MATRIX1_TYPE) + PIM_DPU_TMM_PANEL_COLS * sizeof(PIM_DPU_MATRIX2_TYPE)) + \
+     PIM_DPU_TMM_PANEL_ROWS * PIM_DPU_TMM_PANEL_COLS * sizeof(PIM_DPU_ACCUMULATOR_TYPE) + NR_TASKLETS * PIM_DPU_TMM_WRAM_PER_TASKLET)
+#define PIM_DPU_GEMM_MAX(a, b) ((a) > (b) ? (a) : (b))
+/// Largest heap footprint of the GEMM variants for a block
+#define PIM_DPU_GEMM_WRAM(block) \
+    PIM_DPU_GEMM_MAX(PIM_DPU_GEMM_TILED_WRAM(block), PIM_DPU_GEMM_MAX(PIM_DPU_GEMM_PIPELINED_WRAM(block), PIM_DPU_GEMM_TMM_WRAM(block)))
+/// Whether a block fits single MRAM transfers and the heap with every GEMM variant
+#define PIM_DPU_GEMM_BLOCK_FITS(block)                                                                                  \
+    ((block) * sizeof(PIM_DPU_MATRIX1_TYPE) <= PIM_DPU_MRAM_DMA_MAX && (block) * sizeof(PIM_DPU_MATRIX2_TYPE) <= PIM_DPU_MRAM_DMA_MAX && \
+     PIM_DPU_GEMM_WRAM(block) <= PIM_DPU_GEMM_WRAM_BUDGET)
+/// Largest fitting block, 0 when not even 8 elements fit
+#define PIM_DPU_GEMM_PLAN_BLOCK_ELEMENTS                                                                                \
+    (PIM_DPU_GEMM_BLOCK_FITS(256) ? 256 : PIM_DPU_GEMM_BLOCK_FITS(128) ? 128 : PIM_DPU_GEMM_BLOCK_FITS(64) ? 64 : \
+     PIM_DPU_GEMM_BLOCK_FITS(32) ? 32 : PIM_DPU_GEMM_BLOCK_FITS(16) ? 16 : PIM_DPU_GEMM_BLOCK_FITS(8) ? 8 : 0)
+
+#ifndef PIM_DPU_GEMM_BLOCK_ELEMENTS
+#define PIM_DPU_GEMM_BLOCK_ELEMENTS PIM_DPU_GEMM_PLAN_BLOCK_ELEMENTS   ///< Inner-dimension elements streamed per block by the GEMM variants
+#endif
+#define PIM_DPU_GEMM_WRAM_PER_TASKLET \
+    (PIM_DPU_GEMM_BLOCK_ELEMENTS * (PIM_DPU_TILE_ROWS * sizeof(PIM_DPU_MATRIX1_TYPE) + PIM_DPU_GEMM_TILE_COLS * sizeof(PIM_DPU_MATRIX2_TYPE)) + \
+     PIM_DPU_GEMM_TILE_WRAM)
+/// One operand buffer of a compute tasklet of the pipelined GEMM: a block of the tile's rows and one of its columns
+#define PIM_DPU_PIPELINE_BUFFER_BYTES \
+    (PIM_DPU_GEMM_BLOCK_ELEMENTS * (PIM_DPU_TILE_ROWS * sizeof(PIM_DPU_MATRIX1_TYPE) + PIM_DPU_GEMM_TILE_COLS * sizeof(PIM_DPU_MATRIX2_TYPE)))
+#define PIM_DPU_PIPELINE_WRAM_PER_TASKLET (2 * PIM_DPU_PIPELINE_BUFFER_BYTES + PIM_DPU_GEMM_TILE_WRAM)
+/// Shared WRAM of the thread memory manager: row and column segment slots and the panel accumulators
+#define PIM_DPU_TMM_WRAM_SHARED (PIM_DPU_GEMM_TMM_WRAM(PIM_DPU_GEMM_BLOCK_ELEMENTS) - NR_TASKLETS * PIM_DPU_TMM_WRAM_PER_TASKLET)
+
+#ifndef PIM_DPU_GEMM_OUTER_BLOCK_ROWS
+#define PIM_DPU_GEMM_OUTER_BLOCK_ROWS 16              ///< Second-matrix rows streamed per panel by the outer-product GEMM
+#endif
+/// Outer-product GEMM, per tasklet: a block of the band's first-matrix rows, the band accumulators and one result row
+#define PIM_DPU_GEMM_OUTER_WRAM_PER_TASKLET(cols)                                                              \
+    (PIM_DPU_TILE_ROWS * PIM_DPU_GEMM_OUTER_BLOCK_ROWS * sizeof(PIM_DPU_MATRIX1_TYPE) +                        \
+     PIM_DPU_TILE_ROWS * (cols) * sizeof(PIM_DPU_ACCUMULATOR_TYPE) + (cols) * sizeof(PIM_DPU_RESULT_TYPE))
+/// Outer-product GEMM: the panel of second-matrix rows shared by all tasklets, plus the WRAM of every tasklet
+#define PIM_DPU_GEMM_OUTER_WRAM(cols) \
+    (PIM_DPU_GEMM_OUTER_BLOCK_ROWS * (cols) * sizeof(PIM_DPU_MATRIX2_TYPE) + NR_TASKLETS * PIM_DPU_GEMM_OUTER_WRAM_PER_TASKLET(cols))
+/// Whether result bands of `cols` columns fit the heap and write back one row per MRAM transfer
+#define PIM_DPU_GEMM_OUTER_COLS_FIT(cols) \
+    ((cols) * sizeof(PIM_DPU_RESULT_TYPE) <= PIM_DPU_MRAM_DMA_MAX && PIM_DPU_GEMM_OUTER_WRAM(cols) <= PIM_DPU_GEMM_WRAM_BUDGET)
+#ifndef PIM_DPU_GEMM_OUTER_COLS
+/// Widest result band of the outer-product GEMM, from 512 columns down to 8; 0 when not even 8 fit
+#define PIM_DPU_GEMM_OUTER_COLS                                                                                    \
+    (PIM_DPU_GEMM_OUTER_COLS_FIT(512) ? 512 : PIM_DPU_GEMM_OUTER_COLS_FIT(256) ? 256 : PIM_DPU_GEMM_OUTER_COLS_FIT(128) ? 128 : \
+     PIM_DPU_GEMM_OUTER_COLS_FIT(64) ? 64 : PIM_DPU_GEMM_OUTER_COLS_FIT(32) ? 32 : PIM_DPU_GEMM_OUTER_COLS_FIT(16) ? 16 :     \
+     PIM_DPU_GEMM_OUTER_COLS_FIT(8) ? 8 : 0)
+#endif
+
+/// Transpose of a row-major second matrix: an input and an output tile of side `bytes` / element size per tasklet
+#define PIM_DPU_TRANSPOSE_WRAM(bytes) (NR_TASKLETS * 2 * ((bytes) / sizeof(PIM_DPU_MATRIX2_TYPE)) * (bytes))
+#ifndef PIM_DPU_TRANSPOSE_TILE_BYTES
+/// Bytes of a tile row of the transpose: the widest of 64, 32, 16 and 8 whose tiles fit the heap
+#define PIM_DPU_TRANSPOSE_TILE_BYTES                                                                              \
+    (PIM_DPU_TRANSPOSE_WRAM(64) <= PIM_DPU_WRAM_HEAP_BUDGET ? 64 : PIM_DPU_TRANSPOSE_WRAM(32) <= PIM_DPU_WRAM_HEAP_BUDGET ? 32 : \
+     PIM_DPU_TRANSPOSE_WRAM(16) <= PIM_DPU_WRAM_HEAP_BUDGET ? 16 : 8)
+#endif
+#define PIM_DPU_TRANSPOSE_TILE_ELEMENTS (PIM_DPU_TRANSPOSE_TILE_BYTES / sizeof(PIM_DPU_MATRIX2_TYPE))
+#define PIM_DPU_TRANSPOSE_WRAM_PER_TASKLET (2 * PIM_DPU_TRANSPOSE_TILE_ELEMENTS * PIM_DPU_TRANSPOSE_TILE_BYTES)
+
+_Static_assert(PIM_DPU_GEMV_BLOCK_ELEMENTS % 8 == 0 &&
+               PIM_DPU_GEMV_BLOCK_ELEMENTS * sizeof(PIM_DPU_MATRIX1_TYPE) <= PIM_DPU_MRAM_DMA_MAX,
+               "GEMV block must be a multiple of 8 elements and fit a single MRAM transfer");
+_Static_assert(PIM_DPU_GEMM_BLOCK_ELEMENTS > 0,
+               "No GEMM block fits the WRAM heap: reduce the tile size, the number of tasklets or the stack size");
+_Static_assert(PIM_DPU_GEMM_BLOCK_ELEMENTS % 8 == 0 &&
+               PIM_DPU_GEMM_BLOCK_ELEMENTS * sizeof(PIM_DPU_MATRIX1_TYPE) <= PIM_DPU_MRAM_DMA_MAX &&
+               PIM_DPU_GEMM_BLOCK_ELEMENTS * sizeof(PIM_DPU_MATRIX2_TYPE) <= PIM_DPU_MRAM_DMA_MAX,
+               "GEMM block must be a multiple of 8 elements and fit a single MRAM transfer");
+_Static_assert(PIM_DPU_TILE_ROWS > 0 && PIM_DPU_GEMM_TILE_COLS * sizeof(PIM_DPU_RESULT_TYPE) <= PIM_DPU_MRAM_DMA_MAX,
+               "GEMM tile row must fit a single MRAM transfer");
+_Static_assert(PIM_DPU_MICRO_ROWS > 0 && PIM_DPU_MICRO_COLS > 0 &&
+               PIM_DPU_TILE_ROWS % PIM_DPU_MICRO_ROWS == 0 && PIM_DPU_GEMM_TILE_COLS % PIM_DPU_MICRO_COLS == 0,
+               "GEMM register block must divide the output tile");
+_Static_assert(PIM_DPU_MULTIPLY == PIM_DPU_MULTIPLY_C ||
+               ((PIM_DPU_MULTIPLY == PIM_DPU_MULTIPLY_BUILTIN || PIM_DPU_MULTIPLY == PIM_DPU_MULTIPLY_PACKED_BUILTIN) &&
+                sizeof(PIM_DPU_MATRIX1_TYPE) == 1 && sizeof(PIM_DPU_MATRIX2_TYPE) == 1),
+               "8x8-bit multiplies need 8-bit operands");
+_Static_assert(PIM_DPU_MULTIPLY_C == DPU_PIM_MULTIPLY_C && PIM_DPU_MULTIPLY_BUILTIN == DPU_PIM_MULTIPLY_BUILTIN &&
+               PIM_DPU_MULTIPLY_PACKED_BUILTIN == DPU_PIM_MULTIPLY_PACKED_BUILTIN,
+               "Multiplication macros must match dpu_pim_multiply_t");
+_Static_assert(NR_TASKLETS * PIM_DPU_GEMM_WRAM_PER_TASKLET <= PIM_DPU_GEMM_WRAM_BUDGET,
+               "Tiled GEMM WRAM budget (operand blocks, accumulator tile and tile row) exceeds the heap");
+_Static_assert(PIM_DPU_PIPELINE_FETCH_TASKLETS >= 0 && PIM_DPU_PIPELINE_FETCH_TASKLETS < NR_TASKLETS,
+               "Pipelined GEMM needs at least one compute tasklet");
+_Static_assert(PIM_DPU_GEMM_PIPELINED_WRAM(PIM_DPU_GEMM_BLOCK_ELEMENTS) <= PIM_DPU_GEMM_WRAM_BUDGET,
+               "Pipelined GEMM WRAM budget (two operand buffers, accumulator tile and tile row per compute tasklet) exceeds the heap");
+_Static_assert(PIM_DPU_GEMM_OUTER_BLOCK_ROWS % 8 == 0 &&
+               PIM_DPU_GEMM_OUTER_BLOCK_ROWS * sizeof(PIM_DPU_MATRIX1_TYPE) <= PIM_DPU_MRAM_DMA_MAX,
+               "Outer-product GEMM panel must be a multiple of 8 rows and fit a single MRAM transfer per first-matrix row");
+_Static_assert(PIM_DPU_GEMM_OUTER_COLS % PIM_DPU_MICRO_COLS == 0 &&
+               (PIM_DPU_GEMM_OUTER_COLS == 0 || PIM_DPU_GEMM_OUTER_COLS_FIT(PIM_DPU_GEMM_OUTER_COLS)),
+               "Outer-product GEMM band must be a multiple of the register block and fit the heap");
+_Static_assert(PIM_DPU_TMM_PANEL_ROWS > 0 && PIM_DPU_TMM_PANEL_COLS % 8 == 0 &&
+               PIM_DPU_TMM_PANEL_COLS * sizeof(PIM_DPU_RESULT_TYPE) <= PIM_DPU_MRAM_DMA_MAX,
+               "Thread memory manager panel rows must be a multiple of 8 elements and fit a single MRAM transfer");
+_Static_assert(PIM_DPU_TMM_WRAM_SHARED + NR_TASKLETS * PIM_DPU_TMM_WRAM_PER_TASKLET <= PIM_DPU_GEMM_WRAM_BUDGET,
+               "Thread memory manager WRAM budget (segment slots, panel and panel rows) exceeds the heap");
+_Static_assert(PIM_DPU_GEMM_WRAM_BUDGET <= PIM_DPU_WRAM_HEAP_BUDGET && PIM_DPU_GEMV_WRAM_BUDGET <= PIM_DPU_WRAM_HEAP_BUDGET &&
+               PIM_DPU_ELEMENTWISE_WRAM_BUDGET <= PIM_DPU_WRAM_HEAP_BUDGET && PIM_DPU_REDUCE_WRAM_BUDGET <= PIM_DPU_WRAM_HEAP_BUDGET,
+               "Operation WRAM budgets must fit the heap");
+_Static_assert(PIM_DPU_GEMV_WRAM <= PIM_DPU_GEMV_WRAM_BUDGET,
+               "GEMV WRAM footprint (row blocks and resident vector) exceeds its budget");
+_Static_assert(PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS % 8 == 0 &&
+               PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS * sizeof(PIM_DPU_MATRIX1_TYPE) <= PIM_DPU_MRAM_DMA_MAX &&
+               PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS * sizeof(PIM_DPU_MATRIX2_TYPE) <= PIM_DPU_MRAM_DMA_MAX &&
+               PIM_DPU_ELEMENTWISE_BLOCK_ELEMENTS * sizeof(PIM_DPU_RESULT_TYPE) <= PIM_DPU_MRAM_DMA_MAX,
+               "Elementwise block must be a multiple of 8 elements and fit a single MRAM transfer");
+_Static_assert(PIM_DPU_ELEMENTWISE_WRAM <= PIM_DPU_ELEMENTWISE_WRAM_BUDGET,
+               "Elementwise WRAM footprint (operand and result blocks) exceeds its budget");
+_Static_assert(PIM_DPU_REDUCE_BLOCK_ELEMENTS % 8 == 0 && PIM_DPU_REDUCE_BLOCK_ELEMENTS * sizeof(PIM_DPU_MATRIX1_TYPE) <= PIM_DPU_MRAM_DMA_MAX,
+               "Row reduction block must be a multiple of 8 elements and fit a single MRAM transfer");
+_Static_assert(PIM_DPU_REDUCE_WRAM <= PIM_DPU_REDUCE_WRAM_BUDGET,
+               "Row reduction WRAM footprint (row blocks and result group) exceeds its budget");
+_Static_assert(PIM_DPU_TRANSPOSE_TILE_BYTES % 8 == 0 && PIM_DPU_TRANSPOSE_TILE_BYTES % sizeof(PIM_DPU_MATRIX2_TYPE) == 0 &&
+               NR_TASKLETS * PIM_DPU_TRANSPOSE_WRAM_PER_TASKLET <= PIM_DPU_GEMM_WRAM_BUDGET,
+               "Transpose tiles must have rows of whole 8-byte transfers and fit the GEMM budget");
+
+typedef PIM_DPU_MATRIX1_TYPE pim_dpu_matrix1_t;
+typedef PIM_DPU_MATRIX2_TYPE pim_dpu_matrix2_t;
+typedef PIM_DPU_RESULT_TYPE pim_dpu_result_t;
+typedef PIM_DPU_ACCUMULATOR_TYPE pim_dpu_accumulator_t;
+
+#define PIM_DPU_MATRIX1_SIGNED ((pim_dpu_matrix1_t)-1 < 0)   ///< Whether first matrix elements are signed
+#define PIM_DPU_MATRIX2_SIGNED ((pim_dpu_matrix2_t)-1 < 0)   ///< Whether second matrix elements are signed
+
+_Static_assert(sizeof(pim_dpu_accumulator_t) >= sizeof(int32_t) && sizeof(pim_dpu_accumulator_t) >= sizeof(pim_dpu_result_t),
+               "Accumulator must be at least 32 bits and as wide as the result");
+
+#endif // __PIM_DPU_KERNEL_CONFIG_H__
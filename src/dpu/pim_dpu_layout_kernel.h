@@ -0,0 +1,93 @@
+#ifndef __PIM_DPU_LAYOUT_KERNEL_H__
+#define __PIM_DPU_LAYOUT_KERNEL_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <alloc.h>
+#include <barrier.h>
+#include <defs.h>
+#include <mram.h>
+
+#include "pim_dpu_kernel_config.h"
+#include "pim_dpu_log.h"
+#include "pim_dpu_perf.h"
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+BARRIER_INIT(layout_barrier, NR_TASKLETS);
+
+static int32_t layout_status;
+static pim_dpu_matrix2_t* layout_wram;   // Input and output tile of every tasklet
+
+/**
+ * @brief Convert the row-major second matrix slice into the column-major layout read by the GEMM kernels
+ *
+ * The slice is cut into square tiles of PIM_DPU_TRANSPOSE_TILE_ELEMENTS, distributed round-robin across tasklets. A
+ * tasklet reads the rows of a tile, transposes it in WRAM and writes it back as column segments. Both layouts are
+ * padded so that every row and column is a multiple of 8 bytes, so edge tiles are transferred whole. The heap is
+ * reset afterwards, so the GEMM that follows has all of WRAM.
+ *
+ * @param row_major Pointer to the slice in MRAM (row-major, rows x cols)
+ * @param column_major Pointer to the destination in MRAM (column-major, cols columns of rows)
+ * @param rows Rows of the slice: the inner dimension, padded
+ * @param cols Columns of the slice, padded
+ * @return 0 on success, -1 on failure
+ */
+int pim_dpu_transpose_matrix2(__mram_ptr void* row_major, __mram_ptr void* column_major, uint32_t rows, uint32_t cols) {
+    uint32_t pid = me();
+    if (pid == 0) {
+        layout_status = 0;
+        layout_wram = (pim_dpu_matrix2_t*)mem_alloc(NR_TASKLETS * PIM_DPU_TRANSPOSE_WRAM_PER_TASKLET);
+        if (layout_wram == NULL) {
+            PIM_DPU_LOG_ERROR("Failed to allocate WRAM for the second matrix transpose");
+            layout_status = -1;
+        }
+    }
+    barrier_wait(&layout_barrier);
+    if (layout_status != 0) {
+        return -1;
+    }
+
+    pim_dpu_matrix2_t* tile_in = layout_wram + pid * 2 * PIM_DPU_TRANSPOSE_TILE_ELEMENTS * PIM_DPU_TRANSPOSE_TILE_ELEMENTS;
+    pim_dpu_matrix2_t* tile_out = tile_in + PIM_DPU_TRANSPOSE_TILE_ELEMENTS * PIM_DPU_TRANSPOSE_TILE_ELEMENTS;
+    uint32_t row_tiles = (rows + PIM_DPU_TRANSPOSE_TILE_ELEMENTS - 1) / PIM_DPU_TRANSPOSE_TILE_ELEMENTS;
+    uint32_t col_tiles = (cols + PIM_DPU_TRANSPOSE_TILE_ELEMENTS - 1) / PIM_DPU_TRANSPOSE_TILE_ELEMENTS;
+    for (uint32_t tile_index = pid; tile_index < row_tiles * col_tiles; tile_index += NR_TASKLETS) {
+        uint32_t row_start = (tile_index / col_tiles) * PIM_DPU_TRANSPOSE_TILE_ELEMENTS;
+        uint32_t col_start = (tile_index % col_tiles) * PIM_DPU_TRANSPOSE_TILE_ELEMENTS;
+        uint32_t tile_rows = rows - row_start < PIM_DPU_TRANSPOSE_TILE_ELEMENTS ? rows - row_start : PIM_DPU_TRANSPOSE_TILE_ELEMENTS;
+        uint32_t tile_cols = cols - col_start < PIM_DPU_TRANSPOSE_TILE_ELEMENTS ? cols - col_start : PIM_DPU_TRANSPOSE_TILE_ELEMENTS;
+
+        PIM_DPU_PERF_SAMPLE(read_start);
+        for (uint32_t r = 0; r < tile_rows; r++) {
+            mram_read((__mram_ptr pim_dpu_matrix2_t*)row_major + (row_start + r) * cols + col_start,
+                      tile_in + r * PIM_DPU_TRANSPOSE_TILE_ELEMENTS, tile_cols * sizeof(pim_dpu_matrix2_t));
+        }
+        PIM_DPU_PERF_ADD(mram_read_cycles, read_start);
+
+        PIM_DPU_PERF_SAMPLE(compute_start);
+        for (uint32_t r = 0; r < tile_rows; r++) {
+            for (uint32_t c = 0; c < tile_cols; c++) {
+                tile_out[c * PIM_DPU_TRANSPOSE_TILE_ELEMENTS + r] = tile_in[r * PIM_DPU_TRANSPOSE_TILE_ELEMENTS + c];
+            }
+        }
+        PIM_DPU_PERF_ADD(compute_cycles, compute_start);
+
+        PIM_DPU_PERF_SAMPLE(write_start);
+        for (uint32_t c = 0; c < tile_cols; c++) {
+            mram_write(tile_out + c * PIM_DPU_TRANSPOSE_TILE_ELEMENTS,
+                       (__mram_ptr pim_dpu_matrix2_t*)column_major + (col_start + c) * rows + row_start, tile_rows * sizeof(pim_dpu_matrix2_t));
+        }
+        PIM_DPU_PERF_ADD(mram_write_cycles, write_start);
+    }
+
+    // Every tile is written before the GEMM reads the slice, and the transpose buffers are released for it
+    barrier_wait(&layout_barrier);
+    if (pid == 0) {
+        mem_reset();
+    }
+    barrier_wait(&layout_barrier);
+    return 0;
+}
+
+#endif // __PIM_DPU_LAYOUT_KERNEL_H__
@@ -0,0 +1,50 @@
+#ifndef __PIM_DPU_LOG_H__
+#define __PIM_DPU_LOG_H__
+
+#include <stdio.h>
+#include <defs.h>
+
+#include "pim_log.h"
+
+/**
+ * @brief Leveled logging of the DPU program
+ *
+ * Uses the levels and PIM_LOG_LEVEL of pim_log.h; calls below the level expand to nothing. Messages go to the DPU
+ * log buffer, which the host forwards to stderr after every launch at PIM_LOG_LEVEL_DEBUG and above, as
+ * `pim level=debug tasklet=3 fn=function msg="..."` lines.
+ */
+
+#define PIM_DPU_LOG_WRITE(level_name, fmt, ...) \
+    printf("pim level=" level_name " tasklet=%u fn=%s msg=\"" fmt "\"\n", me(), __func__, ##__VA_ARGS__)
+
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_ERROR
+#define PIM_DPU_LOG_ERROR(fmt, ...) PIM_DPU_LOG_WRITE("error", fmt, ##__VA_ARGS__)
+#else
+#define PIM_DPU_LOG_ERROR(fmt, ...) ((void)0)
+#endif
+
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_WARN
+#define PIM_DPU_LOG_WARN(fmt, ...) PIM_DPU_LOG_WRITE("warn", fmt, ##__VA_ARGS__)
+#else
+#define PIM_DPU_LOG_WARN(fmt, ...) ((void)0)
+#endif
+
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_INFO
+#define PIM_DPU_LOG_INFO(fmt, ...) PIM_DPU_LOG_WRITE("info", fmt, ##__VA_ARGS__)
+#else
+#define PIM_DPU_LOG_INFO(fmt, ...) ((void)0)
+#endif
+
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_DEBUG
+#define PIM_DPU_LOG_DEBUG(fmt, ...) PIM_DPU_LOG_WRITE("debug", fmt, ##__VA_ARGS__)
+#else
+#define PIM_DPU_LOG_DEBUG(fmt, ...) ((void)0)
+#endif
+
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_TRACE
+#define PIM_DPU_LOG_TRACE(fmt, ...) PIM_DPU_LOG_WRITE("trace", fmt, ##__VA_ARGS__)
+#else
+#define PIM_DPU_LOG_TRACE(fmt, ...) ((void)0)
+#endif
+
+#endif // __PIM_DPU_LOG_H__
@@ -6,31 +6,88 @@
 #include <defs.h>
 #include <barrier.h>
 
+#include "pim_dpu_kernel_config.h"
+
+#include "pim_dpu_perf.h"
+
+#include "pim_dpu_log.h"
+
 #include "pim_dpu_matrix_multiply_thread_memory_manager.h"
 
+#include "pim_dpu_epilogue.h"
+
+#include "pim_dpu_gemv_kernel.h"
+#include "pim_dpu_elementwise_kernels.h"
+
+#include "pim_dpu_gemm_tiled_kernel.h"
+#include "pim_dpu_gemm_pipelined_kernel.h"
+#include "pim_dpu_gemm_outer_kernel.h"
+#include "pim_dpu_layout_kernel.h"
+
+#include "pim_dpu_mram.h"
+
 #include "dpu_pim_matrix_multiply_kernel_arguments.h"
 
 
 __host dpu_pim_matrix_multiply_kernel_arguments_t MATRIX_MULTIPLY_ARGUMENTS;
+
+/// WRAM plan the program is built with, read by the host when it loads the binary; never written
+__host dpu_pim_kernel_plan_t KERNEL_PLAN = {
+    .matrix1_dtype = PIM_DPU_MATRIX1_DTYPE,
+    .matrix2_dtype = PIM_DPU_MATRIX2_DTYPE,
+    .result_dtype = PIM_DPU_RESULT_DTYPE,
+    .nr_tasklets = NR_TASKLETS,
+    .stack_size = STACK_SIZE_DEFAULT,
+    .wram_heap_budget = PIM_DPU_WRAM_HEAP_BUDGET,
+    .tile_rows = PIM_DPU_TILE_ROWS,
+    .tile_cols = PIM_DPU_GEMM_TILE_COLS,
+    .micro_rows = PIM_DPU_MICRO_ROWS,
+    .micro_cols = PIM_DPU_MICRO_COLS,
+    .multiply = PIM_DPU_MULTIPLY,
+    .gemm_block_elements = PIM_DPU_GEMM_BLOCK_ELEMENTS,
+    .fetch_tasklets = PIM_DPU_PIPELINE_FETCH_TASKLETS,
+    .gemm_wram_bytes = PIM_DPU_GEMM_WRAM(PIM_DPU_GEMM_BLOCK_ELEMENTS),
+    .gemm_outer_cols = PIM_DPU_GEMM_OUTER_COLS,
+    .gemm_outer_block_rows = PIM_DPU_GEMM_OUTER_BLOCK_ROWS,
+    .gemv_wram_bytes = PIM_DPU_GEMV_WRAM,
+    .elementwise_wram_bytes = PIM_DPU_ELEMENTWISE_WRAM,
+    .reduce_wram_bytes = PIM_DPU_REDUCE_WRAM,
+};
+/// Status of the last launch, read back by the host: 0 when every tasklet succeeded, -1 when any of them failed
+__host int32_t KERNEL_STATUS;
 __dma_aligned void* aux;
 
 BARRIER_INIT(my_barrier, NR_TASKLETS);
 
+static int32_t naive_status;   // Status of tasklet 0 in the naive GEMM, shared after the barrier
+
 /**
- * @brief Main DPU function for matrix multiplication
- * 
- * This function is executed on each DPU and coordinates tasklets to perform
- * parallel matrix multiplication using the memory manager.
+ * @brief Check the element types requested by the host against the ones the kernel variant is built for
+ *
+ * The element types are fixed when the kernel variant is built; the host selects the variant by type.
  */
-int main() {
-    int pid = me();
-    
-    // Initialize memory heap on tasklet 0
-    if (pid == 0) {
-        mem_reset(); // Reset the heap
+static int pim_dpu_check_dtypes(int pid) {
+    if (MATRIX_MULTIPLY_ARGUMENTS.matrix1_dtype != PIM_DPU_MATRIX1_DTYPE ||
+        MATRIX_MULTIPLY_ARGUMENTS.matrix2_dtype != PIM_DPU_MATRIX2_DTYPE ||
+        MATRIX_MULTIPLY_ARGUMENTS.result_dtype != PIM_DPU_RESULT_DTYPE) {
+        if (pid == 0) {
+            PIM_DPU_LOG_ERROR("Kernel built for dtypes %u x %u -> %u, got %u x %u -> %u",
+                              PIM_DPU_MATRIX1_DTYPE, PIM_DPU_MATRIX2_DTYPE, PIM_DPU_RESULT_DTYPE,
+                              MATRIX_MULTIPLY_ARGUMENTS.matrix1_dtype, MATRIX_MULTIPLY_ARGUMENTS.matrix2_dtype,
+                              MATRIX_MULTIPLY_ARGUMENTS.result_dtype);
+        }
+        return -1;
     }
-    barrier_wait(&my_barrier);
-    
+    return 0;
+}
+
+/**
+ * @brief Multiplication of the naive GEMM variant, run by tasklet 0 alone
+ * 
+ * Multiplies the first matrix (row-major) by the second matrix (column-major)
+ * and writes the result (row-major) back to MRAM.
+ */
+static int pim_dpu_gemm_naive_multiply(void) {
     // Extract arguments from host
     uint32_t matrix1_start_offset = MATRIX_MULTIPLY_ARGUMENTS.matrix1_start_offset;
     uint32_t matrix2_start_offset = MATRIX_MULTIPLY_ARGUMENTS.matrix2_start_offset;
@@ -45,142 +102,306 @@ int main() {
     uint32_t matrix2_cols = MATRIX_MULTIPLY_ARGUMENTS.matrix2_cols;
     uint32_t result_rows = MATRIX_MULTIPLY_ARGUMENTS.result_rows;
     uint32_t result_cols = MATRIX_MULTIPLY_ARGUMENTS.result_cols;
+
+    PIM_DPU_LOG_DEBUG("Matrix1: %ux%u, Matrix2: %ux%u, Result: %ux%u",
+                      matrix1_rows, matrix1_cols, matrix2_rows, matrix2_cols, result_rows, result_cols);
+    PIM_DPU_LOG_DEBUG("MRAM offsets: M1=%u, M2=%u, Result=%u",
+                      matrix1_start_offset, matrix2_start_offset, result_start_offset);
     
-    // DEBUG: Only tasklet 0 reads and prints the matrices
-    if (pid == 0) {
-        printf("=== DEBUG: Reading matrices from MRAM ===\n");
-        printf("Matrix1: %ux%u, Matrix2: %ux%u, Result: %ux%u\n",
-               matrix1_rows, matrix1_cols, matrix2_rows, matrix2_cols, result_rows, result_cols);
-        printf("MRAM offsets: M1=%u, M2=%u, Result=%u\n",
-               matrix1_start_offset, matrix2_start_offset, result_start_offset);
-        
-        // Calculate matrix sizes
-        uint32_t matrix1_size = matrix1_rows * matrix1_cols * matrix1_type_size;
-        uint32_t matrix2_size = matrix2_rows * matrix2_cols * matrix2_type_size;
-        
-        // Ensure 8-byte alignment for MRAM transfers
-        uint32_t aligned_matrix1_size = ((matrix1_size + 8 - (matrix1_size % 8)));
-        uint32_t aligned_matrix2_size = ((matrix2_size + 8 - (matrix1_size % 8)));
-        
-        printf("Matrix sizes: M1=%u bytes (aligned=%u), M2=%u bytes (aligned=%u)\n",
-               matrix1_size, aligned_matrix1_size, matrix2_size, aligned_matrix2_size);
-        // Allocate WRAM for both matrices using mem_alloc
-        uint8_t* matrix1_wram = (uint8_t*)mem_alloc(aligned_matrix1_size);
-        uint8_t* matrix2_wram = (uint8_t*)mem_alloc(aligned_matrix2_size);
-
-        if (matrix1_wram == NULL || matrix2_wram == NULL) {
-            printf("ERROR: Failed to allocate WRAM for debug matrices\n");
-            return -1;
-        }
-        
-        printf("WRAM allocated: M1=%p, M2=%p\n", matrix1_wram, matrix2_wram);
-        
-        // Read Matrix1 from MRAM to WRAM
-        __mram_ptr void* matrix1_mram = DPU_MRAM_HEAP_POINTER + matrix1_start_offset;
-        printf("Reading Matrix1 from MRAM address %p...\n", matrix1_mram);
-        mram_read(matrix1_mram, matrix1_wram, aligned_matrix1_size);
-        
-        // Read Matrix2 from MRAM to WRAM
-        __mram_ptr void* matrix2_mram = DPU_MRAM_HEAP_POINTER + matrix2_start_offset;
-        printf("Reading Matrix2 from MRAM address %p...\n", matrix2_mram);
-        mram_read(matrix2_mram, matrix2_wram, aligned_matrix2_size);
-        
-        printf("=== Matrix1 Contents ===\n");
-        for (uint32_t i = 0; i < matrix1_rows && i < 8; i++) { // Limit rows for readability
-            printf("Row %u: ", i);
-            for (uint32_t j = 0; j < matrix1_cols && j < 16; j++) { // Limit cols for readability
-                uint32_t idx = i * matrix1_cols + j;
-                printf("%02x ", matrix1_wram[idx]);
-            }
-            if (matrix1_cols > 16) printf("... (%u more cols)", matrix1_cols - 16);
-            printf("\n");
-        }
-        if (matrix1_rows > 8) printf("... (%u more rows)\n", matrix1_rows - 8);
-        
-        printf("\n=== Matrix2 Contents ===\n");
-        for (uint32_t i = 0; i < matrix2_rows && i < 8; i++) { // Limit rows for readability
-            printf("Row %u: ", i);
-            for (uint32_t j = 0; j < matrix2_cols && j < 16; j++) { // Limit cols for readability
-                uint32_t idx = i * matrix2_cols + j;
-                printf("%02x ", matrix2_wram[idx]);
-            }
-            if (matrix2_cols > 16) printf("... (%u more cols)", matrix2_cols - 16);
-            printf("\n");
-        }
-        if (matrix2_rows > 8) printf("... (%u more rows)\n", matrix2_rows - 8);
-        
-        printf("=== End Debug Output ===\n\n");
-
-        // Naive matrix multiplication (assuming uint8_t elements for simplicity)
-        if (matrix1_cols != matrix2_cols) {
-            printf("ERROR: Incompatible matrix dimensions for multiplication\n");
-        } else {
-            uint32_t result_size = result_rows * result_cols * result_type_size;
-            uint32_t aligned_result_size = ((result_size + 8 - (result_size % 8)));
-            uint16_t* result_wram = (uint16_t*)mem_alloc(aligned_result_size);
-            if (result_wram == NULL) {
-            printf("ERROR: Failed to allocate WRAM for result matrix\n");
-            } else {
-            // Zero the result matrix
-            for (uint32_t i = 0; i < aligned_result_size; i++) {
-                result_wram[i] = 0;
-            }
-            // Naive multiplication
-            for (uint32_t i = 0; i < result_rows; i++) {
-                for (uint32_t j = 0; j < result_cols; j++) {
-                uint32_t sum = 0;
-                for (uint32_t k = 0; k < matrix1_cols; k++) {
-                    uint8_t a = matrix1_wram[i * matrix1_cols + k];
-                    uint8_t b = matrix2_wram[j * matrix1_cols + k];
-                    sum += a * b;
-                }
-                result_wram[i*result_cols + j] = (uint16_t)sum;
-                }
-            }
-            printf("\n=== Naive Result Matrix ===\n");
-            for (uint32_t i = 0; i < result_rows && i < 8; i++) {
-                printf("Row %u: ", i);
-                for (uint32_t j = 0; j < result_cols && j < 16; j++) {
-                uint32_t idx = i * result_cols + j;
-                printf("%02x ", result_wram[idx]);
-                }
-                if (result_cols > 16) printf("... (%u more cols)", result_cols - 16);
-                printf("\n");
-            }
-            if (result_rows > 8) printf("... (%u more rows)\n", result_rows - 8);
-            printf("=== End Naive Result ===\n\n");
+    // Calculate matrix sizes
+    uint32_t matrix1_size = matrix1_rows * matrix1_cols * matrix1_type_size;
+    uint32_t matrix2_size = matrix2_rows * matrix2_cols * matrix2_type_size;
+    
+    // Ensure 8-byte alignment for MRAM transfers
+    uint32_t aligned_matrix1_size = ((matrix1_size + 7) / 8) * 8;
+    uint32_t aligned_matrix2_size = ((matrix2_size + 7) / 8) * 8;
+    
+    PIM_DPU_LOG_DEBUG("Matrix sizes: M1=%u bytes (aligned=%u), M2=%u bytes (aligned=%u)",
+                      matrix1_size, aligned_matrix1_size, matrix2_size, aligned_matrix2_size);
+    if (aligned_matrix1_size + aligned_matrix2_size > PIM_DPU_GEMM_WRAM_BUDGET) {
+        PIM_DPU_LOG_ERROR("Matrices exceed the GEMM WRAM budget (%u bytes)", (uint32_t)PIM_DPU_GEMM_WRAM_BUDGET);
+        return -1;
+    }
+    // Allocate WRAM for both matrices using mem_alloc
+    pim_dpu_matrix1_t* matrix1_wram = (pim_dpu_matrix1_t*)mem_alloc(aligned_matrix1_size);
+    pim_dpu_matrix2_t* matrix2_wram = (pim_dpu_matrix2_t*)mem_alloc(aligned_matrix2_size);
 
-            // Write result matrix back to MRAM
-            __mram_ptr void* result_mram = DPU_MRAM_HEAP_POINTER + result_start_offset;
-            printf("Writing result matrix to MRAM address %p...\n", result_mram);
-            mram_write(result_wram, result_mram, aligned_result_size);
+    if (matrix1_wram == NULL || matrix2_wram == NULL) {
+        PIM_DPU_LOG_ERROR("Failed to allocate WRAM for matrices");
+        return -1;
+    }
+    
+    // Read Matrix1 from MRAM to WRAM
+    PIM_DPU_PERF_SAMPLE(read_start);
+    __mram_ptr void* matrix1_mram = DPU_MRAM_HEAP_POINTER + matrix1_start_offset;
+    pim_dpu_mram_read_blocks(matrix1_mram, matrix1_wram, aligned_matrix1_size);
+    
+    // Read Matrix2 from MRAM to WRAM
+    __mram_ptr void* matrix2_mram = DPU_MRAM_HEAP_POINTER + matrix2_start_offset;
+    pim_dpu_mram_read_blocks(matrix2_mram, matrix2_wram, aligned_matrix2_size);
+    PIM_DPU_PERF_ADD(mram_read_cycles, read_start);
+    
+    // Naive matrix multiplication on the element types the kernel variant is built for
+    if (matrix1_cols != matrix2_cols) {
+        PIM_DPU_LOG_ERROR("Incompatible matrix dimensions for multiplication");
+        return -1;
+    }
+    pim_dpu_epilogue_t epilogue;
+    PIM_DPU_PERF_SAMPLE(epilogue_start);
+    if (pim_dpu_epilogue_load(&epilogue, &MATRIX_MULTIPLY_ARGUMENTS) != 0) {
+        return -1;
+    }
+    PIM_DPU_PERF_ADD(mram_read_cycles, epilogue_start);
+    uint32_t result_size = result_rows * result_cols * pim_dpu_epilogue_output_size(&epilogue);
+    uint32_t aligned_result_size = ((result_size + 7) / 8) * 8;
+    pim_dpu_result_t* result_wram = (pim_dpu_result_t*)mem_alloc(aligned_result_size);
+    if (result_wram == NULL) {
+        PIM_DPU_LOG_ERROR("Failed to allocate WRAM for result matrix");
+        return -1;
+    }
+    // Zero the result matrix
+    for (uint32_t i = 0; i < aligned_result_size / sizeof(uint8_t); i++) {
+        ((uint8_t*)result_wram)[i] = 0;
+    }
+    // Naive multiplication; the result may be padded wider than the operands when the epilogue narrows it
+    PIM_DPU_PERF_SAMPLE(compute_start);
+    uint32_t compute_rows = result_rows < matrix1_rows ? result_rows : matrix1_rows;
+    uint32_t compute_cols = result_cols < matrix2_rows ? result_cols : matrix2_rows;
+    for (uint32_t i = 0; i < compute_rows; i++) {
+        for (uint32_t j = 0; j < compute_cols; j++) {
+            pim_dpu_accumulator_t sum = 0;
+            for (uint32_t k = 0; k < matrix1_cols; k++) {
+                pim_dpu_matrix1_t a = matrix1_wram[i * matrix1_cols + k];
+                pim_dpu_matrix2_t b = matrix2_wram[j * matrix1_cols + k];
+                sum += (pim_dpu_accumulator_t)a * b;
             }
+            pim_dpu_epilogue_store(&epilogue, result_wram, i*result_cols + j, sum, j);
         }
     }
+    PIM_DPU_PERF_ADD(compute_cycles, compute_start);
 
-    // Wait for debug output to complete
+    // Write result matrix back to MRAM
+    __mram_ptr void* result_mram = DPU_MRAM_HEAP_POINTER + result_start_offset;
+    PIM_DPU_PERF_SAMPLE(write_start);
+    pim_dpu_mram_write_blocks(result_wram, result_mram, aligned_result_size);
+    PIM_DPU_PERF_ADD(mram_write_cycles, write_start);
+    return 0;
+}
+
+/**
+ * @brief Naive GEMM variant of the multiplexed DPU program
+ *
+ * Tasklet 0 multiplies the whole slices in WRAM while the other tasklets wait; failures are
+ * reported after the barrier, so no tasklet waits forever.
+ */
+static int pim_dpu_gemm_naive(int pid) {
+    if (pim_dpu_check_dtypes(pid) != 0) {
+        return -1;
+    }
+    if (pid == 0) {
+        naive_status = pim_dpu_gemm_naive_multiply();
+    }
+    // Wait for tasklet 0 to write the result
     barrier_wait(&my_barrier);
-    
-    // Create matrix configuration
+    return naive_status;
+}
+
+/**
+ * @brief Thread memory manager GEMM variant of the multiplexed DPU program
+ *
+ * Result elements are split evenly across tasklets; see pim_dpu_matrix_multiply_thread_memory_manager.
+ */
+static int pim_dpu_gemm_thread_memory_manager(int pid) {
+    if (pim_dpu_check_dtypes(pid) != 0) {
+        return -1;
+    }
+
     matrix_config_t config = {
-        .matrix1_rows = matrix1_rows,
-        .matrix1_cols = matrix1_cols,
-        .matrix2_rows = matrix2_rows,
-        .matrix2_cols = matrix2_cols,
-        .result_rows = result_rows,
-        .result_cols = result_cols,
+        .matrix1_rows = MATRIX_MULTIPLY_ARGUMENTS.matrix1_rows,
+        .matrix1_cols = MATRIX_MULTIPLY_ARGUMENTS.matrix1_cols,
+        .matrix2_rows = MATRIX_MULTIPLY_ARGUMENTS.matrix2_rows,
+        .matrix2_cols = MATRIX_MULTIPLY_ARGUMENTS.matrix2_cols,
+        .result_rows = MATRIX_MULTIPLY_ARGUMENTS.result_rows,
+        .result_cols = MATRIX_MULTIPLY_ARGUMENTS.result_cols,
         .tasklet_id = pid,
         .num_tasklets = NR_TASKLETS
     };
+    return pim_dpu_matrix_multiply_thread_memory_manager(
+        DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix1_start_offset,
+        DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix2_start_offset,
+        DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.result_start_offset,
+        MATRIX_MULTIPLY_ARGUMENTS.matrix1_type_size,
+        MATRIX_MULTIPLY_ARGUMENTS.matrix2_type_size,
+        &MATRIX_MULTIPLY_ARGUMENTS,
+        &config
+    );
+}
+
+/**
+ * @brief Tiled GEMM variant of the multiplexed DPU program
+ *
+ * All tasklets compute output tiles; see pim_dpu_gemm_tiled.
+ */
+static int pim_dpu_gemm_tiled_variant(int pid) {
+    if (pim_dpu_check_dtypes(pid) != 0) {
+        return -1;
+    }
+    return pim_dpu_gemm_tiled(DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix1_start_offset,
+                              DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix2_start_offset,
+                              DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.result_start_offset,
+                              &MATRIX_MULTIPLY_ARGUMENTS);
+}
+
+/**
+ * @brief Lookup-table GEMM variant of the multiplexed DPU program
+ *
+ * The tiled GEMM with products looked up in a WRAM table; only built for 8-bit operands. The host selects it when
+ * all operand values fit DPU_PIM_GEMM_LUT_BITS bits.
+ */
+static int pim_dpu_gemm_lut_variant(int pid) {
+    if (PIM_DPU_GEMM_LUT_ENTRIES == 1) {
+        if (pid == 0) {
+            PIM_DPU_LOG_ERROR("Lookup-table GEMM needs 8-bit operands");
+        }
+        return -1;
+    }
+    return pim_dpu_gemm_tiled_variant(pid);
+}
+
+/**
+ * @brief Pipelined GEMM variant of the multiplexed DPU program
+ *
+ * Fetch tasklets double-buffer operand blocks for compute tasklets; see pim_dpu_gemm_pipelined. Binaries without
+ * fetch tasklets (PIM_DPU_PIPELINE_FETCH_TASKLETS = 0, e.g. single-tasklet builds) run the tiled GEMM instead.
+ */
+static int pim_dpu_gemm_pipelined_variant(int pid) {
+    if (PIM_DPU_PIPELINE_FETCH_TASKLETS == 0) {
+        return pim_dpu_gemm_tiled_variant(pid);
+    }
+    if (pim_dpu_check_dtypes(pid) != 0) {
+        return -1;
+    }
+    return pim_dpu_gemm_pipelined(DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix1_start_offset,
+                                  DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix2_start_offset,
+                                  DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.result_start_offset,
+                                  &MATRIX_MULTIPLY_ARGUMENTS);
+}
+
+/**
+ * @brief Outer-product GEMM variant of the multiplexed DPU program
+ *
+ * Streams panels of the row-major second matrix at matrix2_staging_offset; see pim_dpu_gemm_outer. The host only
+ * selects it when the slice and the result fit PIM_DPU_GEMM_OUTER_COLS columns.
+ */
+static int pim_dpu_gemm_outer_variant(int pid) {
+    if (pim_dpu_check_dtypes(pid) != 0) {
+        return -1;
+    }
+    return pim_dpu_gemm_outer(DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix1_start_offset,
+                              DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix2_staging_offset,
+                              DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.result_start_offset,
+                              &MATRIX_MULTIPLY_ARGUMENTS);
+}
+
+/**
+ * @brief GEMM operation of the multiplexed DPU program
+ *
+ * Runs the GEMM variant selected by the host, after converting a second matrix the host pushed row-major. The
+ * outer-product GEMM reads the row-major slice as it is, so the conversion is left to the next other variant.
+ */
+static int pim_dpu_op_gemm(int pid) {
+    if (MATRIX_MULTIPLY_ARGUMENTS.matrix2_layout == DPU_PIM_LAYOUT_ROW_MAJOR &&
+        MATRIX_MULTIPLY_ARGUMENTS.gemm_variant != DPU_PIM_GEMM_OUTER &&
+        pim_dpu_transpose_matrix2(DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix2_staging_offset,
+                                  DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix2_start_offset,
+                                  MATRIX_MULTIPLY_ARGUMENTS.matrix2_cols, MATRIX_MULTIPLY_ARGUMENTS.matrix2_rows) != 0) {
+        return -1;
+    }
+    switch (MATRIX_MULTIPLY_ARGUMENTS.gemm_variant) {
+        case DPU_PIM_GEMM_NAIVE:
+            return pim_dpu_gemm_naive(pid);
+        case DPU_PIM_GEMM_THREAD_MEMORY_MANAGER:
+            return pim_dpu_gemm_thread_memory_manager(pid);
+        case DPU_PIM_GEMM_TILED:
+            return pim_dpu_gemm_tiled_variant(pid);
+        case DPU_PIM_GEMM_LUT:
+            return pim_dpu_gemm_lut_variant(pid);
+        case DPU_PIM_GEMM_PIPELINED:
+            return pim_dpu_gemm_pipelined_variant(pid);
+        case DPU_PIM_GEMM_OUTER:
+            return pim_dpu_gemm_outer_variant(pid);
+        default:
+            if (pid == 0) {
+                PIM_DPU_LOG_ERROR("Unknown GEMM variant %u", MATRIX_MULTIPLY_ARGUMENTS.gemm_variant);
+            }
+            return -1;
+    }
+}
+
+/**
+ * @brief Main DPU function of the multiplexed DPU program
+ * 
+ * This function is executed on each DPU and dispatches all tasklets to the
+ * operation selected by the opcode in the arguments passed by the host.
+ */
+int main() {
+    int pid = me();
     
-    // Call the memory manager to handle matrix multiplication
-    // return pim_dpu_matrix_multiply_thread_memory_manager(
-    //     DPU_MRAM_HEAP_POINTER + matrix1_start_offset,
-    //     DPU_MRAM_HEAP_POINTER + matrix2_start_offset,
-    //     DPU_MRAM_HEAP_POINTER + result_start_offset,
-    //     matrix1_type_size,
-    //     matrix2_type_size,
-    //     result_type_size,
-    //     &config
-    // );
+    // Initialize memory heap on tasklet 0
+    if (pid == 0) {
+        mem_reset(); // Reset the heap
+        KERNEL_STATUS = 0;
+    }
+    pim_dpu_perf_reset(pid);
+    barrier_wait(&my_barrier);
+
+    int status;
+    switch (MATRIX_MULTIPLY_ARGUMENTS.opcode) {
+        case DPU_PIM_OP_GEMM:
+            status = pim_dpu_op_gemm(pid);
+            break;
+        case DPU_PIM_OP_GEMV:
+            if (pim_dpu_check_dtypes(pid) != 0) {
+                status = -1;
+                break;
+            }
+            status = pim_dpu_gemv(DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix1_start_offset,
+                                DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix2_start_offset,
+                                DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.result_start_offset,
+                                MATRIX_MULTIPLY_ARGUMENTS.matrix1_rows, MATRIX_MULTIPLY_ARGUMENTS.matrix1_cols);
+            break;
+        case DPU_PIM_OP_ELEMENTWISE_ADD:
+            if (pim_dpu_check_dtypes(pid) != 0) {
+                status = -1;
+                break;
+            }
+            status = pim_dpu_elementwise_add(DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix1_start_offset,
+                                             DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix2_start_offset,
+                                             DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.result_start_offset,
+                                             MATRIX_MULTIPLY_ARGUMENTS.result_rows * MATRIX_MULTIPLY_ARGUMENTS.result_cols);
+            break;
+        case DPU_PIM_OP_REDUCE_ROWS:
+            if (pim_dpu_check_dtypes(pid) != 0) {
+                status = -1;
+                break;
+            }
+            status = pim_dpu_reduce_rows(DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.matrix1_start_offset,
+                                         DPU_MRAM_HEAP_POINTER + MATRIX_MULTIPLY_ARGUMENTS.result_start_offset,
+                                         MATRIX_MULTIPLY_ARGUMENTS.matrix1_rows, MATRIX_MULTIPLY_ARGUMENTS.matrix1_cols);
+            break;
+        default:
+            if (pid == 0) {
+                PIM_DPU_LOG_ERROR("Unknown opcode %u", MATRIX_MULTIPLY_ARGUMENTS.opcode);
+            }
+            status = -1;
+            break;
+    }
+
+    // The cycle counter was reset before the barrier, so it now holds the cycles of this tasklet's operation
+    PIM_DPU_PERF_ADD(total_cycles, 0);
+    // The return value of main does not reach the host; every failing tasklet writes the same value
+    if (status != 0) {
+        KERNEL_STATUS = -1;
+    }
+    return status;
 }
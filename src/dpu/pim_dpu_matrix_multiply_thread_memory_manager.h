@@ -7,10 +7,11 @@
 #include <defs.h>
 #include <mram.h>
 #include <barrier.h>
-#include <mutex.h>
 
-#define MAX_MATRIX_ROWS 512
-#define MAX_MATRIX_COLS 512
+#include "pim_dpu_kernel_config.h"
+#include "pim_dpu_log.h"
+#include "pim_dpu_perf.h"
+#include "pim_dpu_epilogue.h"
 
 /**
  * @brief Matrix configuration structure for DPU operations
@@ -27,64 +28,64 @@ typedef struct {
 } matrix_config_t;
 
 
-uint16_t pim_dpu_dot_product(uint8_t * first_matrix, uint8_t * second_matrix, int32_t elements) {
+/**
+ * @brief Dot product of a matrix row and a matrix column in WRAM
+ *
+ * Products are summed in pim_dpu_accumulator_t (at least 32 bits), so long rows of
+ * 8-bit values do not wrap before the result is stored.
+ */
+pim_dpu_accumulator_t pim_dpu_dot_product(pim_dpu_matrix1_t * first_matrix, pim_dpu_matrix2_t * second_matrix, int32_t elements) {
     // Input validation
     if (first_matrix == NULL || second_matrix == NULL || elements <= 0) {
-        printf("Error: Null matrix pointer provided.\n");
+        PIM_DPU_LOG_ERROR("Null matrix pointer provided.");
         return 0;
     }
     
-    int16_t result = 0;
-    for (uint32_t i = 0; i < elements; ++i) {
-        result += (int16_t)first_matrix[i] * (int16_t)second_matrix[i];
+    pim_dpu_accumulator_t result = 0;
+    for (int32_t i = 0; i < elements; ++i) {
+        result += (pim_dpu_accumulator_t)first_matrix[i] * second_matrix[i];
     }
     return result;
 }
 
 BARRIER_INIT(barrier_p, NR_TASKLETS);
 
-
-
-// Global shared WRAM data structures
-static __dma_aligned uint8_t* global_matrix1_rows[MAX_MATRIX_ROWS];  // Array of pointers to WRAM row data
-static __dma_aligned uint8_t* global_matrix2_cols[MAX_MATRIX_COLS];  // Array of pointers to WRAM column data
-static __dma_aligned uint16_t* global_result_matrix;                 // WRAM result matrix
-static bool global_matrix1_row_fetched[MAX_MATRIX_ROWS];            // Track which rows are fetched
-static bool global_matrix2_col_fetched[MAX_MATRIX_COLS];            // Track which columns are fetched
-
-// FSB allocators for memory management
-static fsb_allocator_t global_result_allocator;
-static fsb_allocator_t global_matrix1_row_allocators[MAX_MATRIX_ROWS];
-static fsb_allocator_t global_matrix2_col_allocators[MAX_MATRIX_COLS];
-
-// Mutexes for thread coordination
-MUTEX_INIT(matrix1_mutex);  // Protects matrix1 row fetching
-MUTEX_INIT(matrix2_mutex);  // Protects matrix2 column fetching
-MUTEX_INIT(result_mutex);   // Protects result matrix writes
-MUTEX_INIT(log_mutex);     // Protects debug logging
-
-#define MAX_MATRIX_ROWS 512
-#define MAX_MATRIX_COLS 512
+// Global shared WRAM data structures, bounded by the panel and block sizes rather than the matrix sizes
+static pim_dpu_matrix1_t* global_row_slots;                          // PIM_DPU_TMM_PANEL_ROWS row segments of the current block
+static pim_dpu_matrix2_t* global_col_slots;                           // PIM_DPU_TMM_PANEL_COLS column segments of the current block
+static pim_dpu_accumulator_t* global_panel;                           // Dot products of the current panel
+static uint8_t* global_panel_rows;                                    // One output row buffer per tasklet for flushing
+static pim_dpu_epilogue_t global_epilogue;                            // Epilogue shared by all tasklets
+static int32_t global_status;                                         // Set to -1 when the shared WRAM cannot be allocated
 
 /**
  * @brief Memory manager for DPU matrix multiplication with tasklet distribution
  * 
  * This function manages memory allocation and data distribution across tasklets for 
- * matrix multiplication operations. It follows SimplePIM's MapProcessing pattern:
- * 1. Splits matrices into tasklet-sized chunks
- * 2. Manages MRAM to WRAM transfers
- * 3. Coordinates parallel processing across tasklets
- * 4. Handles memory barriers and synchronization
+ * matrix multiplication operations. It follows SimplePIM's MapProcessing pattern with bounded WRAM:
+ * 1. Walks the result in panels of PIM_DPU_TMM_PANEL_ROWS x PIM_DPU_TMM_PANEL_COLS and splits the
+ *    elements of every panel evenly across tasklets
+ * 2. Streams the inner dimension in blocks of PIM_DPU_GEMM_BLOCK_ELEMENTS; the row and column segments of a
+ *    block are fetched from MRAM once into slots reused by the next block, each slot by a statically assigned
+ *    tasklet, and published to all tasklets by a barrier
+ * 3. Accumulates the dot products of the panel in WRAM
+ * 4. Runs the epilogue on the finished panel and flushes it to MRAM before starting the next one
+ *
+ * WRAM use depends only on the panel and block sizes, so the slices are limited by MRAM alone. Slots and panel
+ * elements are owned by exactly one tasklet, so the tasklets never take a lock.
+ * Failures are reported before any work starts, so every tasklet returns -1 instead of waiting forever.
  *
- * @param inputs1 Pointer to first matrix data in MRAM
- * @param inputs2 Pointer to second matrix data in MRAM  
+ * @param inputs1 Pointer to first matrix data in MRAM (row-major, matrix1_rows x matrix1_cols)
+ * @param inputs2 Pointer to second matrix data in MRAM (column-major, matrix2_rows columns of matrix2_cols)
  * @param outputs Pointer to result matrix data in MRAM
  * @param input_type1 Size of first matrix elements (int8_t = 1)
  * @param input_type2 Size of second matrix elements (int8_t = 1)
- * @param output_type Size of result matrix elements (uint16_t = 2)
+ * @param args Kernel arguments passed by the host, for the epilogue
  * @param config Matrix dimensions and tasklet configuration
  */
-int pim_dpu_matrix_multiply_thread_memory_manager(__mram_ptr void* inputs1, __mram_ptr void* inputs2, __mram_ptr void* outputs, uint32_t input_type1, uint32_t input_type2, uint32_t output_type, matrix_config_t* config) {
+int pim_dpu_matrix_multiply_thread_memory_manager(__mram_ptr void* inputs1, __mram_ptr void* inputs2, __mram_ptr void* outputs,
+                                                  uint32_t input_type1, uint32_t input_type2,
+                                                  const dpu_pim_matrix_multiply_kernel_arguments_t* args, matrix_config_t* config) {
     uint32_t pid = me();
     uint32_t num_tasklets = NR_TASKLETS;
     
@@ -99,178 +100,136 @@ int pim_dpu_matrix_multiply_thread_memory_manager(__mram_ptr void* inputs1, __mr
     // Validate matrix dimensions for multiplication
     if (matrix1_cols != matrix2_cols) {
         if (pid == 0) {
-            printf("Error: Matrix dimensions incompatible for multiplication (matrix1_cols=%u != matrix2_rows=%u)\n", 
-                   matrix1_cols, matrix2_rows);
+            PIM_DPU_LOG_ERROR("Matrix dimensions incompatible for multiplication (matrix1_cols=%u != matrix2_cols=%u)", 
+                              matrix1_cols, matrix2_cols);
         }
         return -1;
     }
     
-    // Check if matrices exceed maximum dimensions
-    if (matrix1_rows > MAX_MATRIX_ROWS || matrix2_cols > MAX_MATRIX_COLS) {
-        if (pid == 0) {
-            printf("Error: Matrix dimensions exceed maximum (max_rows=%u, max_cols=%u)\n", 
-                   MAX_MATRIX_ROWS, MAX_MATRIX_COLS);
+    // Thread 0 allocates the segment slots and the panel and loads the epilogue
+    if (pid == 0) {        
+        global_status = 0;
+        // The slots are allocated once and reused for every panel and block
+        global_row_slots = (pim_dpu_matrix1_t*)mem_alloc(PIM_DPU_TMM_PANEL_ROWS * PIM_DPU_GEMM_BLOCK_ELEMENTS * input_type1);
+        global_col_slots = (pim_dpu_matrix2_t*)mem_alloc(PIM_DPU_TMM_PANEL_COLS * PIM_DPU_GEMM_BLOCK_ELEMENTS * input_type2);
+        global_panel = (pim_dpu_accumulator_t*)mem_alloc(PIM_DPU_TMM_PANEL_ROWS * PIM_DPU_TMM_PANEL_COLS * sizeof(pim_dpu_accumulator_t));
+        global_panel_rows = (uint8_t*)mem_alloc(num_tasklets * PIM_DPU_TMM_WRAM_PER_TASKLET);
+        if (global_row_slots == NULL || global_col_slots == NULL || global_panel == NULL || global_panel_rows == NULL) {
+            PIM_DPU_LOG_ERROR("Failed to allocate WRAM for segment slots, panel and panel rows");
+            global_status = -1;
         }
-        return -1;
+        
+        PIM_DPU_PERF_SAMPLE(epilogue_start);
+        if (pim_dpu_epilogue_load(&global_epilogue, args) != 0) {
+            global_status = -1;
+        }
+        PIM_DPU_PERF_ADD(mram_read_cycles, epilogue_start);
     }
     
-    // Calculate total result elements and check if we have too many threads
-    uint32_t total_result_elements = result_rows * result_cols;
-    if (num_tasklets > total_result_elements) {
-        if (pid == 0) {
-            printf("Error: Too many threads (%u) for result elements (%u)\n", 
-                   num_tasklets, total_result_elements);
-        }
+    // Wait for thread 0 to complete initialization; nothing changes global_status afterwards
+    barrier_wait(&barrier_p);
+    if (global_status != 0) {
         return -1;
     }
+    // Each tasklet flushes whole panel rows through its own buffer
+    uint8_t* panel_row = global_panel_rows + pid * PIM_DPU_TMM_WRAM_PER_TASKLET;
     
-    // Thread 0 initializes WRAM address arrays and result matrix
-    if (pid == 0) {        
-        // Initialize all row and column pointers to NULL
-        for (uint32_t i = 0; i < MAX_MATRIX_ROWS; i++) {
-            global_matrix1_rows[i] = NULL;
-            global_matrix1_row_fetched[i] = false;
-        }
+    uint32_t output_size = pim_dpu_epilogue_output_size(&global_epilogue);
+    // The result may be padded wider than the operands when the epilogue narrows it; padding is written as zero
+    uint32_t compute_rows = result_rows < matrix1_rows ? result_rows : matrix1_rows;
+    uint32_t compute_cols = result_cols < matrix2_rows ? result_cols : matrix2_rows;
+    uint32_t row_panels = (result_rows + PIM_DPU_TMM_PANEL_ROWS - 1) / PIM_DPU_TMM_PANEL_ROWS;
+    uint32_t col_panels = (result_cols + PIM_DPU_TMM_PANEL_COLS - 1) / PIM_DPU_TMM_PANEL_COLS;
+    
+    for (uint32_t panel = 0; panel < row_panels * col_panels; panel++) {
+        uint32_t row_start = (panel / col_panels) * PIM_DPU_TMM_PANEL_ROWS;
+        uint32_t col_start = (panel % col_panels) * PIM_DPU_TMM_PANEL_COLS;
+        uint32_t panel_rows = result_rows - row_start < PIM_DPU_TMM_PANEL_ROWS ? result_rows - row_start : PIM_DPU_TMM_PANEL_ROWS;
+        uint32_t panel_cols = result_cols - col_start < PIM_DPU_TMM_PANEL_COLS ? result_cols - col_start : PIM_DPU_TMM_PANEL_COLS;
+        uint32_t valid_rows = compute_rows > row_start ? compute_rows - row_start : 0;
+        uint32_t valid_cols = compute_cols > col_start ? compute_cols - col_start : 0;
+        valid_rows = valid_rows < panel_rows ? valid_rows : panel_rows;
+        valid_cols = valid_cols < panel_cols ? valid_cols : panel_cols;
         
-        for (uint32_t i = 0; i < MAX_MATRIX_COLS; i++) {
-            global_matrix2_cols[i] = NULL;
-            global_matrix2_col_fetched[i] = false;
-        }
+        // Calculate which panel elements this thread should compute
+        uint32_t total_panel_elements = valid_rows * valid_cols;
+        uint32_t elements_per_thread = total_panel_elements / num_tasklets;
+        uint32_t extra_elements = total_panel_elements % num_tasklets;
         
-        // Allocate WRAM for result matrix using FSB allocator
-        uint32_t result_size = result_rows * result_cols * output_type;
-        global_result_allocator = fsb_alloc(result_size, 1);
-        global_result_matrix = (uint16_t*)fsb_get(global_result_allocator);
-        if (global_result_matrix == NULL) {
-            printf("Error: Failed to allocate WRAM for result matrix (%u bytes)\n", result_size);
-            return -1;
-        }
+        uint32_t start_element, end_element;
         
-        // Initialize result matrix to zero
-        for (uint32_t i = 0; i < result_rows * result_cols; i++) {
-            global_result_matrix[i] = 0;
+        if (pid < extra_elements) {
+            // Threads with extra elements
+            start_element = pid * (elements_per_thread + 1);
+            end_element = start_element + elements_per_thread + 1;
+        } else {
+            // Regular threads
+            start_element = extra_elements * (elements_per_thread + 1) + (pid - extra_elements) * elements_per_thread;
+            end_element = start_element + elements_per_thread;
+        }
+        for (uint32_t elem_idx = start_element; elem_idx < end_element; elem_idx++) {
+            global_panel[(elem_idx / valid_cols) * PIM_DPU_TMM_PANEL_COLS + elem_idx % valid_cols] = 0;
         }
-    }
-    
-    // Wait for thread 0 to complete initialization
-    barrier_wait(&barrier_p);
-    
-    // Calculate which result elements this thread should compute
-    uint32_t elements_per_thread = total_result_elements / num_tasklets;
-    uint32_t extra_elements = total_result_elements % num_tasklets;
-    
-    uint32_t start_element, end_element;
-    
-    if (pid < extra_elements) {
-        // Threads with extra elements
-        start_element = pid * (elements_per_thread + 1);
-        end_element = start_element + elements_per_thread + 1;
-    } else {
-        // Regular threads
-        start_element = extra_elements * (elements_per_thread + 1) + (pid - extra_elements) * elements_per_thread;
-        end_element = start_element + elements_per_thread;
-    }
-    
-    // Process assigned result elements
-    for (uint32_t elem_idx = start_element; elem_idx < end_element; elem_idx++) {
-        // Convert linear element index to matrix coordinates
-        uint32_t result_row = elem_idx / result_cols;
-        uint32_t result_col = elem_idx % result_cols;
         
-        // Ensure matrix1 row is fetched
-        mutex_lock(matrix1_mutex);
-        if (!global_matrix1_row_fetched[result_row]) {
-            // Allocate WRAM for this row using FSB allocator (aligned)
-            uint32_t row_size = matrix1_cols * input_type1;
-            uint32_t aligned_row_size = ((row_size + 7) / 8) * 8; // 8-byte alignment
-            global_matrix1_row_allocators[result_row] = fsb_alloc(aligned_row_size, 1);
-            global_matrix1_rows[result_row] = (uint8_t*)fsb_get(global_matrix1_row_allocators[result_row]);
-            if (global_matrix1_rows[result_row] == NULL) {
-                printf("Thread %u: Failed to allocate WRAM for matrix1 row %u (size=%u)\n", 
-                       pid, result_row, aligned_row_size);
-                mutex_unlock(matrix1_mutex);
-                return -1;
+        for (uint32_t block_start = 0; block_start < matrix1_cols && total_panel_elements > 0;
+             block_start += PIM_DPU_GEMM_BLOCK_ELEMENTS) {
+            uint32_t block_elements = matrix1_cols - block_start;
+            if (block_elements > PIM_DPU_GEMM_BLOCK_ELEMENTS) {
+                block_elements = PIM_DPU_GEMM_BLOCK_ELEMENTS;
             }
             
-            // Fetch row from MRAM (aligned transfer following SimplePIM pattern)
-            uint32_t mram_offset = result_row * matrix1_cols * input_type1;
-            mram_read((__mram_ptr void*)((char*)inputs1 + mram_offset), global_matrix1_rows[result_row], aligned_row_size);
-            global_matrix1_row_fetched[result_row] = true;
-        }
-        mutex_unlock(matrix1_mutex);
-        
-        // Ensure matrix2 column is fetched
-        mutex_lock(matrix2_mutex);
-        if (!global_matrix2_col_fetched[result_col]) {
-            // Allocate WRAM for this column using FSB allocator
-            uint32_t col_size = matrix2_cols * input_type2;
-            global_matrix2_col_allocators[result_col] = fsb_alloc(col_size, 1);
-            global_matrix2_cols[result_col] = (uint8_t*)fsb_get(global_matrix2_col_allocators[result_col]);
-            if (global_matrix2_cols[result_col] == NULL) {
-                printf("Thread %u: Failed to allocate WRAM for matrix2 column %u\n", pid, result_col);
-                mutex_unlock(matrix2_mutex);
-                return -1;
+            // Fetch the row and column segments of the block, each slot by one tasklet
+            PIM_DPU_PERF_SAMPLE(read_start);
+            for (uint32_t slot = pid; slot < valid_rows + valid_cols; slot += num_tasklets) {
+                if (slot < valid_rows) {
+                    uint32_t mram_offset = ((row_start + slot) * matrix1_cols + block_start) * input_type1;
+                    mram_read((__mram_ptr uint8_t*)inputs1 + mram_offset, global_row_slots + slot * PIM_DPU_GEMM_BLOCK_ELEMENTS,
+                              block_elements * input_type1);
+                } else {
+                    // The second matrix is column-major, so a column segment is contiguous
+                    uint32_t col = slot - valid_rows;
+                    uint32_t mram_offset = ((col_start + col) * matrix2_cols + block_start) * input_type2;
+                    mram_read((__mram_ptr uint8_t*)inputs2 + mram_offset, global_col_slots + col * PIM_DPU_GEMM_BLOCK_ELEMENTS,
+                              block_elements * input_type2);
+                }
             }
+            PIM_DPU_PERF_ADD(mram_read_cycles, read_start);
+            barrier_wait(&barrier_p);
             
-            // Fetch column from MRAM (optimized bulk transfer)
-            // Since matrix2 is stored row-major, we need to gather column elements
-            // This is less efficient but necessary for column access
-            // For column-major ordering, we can copy the entire column in one go
-            uint8_t* temp_col_buffer = global_matrix2_cols[result_col];
-            uint32_t mram_col_offset = result_col * matrix2_rows * input_type2;
-            mram_read((__mram_ptr void*)((char*)inputs2 + mram_col_offset), global_matrix2_cols[result_col], col_size);
-            global_matrix2_col_fetched[result_col] = true;
-        }
-        mutex_unlock(matrix2_mutex);
-        
-        // Calculate dot product for result[result_row][result_col]
-        uint16_t dot_product = 0;
-        uint8_t* row_data = global_matrix1_rows[result_row];
-        uint8_t* col_data = global_matrix2_cols[result_col];
-        
-        for (uint32_t k = 0; k < matrix1_cols; k++) {
-            uint8_t a_val = row_data[k];
-            uint8_t b_val = col_data[k];
-            dot_product += a_val * b_val;
-        }
-        
-        // Store result in WRAM result matrix
-        mutex_lock(result_mutex);
-        global_result_matrix[elem_idx] = dot_product;
-        mutex_unlock(result_mutex);
-    }
-    
-    // Wait for all threads to complete their calculations
-    barrier_wait(&barrier_p);
-    
-    // Thread 0 writes the result back to MRAM
-    if (pid == 0) {
-        uint32_t result_size = result_rows * result_cols * output_type;
-        mram_write(global_result_matrix, outputs, result_size);
-        // Free allocated WRAM memory using FSB allocators
-        fsb_free(global_result_allocator, global_result_matrix);
-        for (uint32_t i = 0; i < matrix1_rows; i++) {
-            if (global_matrix1_rows[i] != NULL) {
-                fsb_free(global_matrix1_row_allocators[i], global_matrix1_rows[i]);
+            // Process assigned panel elements; every element is owned by one tasklet, so the accumulation needs no lock
+            PIM_DPU_PERF_SAMPLE(compute_start);
+            for (uint32_t elem_idx = start_element; elem_idx < end_element; elem_idx++) {
+                uint32_t panel_row_index = elem_idx / valid_cols;
+                uint32_t panel_col_index = elem_idx % valid_cols;
+                global_panel[panel_row_index * PIM_DPU_TMM_PANEL_COLS + panel_col_index] +=
+                    pim_dpu_dot_product(global_row_slots + panel_row_index * PIM_DPU_GEMM_BLOCK_ELEMENTS,
+                                        global_col_slots + panel_col_index * PIM_DPU_GEMM_BLOCK_ELEMENTS, block_elements);
             }
+            PIM_DPU_PERF_ADD(compute_cycles, compute_start);
+            
+            // The slots are refilled by the next block
+            barrier_wait(&barrier_p);
         }
-        for (uint32_t i = 0; i < matrix2_cols; i++) {
-            if (global_matrix2_cols[i] != NULL) {
-                fsb_free(global_matrix2_col_allocators[i], global_matrix2_cols[i]);
+        
+        // Flush the finished panel one row per tasklet at a time
+        PIM_DPU_PERF_SAMPLE(write_start);
+        for (uint32_t r = pid; r < panel_rows; r += num_tasklets) {
+            for (uint32_t i = 0; i < panel_cols * output_size; i++) {
+                panel_row[i] = 0;
             }
-        }
-        printf("Result matrix:\n");
-        for (uint32_t i = 0; i < result_rows; i++) {
-            for (uint32_t j = 0; j < result_cols; j++) {
-                printf("%u ", global_result_matrix[i * result_cols + j]);
+            for (uint32_t c = 0; r < valid_rows && c < valid_cols; c++) {
+                pim_dpu_epilogue_store(&global_epilogue, panel_row, c, global_panel[r * PIM_DPU_TMM_PANEL_COLS + c], col_start + c);
             }
-            printf("\n");
+            // Panels start at a multiple of 8 columns, so every row write is 8-byte aligned
+            mram_write(panel_row, (__mram_ptr uint8_t*)outputs + ((row_start + r) * result_cols + col_start) * output_size,
+                       panel_cols * output_size);
         }
+        PIM_DPU_PERF_ADD(mram_write_cycles, write_start);
+        
+        // The panel is reset by the next iteration
+        barrier_wait(&barrier_p);
     }
-    
-    // Final synchronization
-    barrier_wait(&barrier_p);
     return 0;
 }
 
-#endif // __PIM_DPU_MATRIX_MULTIPLY_THREAD_MEMORY_MANAGER_H__
\ No newline at end of file
+#endif // __PIM_DPU_MATRIX_MULTIPLY_THREAD_MEMORY_MANAGER_H__
@@ -0,0 +1,29 @@
+#ifndef __PIM_DPU_MRAM_H__
+#define __PIM_DPU_MRAM_H__
+
+#include <stdint.h>
+#include <mram.h>
+
+#include "pim_dpu_kernel_config.h"
+
+/**
+ * @brief Read an MRAM block of any 8-byte multiple into WRAM, split into the largest DMA transfers
+ */
+static inline void pim_dpu_mram_read_blocks(__mram_ptr void* from, void* to, uint32_t size) {
+    for (uint32_t offset = 0; offset < size; offset += PIM_DPU_MRAM_DMA_MAX) {
+        uint32_t chunk = size - offset < PIM_DPU_MRAM_DMA_MAX ? size - offset : PIM_DPU_MRAM_DMA_MAX;
+        mram_read((__mram_ptr uint8_t*)from + offset, (uint8_t*)to + offset, chunk);
+    }
+}
+
+/**
+ * @brief Write a WRAM block of any 8-byte multiple to MRAM, split into the largest DMA transfers
+ */
+static inline void pim_dpu_mram_write_blocks(const void* from, __mram_ptr void* to, uint32_t size) {
+    for (uint32_t offset = 0; offset < size; offset += PIM_DPU_MRAM_DMA_MAX) {
+        uint32_t chunk = size - offset < PIM_DPU_MRAM_DMA_MAX ? size - offset : PIM_DPU_MRAM_DMA_MAX;
+        mram_write((const uint8_t*)from + offset, (__mram_ptr uint8_t*)to + offset, chunk);
+    }
+}
+
+#endif // __PIM_DPU_MRAM_H__
@@ -0,0 +1,66 @@
+#ifndef __PIM_DPU_MUL_H__
+#define __PIM_DPU_MUL_H__
+
+#include <stdint.h>
+
+#include "pim_dpu_kernel_config.h"
+
+/**
+ * @brief 8x8-bit multiplies of the DPU instruction set
+ *
+ * The DPU has no single-cycle 32-bit multiplier: `a * b` in C compiles to a `mul_step` sequence. The `mul_XY_ZW`
+ * instructions multiply one byte of each register in one cycle, where X/Z select signed (s) or unsigned (u) and
+ * Y/W the low byte (l, bits 0-7) or the high byte (h, bits 8-15). The helpers below pick the instruction matching the
+ * signedness of the operand types, so packed words can be multiplied byte by byte without unpacking.
+ *
+ * Every byte product is still one instruction. Reading the high byte in place only saves the shift that would bring
+ * it down, so the packed builtin multiplication of the tiled micro-kernel issues as many multiplies as the builtin one
+ * and half the extract shifts.
+ *
+ * Build with -DPIM_DPU_MUL_ASM=0 for compilers other than the DPU toolchain; the helpers then fall back to C.
+ */
+
+#ifndef PIM_DPU_MUL_ASM
+#define PIM_DPU_MUL_ASM 1
+#endif
+
+#if PIM_DPU_MUL_ASM
+#define PIM_DPU_MUL_INSN(insn, expression)                                                         \
+    static inline int32_t pim_dpu_##insn(uint32_t a, uint32_t b) {                                 \
+        int32_t result;                                                                            \
+        __asm__(#insn " %[result], %[a], %[b]" : [result] "=r"(result) : [a] "r"(a), [b] "r"(b)); \
+        return result;                                                                             \
+    }
+#else
+#define PIM_DPU_MUL_INSN(insn, expression) \
+    static inline int32_t pim_dpu_##insn(uint32_t a, uint32_t b) { return (int32_t)(expression); }
+#endif
+
+PIM_DPU_MUL_INSN(mul_ul_ul, (uint8_t)a * (uint8_t)b)
+PIM_DPU_MUL_INSN(mul_uh_uh, (uint8_t)(a >> 8) * (uint8_t)(b >> 8))
+PIM_DPU_MUL_INSN(mul_sl_sl, (int8_t)a * (int8_t)b)
+PIM_DPU_MUL_INSN(mul_sh_sh, (int8_t)(a >> 8) * (int8_t)(b >> 8))
+PIM_DPU_MUL_INSN(mul_sl_ul, (int8_t)a * (uint8_t)b)
+PIM_DPU_MUL_INSN(mul_sh_uh, (int8_t)(a >> 8) * (uint8_t)(b >> 8))
+
+/**
+ * @brief Product of the low bytes of two words, as elements of the first and second matrix
+ */
+static inline int32_t pim_dpu_mul_low(uint32_t a, uint32_t b) {
+    if (PIM_DPU_MATRIX1_SIGNED && PIM_DPU_MATRIX2_SIGNED) return pim_dpu_mul_sl_sl(a, b);
+    if (PIM_DPU_MATRIX1_SIGNED) return pim_dpu_mul_sl_ul(a, b);
+    if (PIM_DPU_MATRIX2_SIGNED) return pim_dpu_mul_sl_ul(b, a);
+    return pim_dpu_mul_ul_ul(a, b);
+}
+
+/**
+ * @brief Product of the high bytes (bits 8-15) of two words, as elements of the first and second matrix
+ */
+static inline int32_t pim_dpu_mul_high(uint32_t a, uint32_t b) {
+    if (PIM_DPU_MATRIX1_SIGNED && PIM_DPU_MATRIX2_SIGNED) return pim_dpu_mul_sh_sh(a, b);
+    if (PIM_DPU_MATRIX1_SIGNED) return pim_dpu_mul_sh_uh(a, b);
+    if (PIM_DPU_MATRIX2_SIGNED) return pim_dpu_mul_sh_uh(b, a);
+    return pim_dpu_mul_uh_uh(a, b);
+}
+
+#endif // __PIM_DPU_MUL_H__
@@ -0,0 +1,50 @@
+#ifndef __PIM_DPU_PERF_H__
+#define __PIM_DPU_PERF_H__
+
+#include <stdint.h>
+#include <defs.h>
+#include <perfcounter.h>
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+/**
+ * @brief Per-tasklet cycle counters of the DPU program
+ *
+ * Every tasklet owns one entry of TASKLET_STATS, which the host pulls after the launch. The counters are reset at
+ * the start of every launch. Build with -DPIM_ENABLE_STATS=0 to compile the sampling out; the array then stays zero.
+ */
+
+#ifndef PIM_ENABLE_STATS
+#define PIM_ENABLE_STATS 1
+#endif
+
+__host dpu_pim_tasklet_stats_t TASKLET_STATS[NR_TASKLETS];
+
+#if PIM_ENABLE_STATS
+/// Take a cycle sample into a new local `name`
+#define PIM_DPU_PERF_SAMPLE(name) uint64_t name = (uint64_t)perfcounter_get()
+/// Add the cycles elapsed since sample `start` to `field` of the calling tasklet's counters
+#define PIM_DPU_PERF_ADD(field, start) (TASKLET_STATS[me()].field += (uint64_t)perfcounter_get() - (start))
+#else
+#define PIM_DPU_PERF_SAMPLE(name)
+#define PIM_DPU_PERF_ADD(field, start) ((void)0)
+#endif
+
+/**
+ * @brief Reset the cycle counter and the counters of the calling tasklet
+ *
+ * Must be called by every tasklet before the barrier that starts the operation.
+ */
+static inline void pim_dpu_perf_reset(uint32_t pid) {
+    TASKLET_STATS[pid].total_cycles = 0;
+    TASKLET_STATS[pid].mram_read_cycles = 0;
+    TASKLET_STATS[pid].compute_cycles = 0;
+    TASKLET_STATS[pid].mram_write_cycles = 0;
+#if PIM_ENABLE_STATS
+    if (pid == 0) {
+        perfcounter_config(COUNT_CYCLES, true);
+    }
+#endif
+}
+
+#endif // __PIM_DPU_PERF_H__
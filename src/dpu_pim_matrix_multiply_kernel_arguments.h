@@ -1,7 +1,140 @@
 #ifndef __DPU_PIM_MATRIX_MULTIPLY_KERNEL_ARGUMENTS_H___
 #define __DPU_PIM_MATRIX_MULTIPLY_KERNEL_ARGUMENTS_H___
 
+#include <stdint.h>
+
+/**
+ * @brief Operations implemented by the multiplexed DPU program.
+ * @details A single binary serves every operation, so a pipeline of mixed operations runs on resident DPUs
+ *          without reloading. The opcode is passed in `dpu_pim_matrix_multiply_kernel_arguments_t::opcode`.
+ */
+typedef enum {
+    DPU_PIM_OP_GEMM = 0,             ///< result = matrix1 * matrix2 (matrix2 stored column-major, see dpu_pim_layout_t)
+    DPU_PIM_OP_GEMV = 1,             ///< result = matrix1 * vector (vector stored at matrix2, rows padded to a multiple of 8)
+    DPU_PIM_OP_ELEMENTWISE_ADD = 2,  ///< result = matrix1 + matrix2 (same shape, row-major, rows padded to 8 elements)
+    DPU_PIM_OP_REDUCE_ROWS = 3,      ///< result[r] = sum of row r of matrix1 (rows padded to 8 elements, row count to a multiple of 8)
+    DPU_PIM_NUM_OPS
+} dpu_pim_opcode_t;
+
+/**
+ * @brief GEMM implementations of the DPU program, selected per launch in
+ *        `dpu_pim_matrix_multiply_kernel_arguments_t::gemm_variant`.
+ * @details All variants compute the same result from the same MRAM layout, so they can be compared on identical data.
+ *          DPU_PIM_GEMM_LUT only serves 8-bit operands whose values fit DPU_PIM_GEMM_LUT_BITS bits (signed for
+ *          signed element types); the host runs DPU_PIM_GEMM_TILED for any other operands. DPU_PIM_GEMM_OUTER reads
+ *          the second matrix row-major from matrix2_staging_offset and needs slices no wider than the
+ *          `gemm_outer_cols` of the kernel plan.
+ */
+typedef enum {
+    DPU_PIM_GEMM_NAIVE = 0,                  ///< Tasklet 0 multiplies the whole slices in WRAM
+    DPU_PIM_GEMM_THREAD_MEMORY_MANAGER = 1,  ///< Result panels split across tasklets, row and column segments shared in WRAM
+    DPU_PIM_GEMM_TILED = 2,                  ///< Output tiles split across tasklets, operands streamed in blocks through WRAM
+    DPU_PIM_GEMM_LUT = 3,                    ///< Tiled, products of DPU_PIM_GEMM_LUT_BITS-bit operands looked up in a WRAM table
+    DPU_PIM_GEMM_PIPELINED = 4,              ///< Tiled, with fetch tasklets double-buffering operand blocks for compute tasklets
+    DPU_PIM_GEMM_OUTER = 5,                  ///< Resident full-width result bands, updated by rank-1 products of shared panels
+    DPU_PIM_NUM_GEMM_VARIANTS
+} dpu_pim_gemm_variant_t;
+
+/**
+ * @brief Multiplication of 8-bit operands in the tiled GEMM micro-kernel, chosen when the kernel is built.
+ */
+typedef enum {
+    DPU_PIM_MULTIPLY_C = 0,               ///< C integer multiplications of the unpacked bytes
+    DPU_PIM_MULTIPLY_BUILTIN = 1,         ///< One 8x8-bit multiply instruction per unpacked byte
+    DPU_PIM_MULTIPLY_PACKED_BUILTIN = 2,  ///< One 8x8-bit multiply instruction per byte, reading the high byte of each 16-bit half in place
+    DPU_PIM_NUM_MULTIPLIES
+} dpu_pim_multiply_t;
+
+/**
+ * @brief MRAM layout of the second matrix slice of a GEMM.
+ */
+typedef enum {
+    DPU_PIM_LAYOUT_COLUMN_MAJOR = 0,   ///< Slice is stored column by column at matrix2_start_offset, as the GEMM kernels read it
+    DPU_PIM_LAYOUT_ROW_MAJOR = 1,      ///< Slice is stored row by row at matrix2_staging_offset; the DPU converts it before any GEMM but DPU_PIM_GEMM_OUTER
+} dpu_pim_layout_t;
+
+#define DPU_PIM_GEMM_LUT_BITS 4                        ///< Width of the operand values multiplied by DPU_PIM_GEMM_LUT
+#define DPU_PIM_GEMV_ROWS_PER_WRITE 8                  ///< Result rows written back at once by the GEMV operation
+#define DPU_PIM_GEMV_MAX_VECTOR_BYTES (24 * 1024)      ///< Largest GEMV vector kept resident in WRAM
+#define DPU_PIM_REDUCE_ROWS_PER_WRITE 8                ///< Result rows written back at once by the row reduction
+
+/**
+ * @brief Element types understood by the host and the DPU kernels.
+ */
+typedef enum {
+    DPU_PIM_DTYPE_INT8 = 0,
+    DPU_PIM_DTYPE_UINT8 = 1,
+    DPU_PIM_DTYPE_INT16 = 2,
+    DPU_PIM_DTYPE_UINT16 = 3,
+    DPU_PIM_DTYPE_INT32 = 4,
+    DPU_PIM_DTYPE_UINT32 = 5,
+    DPU_PIM_DTYPE_INT64 = 6,
+    DPU_PIM_NUM_DTYPES
+} dpu_pim_dtype_t;
+
+/**
+ * @brief Epilogue stages fused into the GEMM write-back, combined as a bitmask in `epilogue_flags`.
+ * @details Stages run in the order listed: bias, requantisation, ReLU, clamp. Per-column parameters are stored
+ *          in MRAM at `epilogue_start_offset` as three int32 arrays (bias, multiplier, shift) of
+ *          `dpu_pim_epilogue_param_count(result_cols)` entries each, covering the result columns of the DPU.
+ */
+typedef enum {
+    DPU_PIM_EPILOGUE_BIAS = 1 << 0,        ///< value += bias[col]
+    DPU_PIM_EPILOGUE_REQUANTIZE = 1 << 1,  ///< value = round(value * multiplier[col] / 2^shift[col]), stored as int8
+    DPU_PIM_EPILOGUE_RELU = 1 << 2,        ///< value = max(value, 0)
+    DPU_PIM_EPILOGUE_CLAMP = 1 << 3,       ///< value = min(max(value, clamp_min), clamp_max)
+} dpu_pim_epilogue_flags_t;
+
+/**
+ * @brief Number of entries of each per-column epilogue array, padded so every array is a multiple of 8 bytes.
+ */
+static inline uint32_t dpu_pim_epilogue_param_count(uint32_t result_cols) {
+    return (result_cols + 1) & ~1u;
+}
+
+/**
+ * @brief Cycle counters of one tasklet, published by the DPU program in the `__host` array `TASKLET_STATS`.
+ * @details Sampled with `perfcounter_get` around the phases of the operation that ran last. The counter is shared
+ *          by all tasklets of a DPU, so every value is the time the tasklet waited for its phase, including cycles
+ *          in which other tasklets were scheduled.
+ */
+typedef struct {
+    uint64_t total_cycles;           ///< Cycles from the start of the operation until the tasklet finished
+    uint64_t mram_read_cycles;       ///< Cycles spent in MRAM to WRAM transfers
+    uint64_t compute_cycles;         ///< Cycles spent computing on WRAM data
+    uint64_t mram_write_cycles;      ///< Cycles spent in WRAM to MRAM transfers
+} dpu_pim_tasklet_stats_t;
+
+/**
+ * @brief Build-time WRAM plan of a DPU program, published in the read-only `__host` symbol `KERNEL_PLAN`.
+ * @details Filled from the compile-time planner of src/dpu/pim_dpu_kernel_config.h, so the host can learn the
+ *          tiles a binary was built with from the binary itself instead of trusting the kernel manifest.
+ */
+typedef struct {
+    uint32_t matrix1_dtype;          ///< Element type of the first matrix (dpu_pim_dtype_t)
+    uint32_t matrix2_dtype;          ///< Element type of the second matrix (dpu_pim_dtype_t)
+    uint32_t result_dtype;           ///< Element type of the result matrix (dpu_pim_dtype_t)
+    uint32_t nr_tasklets;            ///< Number of tasklets
+    uint32_t stack_size;             ///< Stack bytes of every tasklet
+    uint32_t wram_heap_budget;       ///< WRAM left for the heap after the stacks and the static reserve
+    uint32_t tile_rows;              ///< Rows of the output tile computed by a tasklet
+    uint32_t tile_cols;              ///< Columns of the output tile, rounded up to whole 8-byte writes
+    uint32_t micro_rows;             ///< Rows of the register block of the tiled micro-kernel
+    uint32_t micro_cols;             ///< Columns of the register block of the tiled micro-kernel
+    uint32_t multiply;               ///< Multiplication of 8-bit operands in the tiled micro-kernel (dpu_pim_multiply_t)
+    uint32_t gemm_block_elements;    ///< Inner-dimension elements streamed per block by the GEMM variants
+    uint32_t fetch_tasklets;         ///< Fetch tasklets of the pipelined GEMM
+    uint32_t gemm_wram_bytes;        ///< Largest heap footprint of the blocked GEMM variants
+    uint32_t gemm_outer_cols;        ///< Widest slice and result of DPU_PIM_GEMM_OUTER, 0 when it does not fit WRAM
+    uint32_t gemm_outer_block_rows;  ///< Second-matrix rows streamed per panel by DPU_PIM_GEMM_OUTER
+    uint32_t gemv_wram_bytes;        ///< Heap footprint of DPU_PIM_OP_GEMV
+    uint32_t elementwise_wram_bytes; ///< Heap footprint of DPU_PIM_OP_ELEMENTWISE_ADD
+    uint32_t reduce_wram_bytes;      ///< Heap footprint of DPU_PIM_OP_REDUCE_ROWS
+} dpu_pim_kernel_plan_t;
+
 typedef struct {
+    uint32_t opcode;                 ///< Operation to run (dpu_pim_opcode_t)
+    uint32_t gemm_variant;           ///< GEMM implementation to run (dpu_pim_gemm_variant_t)
     uint32_t matrix1_start_offset;
     uint32_t matrix2_start_offset;
     uint32_t result_start_offset;
@@ -14,6 +147,16 @@ typedef struct {
     uint32_t matrix1_type_size;
     uint32_t matrix2_type_size;
     uint32_t result_type_size;
+    uint32_t matrix1_dtype;          ///< Element type of the first matrix (dpu_pim_dtype_t)
+    uint32_t matrix2_dtype;          ///< Element type of the second matrix (dpu_pim_dtype_t)
+    uint32_t result_dtype;           ///< Element type of the result matrix (dpu_pim_dtype_t)
+    uint32_t output_dtype;           ///< Element type written to MRAM after the epilogue (dpu_pim_dtype_t)
+    uint32_t epilogue_flags;         ///< Fused epilogue stages (dpu_pim_epilogue_flags_t bitmask)
+    uint32_t epilogue_start_offset;  ///< MRAM offset of the per-column epilogue parameters
+    int32_t clamp_min;               ///< Lower bound for DPU_PIM_EPILOGUE_CLAMP
+    int32_t clamp_max;               ///< Upper bound for DPU_PIM_EPILOGUE_CLAMP
+    uint32_t matrix2_layout;         ///< Layout of the second matrix slice (dpu_pim_layout_t)
+    uint32_t matrix2_staging_offset; ///< MRAM offset of the row-major second matrix slice for DPU_PIM_LAYOUT_ROW_MAJOR
 } dpu_pim_matrix_multiply_kernel_arguments_t;
 
-#endif // __DPU_PIM_MATRIX_MULTIPLY_KERNEL_ARGUMENTS_H___
\ No newline at end of file
+#endif // __DPU_PIM_MATRIX_MULTIPLY_KERNEL_ARGUMENTS_H___
@@ -0,0 +1,164 @@
+#include <string.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <pthread.h>
+
+#include <dpu.h>
+
+#include "pim_log.h"
+
+#include "pim_dpu_pool.h"
+
+static pim_dpu_pool_entry_t** pool_entries = NULL;
+static uint32_t pool_num_entries = 0;
+static uint32_t pool_capacity = 0;
+static pim_dpu_pool_stats_t pool_stats = {0};
+static bool pool_exit_handler_registered = false;
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static pim_dpu_pool_entry_t* pool_find_free_entry(uint32_t num_dpus, const char* binary) {
+    pim_dpu_pool_entry_t* candidate = NULL;
+    for (uint32_t i = 0; i < pool_num_entries; i++) {
+        pim_dpu_pool_entry_t* entry = pool_entries[i];
+        if (entry->in_use || entry->num_dpus != num_dpus) continue;
+        if (strcmp(entry->loaded_binary, binary) == 0) {
+            return entry;
+        }
+        if (!candidate) {
+            candidate = entry;
+        }
+    }
+    return candidate;
+}
+
+/**
+ * @brief Free the oldest idle set to give its DPUs back to the system.
+ * @return true if a set was freed, false if every set is in use.
+ */
+static bool pool_evict_idle_entry(void) {
+    for (uint32_t i = 0; i < pool_num_entries; i++) {
+        pim_dpu_pool_entry_t* entry = pool_entries[i];
+        if (entry->in_use) continue;
+        dpu_error_t err = dpu_free(entry->dpu_set);
+        if (err != DPU_OK) {
+            PIM_LOG_ERROR("Failed to free %u idle DPUs of the DPU pool (error %d)", entry->num_dpus, err);
+            return false;
+        }
+        free(entry);
+        memmove(&pool_entries[i], &pool_entries[i + 1], (pool_num_entries - i - 1) * sizeof(pim_dpu_pool_entry_t*));
+        pool_num_entries--;
+        pool_stats.num_evictions++;
+        return true;
+    }
+    return false;
+}
+
+static pim_dpu_pool_entry_t* pool_allocate_entry(uint32_t num_dpus) {
+    if (pool_num_entries == pool_capacity) {
+        uint32_t new_capacity = pool_capacity ? pool_capacity * 2 : 4;
+        pim_dpu_pool_entry_t** new_entries = (pim_dpu_pool_entry_t**)realloc(pool_entries, new_capacity * sizeof(pim_dpu_pool_entry_t*));
+        if (!new_entries) {
+            PIM_LOG_ERROR("Failed to grow DPU pool");
+            return NULL;
+        }
+        pool_entries = new_entries;
+        pool_capacity = new_capacity;
+    }
+
+    pim_dpu_pool_entry_t* entry = (pim_dpu_pool_entry_t*)malloc(sizeof(pim_dpu_pool_entry_t));
+    if (!entry) {
+        PIM_LOG_ERROR("Failed to allocate memory for DPU pool entry");
+        return NULL;
+    }
+
+    dpu_error_t err = dpu_alloc(num_dpus, NULL, &entry->dpu_set);
+    // Idle sets of other sizes still hold their DPUs; give them back one at a time until the request fits
+    while (err != DPU_OK && pool_evict_idle_entry()) {
+        err = dpu_alloc(num_dpus, NULL, &entry->dpu_set);
+    }
+    if (err != DPU_OK) {
+        PIM_LOG_ERROR("Failed to allocate %u DPUs for DPU pool (error %d)", num_dpus, err);
+        free(entry);
+        return NULL;
+    }
+    entry->num_dpus = num_dpus;
+    entry->loaded_binary[0] = '\0';
+    entry->in_use = false;
+
+    pool_entries[pool_num_entries++] = entry;
+    pool_stats.num_allocations++;
+
+    if (!pool_exit_handler_registered) {
+        atexit(pim_dpu_pool_destroy);
+        pool_exit_handler_registered = true;
+    }
+    return entry;
+}
+
+pim_dpu_pool_entry_t* pim_dpu_pool_acquire(uint32_t num_dpus, const char* binary) {
+    if (num_dpus == 0 || !binary || strlen(binary) >= PIM_DPU_POOL_MAX_BINARY_PATH) {
+        PIM_LOG_ERROR("Invalid DPU pool request");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&pool_mutex);
+
+    pim_dpu_pool_entry_t* entry = pool_find_free_entry(num_dpus, binary);
+    if (!entry) {
+        entry = pool_allocate_entry(num_dpus);
+        if (!entry) {
+            pthread_mutex_unlock(&pool_mutex);
+            return NULL;
+        }
+    }
+
+    if (strcmp(entry->loaded_binary, binary) == 0) {
+        pool_stats.num_load_skips++;
+    } else {
+        dpu_error_t err = dpu_load(entry->dpu_set, binary, NULL);
+        if (err != DPU_OK) {
+            PIM_LOG_ERROR("Failed to load DPU binary %s (error %d)", binary, err);
+            entry->loaded_binary[0] = '\0';
+            pthread_mutex_unlock(&pool_mutex);
+            return NULL;
+        }
+        strcpy(entry->loaded_binary, binary);
+        pool_stats.num_loads++;
+    }
+    entry->in_use = true;
+
+    pthread_mutex_unlock(&pool_mutex);
+    return entry;
+}
+
+void pim_dpu_pool_release(pim_dpu_pool_entry_t* entry) {
+    if (!entry) return;
+    pthread_mutex_lock(&pool_mutex);
+    entry->in_use = false;
+    pthread_mutex_unlock(&pool_mutex);
+}
+
+void pim_dpu_pool_destroy(void) {
+    pthread_mutex_lock(&pool_mutex);
+    for (uint32_t i = 0; i < pool_num_entries; i++) {
+        DPU_ASSERT(dpu_free(pool_entries[i]->dpu_set));
+        free(pool_entries[i]);
+    }
+    free(pool_entries);
+    pool_entries = NULL;
+    pool_num_entries = 0;
+    pool_capacity = 0;
+    pthread_mutex_unlock(&pool_mutex);
+}
+
+void pim_dpu_pool_get_stats(pim_dpu_pool_stats_t* stats) {
+    if (!stats) return;
+    pthread_mutex_lock(&pool_mutex);
+    *stats = pool_stats;
+    stats->num_entries = pool_num_entries;
+    pthread_mutex_unlock(&pool_mutex);
+}
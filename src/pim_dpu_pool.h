@@ -0,0 +1,67 @@
+#ifndef __PIM_DPU_POOL_H___
+#define __PIM_DPU_POOL_H___
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <dpu.h>
+
+#define PIM_DPU_POOL_MAX_BINARY_PATH 512
+
+/**
+ * @brief A DPU set owned by the process-wide pool.
+ * @details Entries are allocated once with `dpu_alloc` and kept until the process exits, or until their DPUs are
+ *          needed for a set of another size while they are idle.
+ *          The pool remembers which binary is resident on the set so that `dpu_load` can be skipped
+ *          when the set is handed out again for the same program.
+ */
+typedef struct {
+    struct dpu_set_t dpu_set;                            ///< Allocated DPU set
+    uint32_t num_dpus;                                   ///< Number of DPUs in the set
+    char loaded_binary[PIM_DPU_POOL_MAX_BINARY_PATH];    ///< Path of the binary currently loaded ("" if none)
+    bool in_use;                                         ///< Flag indicating if the set is handed out
+} pim_dpu_pool_entry_t;
+
+/**
+ * @brief Counters describing how the pool served its requests.
+ */
+typedef struct {
+    uint32_t num_entries;     ///< Number of DPU sets currently owned by the pool
+    uint32_t num_allocations; ///< Number of `dpu_alloc` calls issued
+    uint32_t num_loads;       ///< Number of `dpu_load` calls issued
+    uint32_t num_load_skips;  ///< Number of acquisitions served without a `dpu_load`
+    uint32_t num_evictions;   ///< Number of idle sets freed because a new set did not fit
+} pim_dpu_pool_stats_t;
+
+/**
+ * @brief Acquire a set of DPUs with the given binary loaded.
+ * @details A free set of the requested size that already holds the binary is preferred; otherwise a free set
+ *          of the requested size is reloaded, and only if none exists a new set is allocated. When the system
+ *          has too few DPUs left for the new set, idle sets are freed, oldest first, until it fits. The pool is
+ *          released automatically at process exit.
+ * @param num_dpus Number of DPUs in the set.
+ * @param binary Path of the DPU binary that must be resident on the set.
+ * @return Pointer to the pool entry owning the set, or NULL on failure.
+ */
+pim_dpu_pool_entry_t* pim_dpu_pool_acquire(uint32_t num_dpus, const char* binary);
+
+/**
+ * @brief Return a set previously handed out by `pim_dpu_pool_acquire` to the pool.
+ * @details The set stays allocated and keeps its loaded binary for future acquisitions.
+ * @param entry Pointer to the pool entry.
+ */
+void pim_dpu_pool_release(pim_dpu_pool_entry_t* entry);
+
+/**
+ * @brief Free all DPU sets owned by the pool.
+ * @details Sets still handed out are freed as well; any frame using them must not be used afterwards.
+ */
+void pim_dpu_pool_destroy(void);
+
+/**
+ * @brief Get the pool counters.
+ * @param stats Pointer to the structure to fill.
+ */
+void pim_dpu_pool_get_stats(pim_dpu_pool_stats_t* stats);
+
+#endif // __PIM_DPU_POOL_H___
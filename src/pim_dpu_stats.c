@@ -0,0 +1,78 @@
+#include <string.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <dpu.h>
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+#include "pim_log.h"
+
+#include "pim_dpu_stats.h"
+
+int pim_dpu_stats_collect(struct dpu_set_t dpu_set, uint32_t num_dpus, uint32_t nr_tasklets, pim_dpu_stats_t* stats) {
+    if (!stats || num_dpus == 0 || nr_tasklets == 0) return -1;
+    memset(stats, 0, sizeof(*stats));
+
+    dpu_pim_tasklet_stats_t* tasklets = (dpu_pim_tasklet_stats_t*)malloc((size_t)num_dpus * nr_tasklets * sizeof(dpu_pim_tasklet_stats_t));
+    if (!tasklets) {
+        PIM_LOG_ERROR("Failed to allocate memory for tasklet stats");
+        return -1;
+    }
+    uint32_t i;
+    struct dpu_set_t dpu;
+    DPU_FOREACH(dpu_set, dpu, i) {
+        DPU_ASSERT(dpu_prepare_xfer(dpu, tasklets + (size_t)i * nr_tasklets));
+    }
+    DPU_ASSERT(dpu_push_xfer(dpu_set, DPU_XFER_FROM_DPU, "TASKLET_STATS", 0, nr_tasklets * sizeof(dpu_pim_tasklet_stats_t), DPU_XFER_DEFAULT));
+
+    stats->num_dpus = num_dpus;
+    stats->nr_tasklets = nr_tasklets;
+    stats->tasklets = tasklets;
+    stats->dpu_cycles_min = UINT64_MAX;
+    stats->tasklet_cycles_min = UINT64_MAX;
+    double dpu_cycles_sum = 0;
+    double tasklet_cycles_sum = 0;
+    for (uint32_t d = 0; d < num_dpus; d++) {
+        uint64_t dpu_cycles = 0;
+        for (uint32_t t = 0; t < nr_tasklets; t++) {
+            const dpu_pim_tasklet_stats_t* tasklet = &tasklets[(size_t)d * nr_tasklets + t];
+            if (tasklet->total_cycles > dpu_cycles) dpu_cycles = tasklet->total_cycles;
+            if (tasklet->total_cycles < stats->tasklet_cycles_min) stats->tasklet_cycles_min = tasklet->total_cycles;
+            if (tasklet->total_cycles > stats->tasklet_cycles_max) stats->tasklet_cycles_max = tasklet->total_cycles;
+            tasklet_cycles_sum += tasklet->total_cycles;
+            stats->mram_read_cycles += tasklet->mram_read_cycles;
+            stats->mram_write_cycles += tasklet->mram_write_cycles;
+            stats->compute_cycles += tasklet->compute_cycles;
+        }
+        if (dpu_cycles < stats->dpu_cycles_min) stats->dpu_cycles_min = dpu_cycles;
+        if (dpu_cycles > stats->dpu_cycles_max) stats->dpu_cycles_max = dpu_cycles;
+        dpu_cycles_sum += dpu_cycles;
+    }
+    stats->dpu_cycles_mean = dpu_cycles_sum / num_dpus;
+    stats->tasklet_cycles_mean = tasklet_cycles_sum / ((double)num_dpus * nr_tasklets);
+    return 0;
+}
+
+void pim_dpu_stats_free(pim_dpu_stats_t* stats) {
+    if (!stats) return;
+    free(stats->tasklets);
+    stats->tasklets = NULL;
+}
+
+void pim_dpu_stats_print(const pim_dpu_stats_t* stats, FILE* stream) {
+    if (!stats || !stream) return;
+    uint64_t mram_cycles = stats->mram_read_cycles + stats->mram_write_cycles;
+    uint64_t busy_cycles = mram_cycles + stats->compute_cycles;
+    fprintf(stream, "DPU cycles over %u DPUs: min %llu, max %llu, mean %.1f, imbalance %.2f\n",
+            stats->num_dpus, (unsigned long long)stats->dpu_cycles_min, (unsigned long long)stats->dpu_cycles_max,
+            stats->dpu_cycles_mean, stats->dpu_cycles_mean > 0 ? stats->dpu_cycles_max / stats->dpu_cycles_mean : 0.0);
+    fprintf(stream, "Tasklet cycles over %u tasklets: min %llu, max %llu, mean %.1f\n",
+            stats->num_dpus * stats->nr_tasklets, (unsigned long long)stats->tasklet_cycles_min,
+            (unsigned long long)stats->tasklet_cycles_max, stats->tasklet_cycles_mean);
+    fprintf(stream, "MRAM read %llu, MRAM write %llu, compute %llu cycles (%.1f%% MRAM)\n",
+            (unsigned long long)stats->mram_read_cycles, (unsigned long long)stats->mram_write_cycles,
+            (unsigned long long)stats->compute_cycles, busy_cycles ? 100.0 * mram_cycles / busy_cycles : 0.0);
+}
@@ -0,0 +1,57 @@
+#ifndef __PIM_DPU_STATS_H___
+#define __PIM_DPU_STATS_H___
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <dpu.h>
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+/**
+ * @brief DPU cycle counters of the last launch, per tasklet and aggregated.
+ * @details A DPU finishes when its slowest tasklet finishes, so the cycles of a DPU are the largest `total_cycles` of
+ *          its tasklets. The min/max/mean over DPUs show the imbalance of the work split; the min/max/mean over all
+ *          tasklets show the imbalance inside the DPUs. MRAM and compute cycles are summed over all tasklets.
+ */
+typedef struct {
+    uint32_t num_dpus;
+    uint32_t nr_tasklets;
+    dpu_pim_tasklet_stats_t* tasklets;   ///< num_dpus x nr_tasklets counters, tasklets of a DPU are contiguous
+    uint64_t dpu_cycles_min;             ///< Cycles of the fastest DPU
+    uint64_t dpu_cycles_max;             ///< Cycles of the slowest DPU
+    double dpu_cycles_mean;              ///< Mean cycles of a DPU
+    uint64_t tasklet_cycles_min;         ///< Cycles of the fastest tasklet
+    uint64_t tasklet_cycles_max;         ///< Cycles of the slowest tasklet
+    double tasklet_cycles_mean;          ///< Mean cycles of a tasklet
+    uint64_t mram_read_cycles;           ///< MRAM to WRAM transfer cycles of all tasklets
+    uint64_t mram_write_cycles;          ///< WRAM to MRAM transfer cycles of all tasklets
+    uint64_t compute_cycles;             ///< Compute cycles of all tasklets
+} pim_dpu_stats_t;
+
+/**
+ * @brief Pull the tasklet counters of a DPU set after a launch and aggregate them.
+ * @details The counters are reset by the DPU program at the start of every launch, so this reports the last launch.
+ *          Counters are all zero when the DPU program is built with `PIM_ENABLE_STATS=0`.
+ * @param dpu_set DPU set that ran the program.
+ * @param num_dpus Number of DPUs in the set.
+ * @param nr_tasklets Number of tasklets the DPU program is built for.
+ * @param stats Destination; release it with `pim_dpu_stats_free`.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_dpu_stats_collect(struct dpu_set_t dpu_set, uint32_t num_dpus, uint32_t nr_tasklets, pim_dpu_stats_t* stats);
+
+/**
+ * @brief Release the per-tasklet counters of collected stats.
+ * @param stats Stats filled by `pim_dpu_stats_collect`.
+ */
+void pim_dpu_stats_free(pim_dpu_stats_t* stats);
+
+/**
+ * @brief Print a summary of collected stats.
+ * @param stats Stats filled by `pim_dpu_stats_collect`.
+ * @param stream Output stream.
+ */
+void pim_dpu_stats_print(const pim_dpu_stats_t* stats, FILE* stream);
+
+#endif // __PIM_DPU_STATS_H___
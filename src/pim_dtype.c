@@ -0,0 +1,116 @@
+#include <string.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pim_dtype.h"
+
+static const char* dtype_names[DPU_PIM_NUM_DTYPES] = {
+    [DPU_PIM_DTYPE_INT8] = "int8",
+    [DPU_PIM_DTYPE_UINT8] = "uint8",
+    [DPU_PIM_DTYPE_INT16] = "int16",
+    [DPU_PIM_DTYPE_UINT16] = "uint16",
+    [DPU_PIM_DTYPE_INT32] = "int32",
+    [DPU_PIM_DTYPE_UINT32] = "uint32",
+    [DPU_PIM_DTYPE_INT64] = "int64",
+};
+
+static const uint32_t dtype_sizes[DPU_PIM_NUM_DTYPES] = {
+    [DPU_PIM_DTYPE_INT8] = sizeof(int8_t),
+    [DPU_PIM_DTYPE_UINT8] = sizeof(uint8_t),
+    [DPU_PIM_DTYPE_INT16] = sizeof(int16_t),
+    [DPU_PIM_DTYPE_UINT16] = sizeof(uint16_t),
+    [DPU_PIM_DTYPE_INT32] = sizeof(int32_t),
+    [DPU_PIM_DTYPE_UINT32] = sizeof(uint32_t),
+    [DPU_PIM_DTYPE_INT64] = sizeof(int64_t),
+};
+
+uint32_t pim_dtype_size(dpu_pim_dtype_t dtype) {
+    if ((uint32_t)dtype >= DPU_PIM_NUM_DTYPES) return 0;
+    return dtype_sizes[dtype];
+}
+
+const char* pim_dtype_name(dpu_pim_dtype_t dtype) {
+    if ((uint32_t)dtype >= DPU_PIM_NUM_DTYPES) return "unknown";
+    return dtype_names[dtype];
+}
+
+int pim_dtype_from_name(const char* name, dpu_pim_dtype_t* dtype) {
+    if (!name || !dtype) return -1;
+    for (uint32_t i = 0; i < DPU_PIM_NUM_DTYPES; i++) {
+        if (strcmp(name, dtype_names[i]) == 0) {
+            *dtype = (dpu_pim_dtype_t)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int operand_dtype_from_size(uint32_t type_size, dpu_pim_dtype_t* dtype) {
+    switch (type_size) {
+        case 1: *dtype = DPU_PIM_DTYPE_UINT8; return 0;
+        case 2: *dtype = DPU_PIM_DTYPE_INT16; return 0;
+        case 4: *dtype = DPU_PIM_DTYPE_INT32; return 0;
+        default: return -1;
+    }
+}
+
+int pim_dtype_from_sizes(uint32_t matrix1_type_size, uint32_t matrix2_type_size, uint32_t result_type_size,
+                         dpu_pim_dtype_t* matrix1_dtype, dpu_pim_dtype_t* matrix2_dtype, dpu_pim_dtype_t* result_dtype) {
+    if (!matrix1_dtype || !matrix2_dtype || !result_dtype) return -1;
+    if (operand_dtype_from_size(matrix1_type_size, matrix1_dtype) != 0) return -1;
+    if (operand_dtype_from_size(matrix2_type_size, matrix2_dtype) != 0) return -1;
+    switch (result_type_size) {
+        case 2: *result_dtype = DPU_PIM_DTYPE_UINT16; return 0;
+        case 4: *result_dtype = DPU_PIM_DTYPE_INT32; return 0;
+        case 8: *result_dtype = DPU_PIM_DTYPE_INT64; return 0;
+        default: return -1;
+    }
+}
+
+static bool is_byte_dtype(dpu_pim_dtype_t dtype) {
+    return dtype == DPU_PIM_DTYPE_INT8 || dtype == DPU_PIM_DTYPE_UINT8;
+}
+
+bool pim_dtype_gemm_supported(dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype) {
+    if (is_byte_dtype(matrix1_dtype) && is_byte_dtype(matrix2_dtype)) {
+        return result_dtype == DPU_PIM_DTYPE_INT32 ||
+               (result_dtype == DPU_PIM_DTYPE_UINT16 && matrix1_dtype == DPU_PIM_DTYPE_UINT8 && matrix2_dtype == DPU_PIM_DTYPE_UINT8);
+    }
+    if (matrix1_dtype == DPU_PIM_DTYPE_INT16 && matrix2_dtype == DPU_PIM_DTYPE_INT16) {
+        return result_dtype == DPU_PIM_DTYPE_INT32 || result_dtype == DPU_PIM_DTYPE_INT64;
+    }
+    if (matrix1_dtype == DPU_PIM_DTYPE_INT32 && matrix2_dtype == DPU_PIM_DTYPE_INT32) {
+        return result_dtype == DPU_PIM_DTYPE_INT32;
+    }
+    return false;
+}
+
+bool pim_dtype_is_signed(dpu_pim_dtype_t dtype) {
+    return dtype == DPU_PIM_DTYPE_INT8 || dtype == DPU_PIM_DTYPE_INT16 ||
+           dtype == DPU_PIM_DTYPE_INT32 || dtype == DPU_PIM_DTYPE_INT64;
+}
+
+static int64_t load_value(const uint8_t* data, size_t index, dpu_pim_dtype_t dtype) {
+    switch (dtype) {
+        case DPU_PIM_DTYPE_INT8: return ((const int8_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT8: return data[index];
+        case DPU_PIM_DTYPE_INT16: return ((const int16_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT16: return ((const uint16_t*)data)[index];
+        case DPU_PIM_DTYPE_INT32: return ((const int32_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT32: return ((const uint32_t*)data)[index];
+        default: return ((const int64_t*)data)[index];
+    }
+}
+
+bool pim_dtype_values_fit_bits(dpu_pim_dtype_t dtype, const void* data, size_t count, uint32_t bits) {
+    if (!data || bits == 0 || (uint32_t)dtype >= DPU_PIM_NUM_DTYPES) return false;
+    if (bits >= 8 * dtype_sizes[dtype]) return true;
+    int64_t min = pim_dtype_is_signed(dtype) ? -((int64_t)1 << (bits - 1)) : 0;
+    int64_t max = pim_dtype_is_signed(dtype) ? ((int64_t)1 << (bits - 1)) - 1 : ((int64_t)1 << bits) - 1;
+    for (size_t i = 0; i < count; i++) {
+        int64_t value = load_value((const uint8_t*)data, i, dtype);
+        if (value < min || value > max) return false;
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef __PIM_DTYPE_H___
+#define __PIM_DTYPE_H___
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+/**
+ * @brief Get the size in bytes of an element type.
+ * @param dtype Element type.
+ * @return Size in bytes, or 0 for an unknown type.
+ */
+uint32_t pim_dtype_size(dpu_pim_dtype_t dtype);
+
+/**
+ * @brief Get the name of an element type ("int8", "uint8", ...).
+ * @param dtype Element type.
+ * @return Static string with the name, or "unknown".
+ */
+const char* pim_dtype_name(dpu_pim_dtype_t dtype);
+
+/**
+ * @brief Parse an element type name as written by `pim_dtype_name`.
+ * @param name Name of the element type.
+ * @param dtype Pointer to store the parsed type.
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int pim_dtype_from_name(const char* name, dpu_pim_dtype_t* dtype);
+
+/**
+ * @brief Map the element sizes used by the size-based frame API to element types.
+ * @details Operands of 1 byte are uint8 and wider operands are signed; a 2-byte result is uint16 and wider
+ *          results are signed, which matches the behaviour of the size-based API before element types existed.
+ * @param matrix1_type_size Size of first matrix elements.
+ * @param matrix2_type_size Size of second matrix elements.
+ * @param result_type_size Size of result matrix elements.
+ * @param matrix1_dtype Pointer to store the first matrix element type.
+ * @param matrix2_dtype Pointer to store the second matrix element type.
+ * @param result_dtype Pointer to store the result element type.
+ * @return 0 on success, -1 if a size has no matching element type.
+ */
+int pim_dtype_from_sizes(uint32_t matrix1_type_size, uint32_t matrix2_type_size, uint32_t result_type_size,
+                         dpu_pim_dtype_t* matrix1_dtype, dpu_pim_dtype_t* matrix2_dtype, dpu_pim_dtype_t* result_dtype);
+
+/**
+ * @brief Check whether a GEMM element type combination is supported.
+ * @details Supported combinations are int8/uint8 x int8/uint8 -> int32, int16 x int16 -> int32/int64,
+ *          int32 x int32 -> int32 and the legacy uint8 x uint8 -> uint16.
+ * @param matrix1_dtype Element type of the first matrix.
+ * @param matrix2_dtype Element type of the second matrix.
+ * @param result_dtype Element type of the result matrix.
+ * @return true if the combination is supported, false otherwise.
+ */
+bool pim_dtype_gemm_supported(dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype);
+
+/**
+ * @brief Check whether an element type is signed.
+ * @param dtype Element type.
+ * @return true for the signed integer types, false otherwise.
+ */
+bool pim_dtype_is_signed(dpu_pim_dtype_t dtype);
+
+/**
+ * @brief Check whether every element of an array fits an integer of a given width.
+ * @details Elements of signed types must lie in [-2^(bits-1), 2^(bits-1) - 1] and elements of unsigned types in
+ *          [0, 2^bits - 1]. Used to pick kernels specialised for small value ranges, e.g. DPU_PIM_GEMM_LUT.
+ * @param dtype Element type of the array.
+ * @param data Elements to check.
+ * @param count Number of elements.
+ * @param bits Width in bits.
+ * @return true if all elements fit, false otherwise or on invalid arguments.
+ */
+bool pim_dtype_values_fit_bits(dpu_pim_dtype_t dtype, const void* data, size_t count, uint32_t bits);
+
+#endif // __PIM_DTYPE_H___
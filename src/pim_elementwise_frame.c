@@ -0,0 +1,228 @@
+#include <string.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <dpu.h>
+
+#include <matrix.h>
+
+#include "dpu_pim_matrix_multiply_kernel_arguments.h"
+
+#include "pim_dpu_pool.h"
+#include "pim_kernel_registry.h"
+#include "pim_dtype.h"
+#include "pim_dpu_stats.h"
+#include "pim_log.h"
+#include "pim_stats.h"
+#include "pim_trace.h"
+
+#include "pim_elementwise_frame.h"
+
+pim_elementwise_frame_t* create_pim_elementwise_frame(uint32_t num_dpus, uint32_t dpu_offset, uint32_t rows, uint32_t cols,
+                                                      dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype,
+                                                      dpu_pim_dtype_t result_dtype) {
+    if (num_dpus == 0 || rows == 0 || cols == 0) {
+        PIM_LOG_ERROR("Invalid elementwise frame dimensions");
+        return NULL;
+    }
+    if (!pim_dtype_gemm_supported(matrix1_dtype, matrix2_dtype, result_dtype)) {
+        PIM_LOG_ERROR("Unsupported element types %s x %s -> %s",
+                      pim_dtype_name(matrix1_dtype), pim_dtype_name(matrix2_dtype), pim_dtype_name(result_dtype));
+        return NULL;
+    }
+
+    pim_elementwise_frame_t* frame = (pim_elementwise_frame_t*)malloc(sizeof(pim_elementwise_frame_t));
+    if (!frame) {
+        return NULL;
+    }
+
+    uint32_t rows_per_dpu = (rows + num_dpus - 1) / num_dpus;
+    rows_per_dpu = (rows_per_dpu + DPU_PIM_REDUCE_ROWS_PER_WRITE - 1) / DPU_PIM_REDUCE_ROWS_PER_WRITE * DPU_PIM_REDUCE_ROWS_PER_WRITE;
+    uint32_t cols_aligned = (cols + 7) & ~7u;
+
+    frame->num_dpus = num_dpus;
+    frame->rows = rows;
+    frame->cols = cols;
+    frame->rows_per_dpu = rows_per_dpu;
+    frame->cols_aligned = cols_aligned;
+    frame->matrix1_dtype = matrix1_dtype;
+    frame->matrix2_dtype = matrix2_dtype;
+    frame->result_dtype = result_dtype;
+
+    // The result region is sized for the larger of the two results, a full slice of sums
+    uint32_t curr_offset = dpu_offset;
+    frame->matrix1_start_offset = curr_offset;
+    curr_offset += rows_per_dpu * cols_aligned * pim_dtype_size(matrix1_dtype);
+    frame->matrix2_start_offset = curr_offset;
+    curr_offset += rows_per_dpu * cols_aligned * pim_dtype_size(matrix2_dtype);
+    frame->result_start_offset = curr_offset;
+    curr_offset += rows_per_dpu * cols_aligned * pim_dtype_size(result_dtype);
+    frame->mem_frame_end = curr_offset;
+
+    frame->result_op = DPU_PIM_OP_ELEMENTWISE_ADD;
+    frame->result_valid = false;
+
+    const pim_kernel_descriptor_t* kernel = pim_kernel_registry_select(matrix1_dtype, matrix2_dtype, result_dtype, rows_per_dpu, cols_aligned);
+    if (!kernel) {
+        PIM_LOG_ERROR("No DPU kernel registered for element types %s x %s -> %s",
+                      pim_dtype_name(matrix1_dtype), pim_dtype_name(matrix2_dtype), pim_dtype_name(result_dtype));
+        free(frame);
+        return NULL;
+    }
+    frame->kernel = *kernel;
+
+    frame->dpu_pool_entry = pim_dpu_pool_acquire(num_dpus, frame->kernel.binary);
+    if (!frame->dpu_pool_entry) {
+        PIM_LOG_ERROR("Failed to acquire %u DPUs for PIM elementwise frame", num_dpus);
+        free(frame);
+        return NULL;
+    }
+    frame->dpu_set = frame->dpu_pool_entry->dpu_set;
+    if (pim_kernel_registry_read_plan(frame->dpu_set, &frame->kernel, &frame->kernel_plan) != 0) {
+        pim_dpu_pool_release(frame->dpu_pool_entry);
+        free(frame);
+        return NULL;
+    }
+
+    return frame;
+}
+
+void destroy_pim_elementwise_frame(pim_elementwise_frame_t* frame) {
+    if (!frame) return;
+    pim_dpu_pool_release(frame->dpu_pool_entry);
+    free(frame);
+}
+
+/**
+ * @brief Scatter one zero-padded row slice of a matrix to every DPU.
+ */
+static int load_matrix(pim_elementwise_frame_t* frame, const Matrix* matrix, dpu_pim_dtype_t dtype, uint32_t offset) {
+    uint32_t element_size = pim_dtype_size(dtype);
+    if ((uint32_t)matrix->rows != frame->rows || (uint32_t)matrix->cols != frame->cols || matrix->element_size != element_size) {
+        PIM_LOG_ERROR("Matrix does not match the PIM elementwise frame");
+        return -1;
+    }
+
+    // One zero-padded row slice per DPU, laid out back to back
+    uint32_t row_size = frame->cols_aligned * element_size;
+    uint32_t slice_size = frame->rows_per_dpu * row_size;
+    uint8_t* slices = (uint8_t*)calloc(frame->num_dpus, slice_size);
+    if (!slices) {
+        PIM_LOG_ERROR("Failed to allocate memory for elementwise matrix slices");
+        return -1;
+    }
+    for (uint32_t r = 0; r < frame->rows; r++) {
+        memcpy(slices + r * row_size, matrix_get_row(matrix, r), frame->cols * element_size);
+    }
+
+    uint32_t i;
+    struct dpu_set_t dpu;
+    DPU_FOREACH(frame->dpu_set, dpu, i) {
+        DPU_ASSERT(dpu_prepare_xfer(dpu, slices + (size_t)i * slice_size));
+    }
+    DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_TO_DPU, DPU_MRAM_HEAP_POINTER_NAME, offset, slice_size, DPU_XFER_DEFAULT));
+    free(slices);
+    frame->result_valid = false; // Reset result validity after loading new matrix
+    return 0;
+}
+
+int pim_elementwise_frame_load_first_matrix(pim_elementwise_frame_t* frame, const Matrix* matrix) {
+    if (!frame || !matrix) return -1;
+    return load_matrix(frame, matrix, frame->matrix1_dtype, frame->matrix1_start_offset);
+}
+
+int pim_elementwise_frame_load_second_matrix(pim_elementwise_frame_t* frame, const Matrix* matrix) {
+    if (!frame || !matrix) return -1;
+    return load_matrix(frame, matrix, frame->matrix2_dtype, frame->matrix2_start_offset);
+}
+
+/**
+ * @brief Launch one elementwise operation on the resident slices and read back the DPU status.
+ */
+static int execute_op(pim_elementwise_frame_t* frame, dpu_pim_opcode_t opcode, const char* name) {
+    dpu_pim_matrix_multiply_kernel_arguments_t input_args = {0};
+    input_args.opcode = opcode;
+    input_args.matrix1_start_offset = frame->matrix1_start_offset;
+    input_args.matrix2_start_offset = frame->matrix2_start_offset;
+    input_args.result_start_offset = frame->result_start_offset;
+    input_args.matrix1_rows = frame->rows_per_dpu;
+    input_args.matrix1_cols = frame->cols_aligned;
+    input_args.matrix2_rows = frame->rows_per_dpu;
+    input_args.matrix2_cols = frame->cols_aligned;
+    input_args.result_rows = frame->rows_per_dpu;
+    input_args.result_cols = opcode == DPU_PIM_OP_REDUCE_ROWS ? 1 : frame->cols_aligned;
+    input_args.matrix1_type_size = pim_dtype_size(frame->matrix1_dtype);
+    input_args.matrix2_type_size = pim_dtype_size(frame->matrix2_dtype);
+    input_args.result_type_size = pim_dtype_size(frame->result_dtype);
+    input_args.matrix1_dtype = frame->matrix1_dtype;
+    input_args.matrix2_dtype = frame->matrix2_dtype;
+    input_args.result_dtype = frame->result_dtype;
+    input_args.output_dtype = frame->result_dtype;
+
+    DPU_ASSERT(dpu_broadcast_to(frame->dpu_set, "MATRIX_MULTIPLY_ARGUMENTS", 0, &input_args,
+                                sizeof(dpu_pim_matrix_multiply_kernel_arguments_t), DPU_XFER_DEFAULT));
+    uint64_t launch_start = pim_stats_now_ns();
+    DPU_ASSERT(dpu_launch(frame->dpu_set, DPU_SYNCHRONOUS));
+    int status = pim_kernel_registry_read_status(frame->dpu_set, frame->num_dpus);
+    if (pim_trace_enabled()) {
+        pim_trace_host_event(name, "host", launch_start, pim_stats_now_ns(), NULL, 0);
+        pim_dpu_stats_t dpu_stats;
+        if (pim_dpu_stats_collect(frame->dpu_set, frame->num_dpus, frame->kernel.nr_tasklets, &dpu_stats) == 0) {
+            pim_trace_dpu_launch(name, launch_start, &dpu_stats);
+            pim_dpu_stats_free(&dpu_stats);
+        }
+    }
+
+    frame->result_op = opcode;
+    frame->result_valid = status == 0;
+    return status;
+}
+
+int pim_elementwise_frame_add(pim_elementwise_frame_t* frame) {
+    if (!frame) return -1;
+    return execute_op(frame, DPU_PIM_OP_ELEMENTWISE_ADD, "elementwise_add");
+}
+
+int pim_elementwise_frame_reduce_rows(pim_elementwise_frame_t* frame) {
+    if (!frame) return -1;
+    return execute_op(frame, DPU_PIM_OP_REDUCE_ROWS, "reduce_rows");
+}
+
+int pim_elementwise_frame_get_result(pim_elementwise_frame_t* frame, void* result) {
+    if (!frame || !result) return -1;
+    if (!frame->result_valid) {
+        PIM_LOG_ERROR("PIM elementwise frame has no valid result");
+        return -1;
+    }
+
+    uint32_t element_size = pim_dtype_size(frame->result_dtype);
+    uint32_t row_elements = frame->result_op == DPU_PIM_OP_REDUCE_ROWS ? 1 : frame->cols_aligned;
+    uint32_t slice_size = frame->rows_per_dpu * row_elements * element_size;
+    uint8_t* slices = (uint8_t*)malloc((size_t)frame->num_dpus * slice_size);
+    if (!slices) {
+        PIM_LOG_ERROR("Failed to allocate memory for elementwise result slices");
+        return -1;
+    }
+
+    uint32_t i;
+    struct dpu_set_t dpu;
+    DPU_FOREACH(frame->dpu_set, dpu, i) {
+        DPU_ASSERT(dpu_prepare_xfer(dpu, slices + (size_t)i * slice_size));
+    }
+    DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_FROM_DPU, DPU_MRAM_HEAP_POINTER_NAME, frame->result_start_offset, slice_size, DPU_XFER_DEFAULT));
+
+    // Slices are contiguous row ranges, so only the column padding has to be dropped
+    if (frame->result_op == DPU_PIM_OP_REDUCE_ROWS) {
+        memcpy(result, slices, (size_t)frame->rows * element_size);
+    } else {
+        for (uint32_t r = 0; r < frame->rows; r++) {
+            memcpy((uint8_t*)result + (size_t)r * frame->cols * element_size,
+                   slices + (size_t)r * frame->cols_aligned * element_size, (size_t)frame->cols * element_size);
+        }
+    }
+    free(slices);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#ifndef __PIM_ELEMENTWISE_FRAME_H___
+#define __PIM_ELEMENTWISE_FRAME_H___
+
+#include <dpu.h>
+
+#include <matrix.h>
+
+#include "pim_dpu_pool.h"
+#include "pim_kernel_registry.h"
+#include "pim_dtype.h"
+#include "pim_dpu_stats.h"
+
+/**
+ * @brief State of the elementwise operations of the multiplexed DPU program on a PIM architecture.
+ * @details Both matrices are split by rows across all DPUs and stay resident in MRAM, so an addition and a row
+ *          reduction can run on the same data without reloading it. Every DPU streams its rows at full MRAM
+ *          bandwidth; no data moves between DPUs.
+ */
+typedef struct {
+    uint32_t num_dpus;
+    uint32_t rows;                    ///< Rows of both matrices
+    uint32_t cols;                    ///< Columns of both matrices
+    uint32_t rows_per_dpu;            ///< Rows held by each DPU, padded to DPU_PIM_REDUCE_ROWS_PER_WRITE
+    uint32_t cols_aligned;            ///< Columns padded so that every row is a multiple of 8 elements
+    dpu_pim_dtype_t matrix1_dtype;    ///< Element type of the first matrix
+    dpu_pim_dtype_t matrix2_dtype;    ///< Element type of the second matrix
+    dpu_pim_dtype_t result_dtype;     ///< Element type of the result
+    uint32_t matrix1_start_offset;    ///< MRAM offset for the first matrix slice
+    uint32_t matrix2_start_offset;    ///< MRAM offset for the second matrix slice
+    uint32_t result_start_offset;     ///< MRAM offset for the result slice
+    uint32_t mem_frame_end;           ///< MRAM offset for end of memory frame
+    dpu_pim_opcode_t result_op;       ///< Operation that produced the result, which sets its shape
+    bool result_valid;                ///< Flag indicating if result is valid
+    struct dpu_set_t dpu_set;         ///< DPU set for execution
+    pim_dpu_pool_entry_t* dpu_pool_entry; ///< Pool entry owning the DPU set
+    pim_kernel_descriptor_t kernel;   ///< DPU kernel selected for the frame
+    dpu_pim_kernel_plan_t kernel_plan; ///< WRAM plan of the kernel binary, read when the frame is created
+} pim_elementwise_frame_t;
+
+/**
+ * @brief Create a new PIM elementwise frame over two rows x cols matrices.
+ * @details Rows are distributed evenly across the DPUs in groups of DPU_PIM_REDUCE_ROWS_PER_WRITE. The kernel binary
+ *          is selected from the kernel registry for the element types and the DPU set is taken from the DPU pool.
+ * @param num_dpus Number of DPUs to use.
+ * @param dpu_offset Offset for DPU memory.
+ * @param rows Number of rows in both matrices.
+ * @param cols Number of columns in both matrices.
+ * @param matrix1_dtype Element type of the first matrix.
+ * @param matrix2_dtype Element type of the second matrix.
+ * @param result_dtype Element type of the result.
+ * @return Pointer to the new frame, or NULL on failure.
+ */
+pim_elementwise_frame_t* create_pim_elementwise_frame(uint32_t num_dpus, uint32_t dpu_offset, uint32_t rows, uint32_t cols,
+                                                      dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype,
+                                                      dpu_pim_dtype_t result_dtype);
+
+/**
+ * @brief Destroy a PIM elementwise frame.
+ * @details The DPU set is returned to the DPU pool (not freed) and the frame memory is released.
+ * @param frame Pointer to the PIM elementwise frame.
+ */
+void destroy_pim_elementwise_frame(pim_elementwise_frame_t* frame);
+
+/**
+ * @brief Load the first matrix into the frame, splitting it by rows across the DPUs.
+ * @param frame Pointer to the PIM elementwise frame.
+ * @param matrix Pointer to a rows x cols matrix.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_elementwise_frame_load_first_matrix(pim_elementwise_frame_t* frame, const Matrix* matrix);
+
+/**
+ * @brief Load the second matrix into the frame, splitting it by rows across the DPUs.
+ * @details Only the addition reads the second matrix.
+ * @param frame Pointer to the PIM elementwise frame.
+ * @param matrix Pointer to a rows x cols matrix.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_elementwise_frame_load_second_matrix(pim_elementwise_frame_t* frame, const Matrix* matrix);
+
+/**
+ * @brief Compute result = first matrix + second matrix on the PIM architecture.
+ * @details After the launch the status published by every DPU is read back; if any DPU failed, the frame holds no
+ *          valid result.
+ * @param frame Pointer to the PIM elementwise frame.
+ * @return 0 on success, -1 if any DPU reported a failure.
+ */
+int pim_elementwise_frame_add(pim_elementwise_frame_t* frame);
+
+/**
+ * @brief Compute result[r] = sum of row r of the first matrix on the PIM architecture.
+ * @details Sums are accumulated at the accumulator width of the kernel and truncated to the result type.
+ * @param frame Pointer to the PIM elementwise frame.
+ * @return 0 on success, -1 if any DPU reported a failure.
+ */
+int pim_elementwise_frame_reduce_rows(pim_elementwise_frame_t* frame);
+
+/**
+ * @brief Get the result of the last operation.
+ * @details The result is only valid after `pim_elementwise_frame_add` or `pim_elementwise_frame_reduce_rows`. The
+ *          valid flag resets when a matrix is loaded.
+ * @param frame Pointer to the PIM elementwise frame.
+ * @param result Row-major rows x cols elements after an addition, `rows` elements after a row reduction, of the
+ *               result element type.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_elementwise_frame_get_result(pim_elementwise_frame_t* frame, void* result);
+
+#endif // __PIM_ELEMENTWISE_FRAME_H___
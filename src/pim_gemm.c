@@ -0,0 +1,87 @@
+#include <string.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pim_dtype.h"
+#include "pim_matrix_multiplication_frame.h"
+#include "pim_log.h"
+
+#include "pim_gemm.h"
+
+static uint32_t gemm_num_dpus = PIM_GEMM_NUM_DPUS;
+
+void pim_gemm_set_num_dpus(uint32_t num_dpus) {
+    gemm_num_dpus = num_dpus ? num_dpus : PIM_GEMM_NUM_DPUS;
+}
+
+int pim_gemm(pim_transpose_t trans_a, pim_transpose_t trans_b, uint32_t m, uint32_t n, uint32_t k,
+             int32_t alpha, const int8_t* a, uint32_t lda, const int8_t* b, uint32_t ldb,
+             int32_t beta, int32_t* c, uint32_t ldc) {
+    if (!c || ldc < n) {
+        PIM_LOG_ERROR("Invalid GEMM output matrix");
+        return -1;
+    }
+    if (m == 0 || n == 0) return 0;
+
+    // Nothing to multiply: C is only scaled, as in BLAS
+    if (k == 0 || alpha == 0) {
+        for (uint32_t i = 0; i < m; i++) {
+            for (uint32_t j = 0; j < n; j++) {
+                c[(size_t)i * ldc + j] = beta ? (int32_t)((uint32_t)beta * (uint32_t)c[(size_t)i * ldc + j]) : 0;
+            }
+        }
+        return 0;
+    }
+    if (!a || !b) {
+        PIM_LOG_ERROR("Invalid GEMM input matrices");
+        return -1;
+    }
+
+    int status = -1;
+    int32_t* product = NULL;
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(gemm_num_dpus, 0, m, k, k, n, m, n,
+                                                                                           DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+    if (!frame) {
+        PIM_LOG_ERROR("Failed to create PIM frame for GEMM");
+        goto cleanup;
+    }
+    if (pim_matrix_multiplication_frame_load_first_matrix_strided(frame, a, lda, trans_a == PIM_TRANS) != 0 ||
+        pim_matrix_multiplication_frame_load_second_matrix_strided(frame, b, ldb, trans_b == PIM_TRANS) != 0) {
+        goto cleanup;
+    }
+    if (pim_matrix_multiplication_frame_execute(frame) != 0) {
+        PIM_LOG_ERROR("PIM GEMM kernel failed");
+        goto cleanup;
+    }
+
+    if (alpha == 1 && beta == 0) {
+        status = pim_matrix_multiplication_frame_get_result_into(frame, c, ldc);
+        goto cleanup;
+    }
+
+    product = (int32_t*)malloc((size_t)m * n * sizeof(int32_t));
+    if (!product) {
+        PIM_LOG_ERROR("Failed to allocate memory for GEMM product");
+        goto cleanup;
+    }
+    if (pim_matrix_multiplication_frame_get_result_into(frame, product, n) != 0) {
+        goto cleanup;
+    }
+    // Unsigned arithmetic keeps the int32 wrap-around well defined
+    for (uint32_t i = 0; i < m; i++) {
+        for (uint32_t j = 0; j < n; j++) {
+            uint32_t value = (uint32_t)alpha * (uint32_t)product[(size_t)i * n + j];
+            if (beta) value += (uint32_t)beta * (uint32_t)c[(size_t)i * ldc + j];
+            c[(size_t)i * ldc + j] = (int32_t)value;
+        }
+    }
+    status = 0;
+
+cleanup:
+    if (product) free(product);
+    if (frame) destroy_pim_matrix_multiplication_frame(frame);
+    return status;
+}
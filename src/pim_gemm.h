@@ -0,0 +1,50 @@
+#ifndef __PIM_GEMM_H___
+#define __PIM_GEMM_H___
+
+#include <stdint.h>
+
+#ifndef PIM_GEMM_NUM_DPUS
+#define PIM_GEMM_NUM_DPUS 64
+#endif
+
+/**
+ * @brief Operand transposition, as in BLAS.
+ */
+typedef enum {
+    PIM_NO_TRANS = 0,   ///< Use the operand as stored
+    PIM_TRANS = 1,      ///< Use the transpose of the stored operand
+} pim_transpose_t;
+
+/**
+ * @brief Set the number of DPUs used by `pim_gemm`.
+ * @param num_dpus Number of DPUs, 0 restores PIM_GEMM_NUM_DPUS.
+ */
+void pim_gemm_set_num_dpus(uint32_t num_dpus);
+
+/**
+ * @brief BLAS-style integer GEMM on PIM: C = alpha * op(A) * op(B) + beta * C.
+ * @details All matrices are row-major. op(A) is M x K and op(B) is K x N; transposition is applied while the operands
+ *          are packed into the per-DPU slices, so no transposed copy is made on the host. A frame is created per call
+ *          on top of the DPU pool, so repeated calls reuse the allocated DPUs and the resident kernel.
+ *          When alpha is 1 and beta is 0 the DPU tiles are copied straight into C; otherwise C is updated on the host
+ *          after the product is pulled. Arithmetic wraps on int32 overflow.
+ * @param trans_a Whether op(A) is A or its transpose.
+ * @param trans_b Whether op(B) is B or its transpose.
+ * @param m Rows of op(A) and C.
+ * @param n Columns of op(B) and C.
+ * @param k Columns of op(A) and rows of op(B).
+ * @param alpha Scale of the product.
+ * @param a Elements of A, stored as M x K (K x M when transposed).
+ * @param lda Leading dimension (row stride in elements) of A.
+ * @param b Elements of B, stored as K x N (N x K when transposed).
+ * @param ldb Leading dimension (row stride in elements) of B.
+ * @param beta Scale of the existing C; C is not read when beta is 0.
+ * @param c Elements of C, M x N.
+ * @param ldc Leading dimension (row stride in elements) of C.
+ * @return 0 on success, -1 on failure; C is left unchanged when the DPU kernel fails.
+ */
+int pim_gemm(pim_transpose_t trans_a, pim_transpose_t trans_b, uint32_t m, uint32_t n, uint32_t k,
+             int32_t alpha, const int8_t* a, uint32_t lda, const int8_t* b, uint32_t ldb,
+             int32_t beta, int32_t* c, uint32_t ldc);
+
+#endif // __PIM_GEMM_H___
@@ -0,0 +1,107 @@
+#ifndef __PIM_GEMV_FRAME_H___
+#define __PIM_GEMV_FRAME_H___
+
+#include <dpu.h>
+
+#include <matrix.h>
+
+#include "pim_dpu_pool.h"
+#include "pim_kernel_registry.h"
+#include "pim_dtype.h"
+#include "pim_dpu_stats.h"
+
+/**
+ * @brief State of a matrix-vector product on a PIM architecture.
+ * @details The matrix is split by rows across all DPUs and stays resident in MRAM, while the vector is broadcast to
+ *          every DPU. Unlike a GEMM frame with one column, no DPU holds a padded column slice, so every DPU streams
+ *          its rows at full MRAM bandwidth.
+ */
+typedef struct {
+    uint32_t num_dpus;
+    uint32_t rows;                    ///< Rows of the matrix and of the result vector
+    uint32_t cols;                    ///< Columns of the matrix and length of the input vector
+    uint32_t rows_per_dpu;            ///< Matrix rows held by each DPU, padded to DPU_PIM_GEMV_ROWS_PER_WRITE
+    uint32_t cols_aligned;            ///< Columns padded so that every row and the vector are 8-byte aligned
+    dpu_pim_dtype_t matrix_dtype;     ///< Element type of the matrix
+    dpu_pim_dtype_t vector_dtype;     ///< Element type of the input vector
+    dpu_pim_dtype_t result_dtype;     ///< Element type of the result vector
+    uint32_t matrix_start_offset;     ///< MRAM offset for the matrix slice
+    uint32_t vector_start_offset;     ///< MRAM offset for the vector
+    uint32_t result_start_offset;     ///< MRAM offset for the result slice
+    uint32_t mem_frame_end;           ///< MRAM offset for end of memory frame
+    bool result_valid;                ///< Flag indicating if result is valid
+    struct dpu_set_t dpu_set;         ///< DPU set for execution
+    pim_dpu_pool_entry_t* dpu_pool_entry; ///< Pool entry owning the DPU set
+    pim_kernel_descriptor_t kernel;   ///< DPU kernel selected for the frame
+    dpu_pim_kernel_plan_t kernel_plan; ///< WRAM plan of the kernel binary, read when the frame is created
+} pim_gemv_frame_t;
+
+/**
+ * @brief Create a new PIM GEMV frame computing result = matrix * vector.
+ * @details Rows are distributed evenly across the DPUs in groups of DPU_PIM_GEMV_ROWS_PER_WRITE. The kernel binary is
+ *          selected from the kernel registry for the element types and the DPU set is taken from the DPU pool.
+ * @param num_dpus Number of DPUs to use.
+ * @param dpu_offset Offset for DPU memory.
+ * @param rows Number of rows in the matrix.
+ * @param cols Number of columns in the matrix (length of the vector).
+ * @param matrix_dtype Element type of the matrix.
+ * @param vector_dtype Element type of the vector.
+ * @param result_dtype Element type of the result.
+ * @return Pointer to the new frame, or NULL on failure (including vectors too large to stay resident in WRAM).
+ */
+pim_gemv_frame_t* create_pim_gemv_frame(uint32_t num_dpus, uint32_t dpu_offset, uint32_t rows, uint32_t cols,
+                                        dpu_pim_dtype_t matrix_dtype, dpu_pim_dtype_t vector_dtype, dpu_pim_dtype_t result_dtype);
+
+/**
+ * @brief Destroy a PIM GEMV frame.
+ * @details The DPU set is returned to the DPU pool (not freed) and the frame memory is released.
+ * @param frame Pointer to the PIM GEMV frame.
+ */
+void destroy_pim_gemv_frame(pim_gemv_frame_t* frame);
+
+/**
+ * @brief Load the matrix into the frame, splitting it by rows across the DPUs.
+ * @details The matrix stays resident, so several vectors can be multiplied without reloading it.
+ * @param frame Pointer to the PIM GEMV frame.
+ * @param matrix Pointer to a rows x cols matrix.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_gemv_frame_load_matrix(pim_gemv_frame_t* frame, const Matrix* matrix);
+
+/**
+ * @brief Broadcast the input vector to all DPUs.
+ * @param frame Pointer to the PIM GEMV frame.
+ * @param vector Array of `cols` elements of the vector element type.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_gemv_frame_load_vector(pim_gemv_frame_t* frame, const void* vector);
+
+/**
+ * @brief Execute the matrix-vector product on the PIM architecture.
+ * @details After the launch the status published by every DPU is read back; if any DPU failed, the frame holds no
+ *          valid result.
+ * @param frame Pointer to the PIM GEMV frame.
+ * @return 0 on success, -1 if any DPU reported a failure.
+ */
+int pim_gemv_frame_execute(pim_gemv_frame_t* frame);
+
+/**
+ * @brief Get the result vector of the matrix-vector product.
+ * @details The result is only valid after calling `pim_gemv_frame_execute`. The valid flag resets when a new matrix
+ *          or vector is loaded.
+ * @param frame Pointer to the PIM GEMV frame.
+ * @param result Array of `rows` elements of the result element type to fill.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_gemv_frame_get_result(pim_gemv_frame_t* frame, void* result);
+
+/**
+ * @brief Pull and aggregate the DPU cycle counters of the last execution.
+ * @details See `pim_dpu_stats_t`. Only valid after `pim_gemv_frame_execute`.
+ * @param frame Pointer to the PIM GEMV frame.
+ * @param stats Destination; release it with `pim_dpu_stats_free`.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_gemv_frame_get_dpu_stats(pim_gemv_frame_t* frame, pim_dpu_stats_t* stats);
+
+#endif // __PIM_GEMV_FRAME_H___
@@ -0,0 +1,346 @@
+#include <string.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <pthread.h>
+
+#include "pim_kernel_registry.h"
+#include "pim_log.h"
+
+#ifndef DPU_MATRIX_MULTIPLICATION_BIN
+#define DPU_MATRIX_MULTIPLICATION_BIN "/workspace/bin/matrix_multiply_dpu"
+#endif
+
+#ifndef DPU_KERNEL_MANIFEST
+#define DPU_KERNEL_MANIFEST "/workspace/bin/dpu_kernels.manifest"
+#endif
+
+#ifndef NR_TASKLETS
+#define NR_TASKLETS 16
+#endif
+
+static pim_kernel_descriptor_t* registry_kernels = NULL;
+static uint32_t registry_num_kernels = 0;
+static uint32_t registry_capacity = 0;
+static bool registry_initialized = false;
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static const char* const multiply_names[DPU_PIM_NUM_MULTIPLIES] = { "c", "builtin", "packed_builtin" };
+
+static int multiply_from_name(const char* name, dpu_pim_multiply_t* multiply) {
+    for (uint32_t i = 0; i < DPU_PIM_NUM_MULTIPLIES; i++) {
+        if (strcmp(name, multiply_names[i]) == 0) {
+            *multiply = (dpu_pim_multiply_t)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int registry_append(const pim_kernel_descriptor_t* kernel) {
+    if (registry_num_kernels == registry_capacity) {
+        uint32_t new_capacity = registry_capacity ? registry_capacity * 2 : 8;
+        pim_kernel_descriptor_t* new_kernels = (pim_kernel_descriptor_t*)realloc(registry_kernels, new_capacity * sizeof(pim_kernel_descriptor_t));
+        if (!new_kernels) {
+            PIM_LOG_ERROR("Failed to grow kernel registry");
+            return -1;
+        }
+        registry_kernels = new_kernels;
+        registry_capacity = new_capacity;
+    }
+    registry_kernels[registry_num_kernels++] = *kernel;
+    return 0;
+}
+
+static int registry_load_manifest(const char* manifest_path) {
+    FILE* manifest = fopen(manifest_path, "r");
+    if (!manifest) {
+        return -1;
+    }
+
+    registry_num_kernels = 0;
+    char line[1024];
+    uint32_t line_number = 0;
+    while (fgets(line, sizeof(line), manifest)) {
+        line_number++;
+        char* start = line;
+        while (*start == ' ' || *start == '\t') start++;
+        if (*start == '#' || *start == '\n' || *start == '\0') continue;
+
+        pim_kernel_descriptor_t kernel = {0};
+        char matrix1_dtype[16], matrix2_dtype[16], result_dtype[16], multiply[16] = "c";
+        kernel.micro_rows = 2;
+        kernel.micro_cols = 2;
+        int fields = sscanf(start, "%63s %511s %15s %15s %15s %u %u %u %u %u %15s", kernel.name, kernel.binary,
+                            matrix1_dtype, matrix2_dtype, result_dtype,
+                            &kernel.nr_tasklets, &kernel.tile_rows, &kernel.tile_cols, &kernel.micro_rows, &kernel.micro_cols,
+                            multiply);
+        if ((fields != 8 && fields != 10 && fields != 11) || kernel.nr_tasklets == 0 || kernel.tile_rows == 0 ||
+            kernel.tile_cols == 0 || kernel.micro_rows == 0 || kernel.micro_cols == 0 ||
+            multiply_from_name(multiply, &kernel.multiply) != 0 ||
+            pim_dtype_from_name(matrix1_dtype, &kernel.matrix1_dtype) != 0 ||
+            pim_dtype_from_name(matrix2_dtype, &kernel.matrix2_dtype) != 0 ||
+            pim_dtype_from_name(result_dtype, &kernel.result_dtype) != 0) {
+            PIM_LOG_WARN("Malformed kernel manifest entry at %s:%u", manifest_path, line_number);
+            continue;
+        }
+        if (registry_append(&kernel) != 0) {
+            fclose(manifest);
+            return -1;
+        }
+    }
+    fclose(manifest);
+    return (int)registry_num_kernels;
+}
+
+static void registry_register_default(void) {
+    pim_kernel_descriptor_t kernel = {0};
+    strcpy(kernel.name, "matrix_multiply_dpu");
+    strcpy(kernel.binary, DPU_MATRIX_MULTIPLICATION_BIN);
+    kernel.matrix1_dtype = DPU_PIM_DTYPE_UINT8;
+    kernel.matrix2_dtype = DPU_PIM_DTYPE_UINT8;
+    kernel.result_dtype = DPU_PIM_DTYPE_UINT16;
+    kernel.nr_tasklets = NR_TASKLETS;
+    kernel.tile_rows = 8;
+    kernel.tile_cols = 8;
+    kernel.micro_rows = 2;
+    kernel.micro_cols = 2;
+    registry_append(&kernel);
+}
+
+// Must be called with registry_mutex held
+static int registry_prefer(dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype,
+                           const char* name) {
+    pim_kernel_descriptor_t* preferred = NULL;
+    for (uint32_t i = 0; i < registry_num_kernels && name; i++) {
+        pim_kernel_descriptor_t* kernel = &registry_kernels[i];
+        if (kernel->matrix1_dtype == matrix1_dtype && kernel->matrix2_dtype == matrix2_dtype &&
+            kernel->result_dtype == result_dtype && strcmp(kernel->name, name) == 0) {
+            preferred = kernel;
+            break;
+        }
+    }
+    if (name && !preferred) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < registry_num_kernels; i++) {
+        pim_kernel_descriptor_t* kernel = &registry_kernels[i];
+        if (kernel->matrix1_dtype == matrix1_dtype && kernel->matrix2_dtype == matrix2_dtype &&
+            kernel->result_dtype == result_dtype) {
+            kernel->preferred = kernel == preferred;
+        }
+    }
+    return 0;
+}
+
+// Must be called with registry_mutex held
+static void registry_prefer_from_env(void) {
+    const char* names = getenv("PIM_DPU_KERNEL_PREFER");
+    if (!names) return;
+    char name[PIM_KERNEL_REGISTRY_MAX_NAME];
+    while (*names) {
+        size_t length = strcspn(names, ",");
+        const pim_kernel_descriptor_t* kernel = NULL;
+        if (length < sizeof(name)) {
+            memcpy(name, names, length);
+            name[length] = '\0';
+            for (uint32_t i = 0; i < registry_num_kernels && !kernel; i++) {
+                if (strcmp(registry_kernels[i].name, name) == 0) kernel = &registry_kernels[i];
+            }
+        }
+        if (kernel) {
+            registry_prefer(kernel->matrix1_dtype, kernel->matrix2_dtype, kernel->result_dtype, name);
+        } else {
+            PIM_LOG_WARN("PIM_DPU_KERNEL_PREFER names unknown kernel %.*s", (int)length, names);
+        }
+        names += length;
+        if (*names == ',') names++;
+    }
+}
+
+// Must be called with registry_mutex held
+static void registry_ensure_initialized(void) {
+    if (registry_initialized) return;
+    registry_initialized = true;
+    const char* manifest_path = getenv("PIM_DPU_KERNEL_MANIFEST");
+    if (!manifest_path) {
+        manifest_path = DPU_KERNEL_MANIFEST;
+    }
+    if (registry_load_manifest(manifest_path) <= 0) {
+        registry_num_kernels = 0;
+        registry_register_default();
+    }
+    registry_prefer_from_env();
+}
+
+int pim_kernel_registry_load(const char* manifest_path) {
+    if (!manifest_path) return -1;
+    pthread_mutex_lock(&registry_mutex);
+    registry_initialized = true;
+    int loaded = registry_load_manifest(manifest_path);
+    if (loaded < 0) {
+        PIM_LOG_ERROR("Failed to read kernel manifest %s", manifest_path);
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    return loaded;
+}
+
+int pim_kernel_registry_register(const pim_kernel_descriptor_t* kernel) {
+    if (!kernel || kernel->nr_tasklets == 0 || kernel->tile_rows == 0 || kernel->tile_cols == 0) return -1;
+    pim_kernel_descriptor_t registered = *kernel;
+    if (registered.micro_rows == 0 && registered.micro_cols == 0) {
+        registered.micro_rows = 2;
+        registered.micro_cols = 2;
+    }
+    pthread_mutex_lock(&registry_mutex);
+    registry_initialized = true;
+    int status = registry_append(&registered);
+    pthread_mutex_unlock(&registry_mutex);
+    return status;
+}
+
+void pim_kernel_registry_clear(void) {
+    pthread_mutex_lock(&registry_mutex);
+    free(registry_kernels);
+    registry_kernels = NULL;
+    registry_num_kernels = 0;
+    registry_capacity = 0;
+    registry_initialized = true;
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+uint32_t pim_kernel_registry_count(void) {
+    pthread_mutex_lock(&registry_mutex);
+    registry_ensure_initialized();
+    uint32_t count = registry_num_kernels;
+    pthread_mutex_unlock(&registry_mutex);
+    return count;
+}
+
+const pim_kernel_descriptor_t* pim_kernel_registry_get(uint32_t index) {
+    pthread_mutex_lock(&registry_mutex);
+    registry_ensure_initialized();
+    const pim_kernel_descriptor_t* kernel = index < registry_num_kernels ? &registry_kernels[index] : NULL;
+    pthread_mutex_unlock(&registry_mutex);
+    return kernel;
+}
+
+int pim_kernel_registry_prefer(dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype,
+                               const char* name) {
+    pthread_mutex_lock(&registry_mutex);
+    registry_ensure_initialized();
+    int status = registry_prefer(matrix1_dtype, matrix2_dtype, result_dtype, name);
+    pthread_mutex_unlock(&registry_mutex);
+    return status;
+}
+
+const pim_kernel_descriptor_t* pim_kernel_registry_select(dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype,
+                                                          uint32_t result_rows, uint32_t result_cols) {
+    pthread_mutex_lock(&registry_mutex);
+    registry_ensure_initialized();
+
+    const pim_kernel_descriptor_t* best = NULL;
+    uint64_t best_busy_tasklets = 0;
+    uint64_t best_waste = 0;
+    uint64_t best_tile_area = 0;
+    for (uint32_t i = 0; i < registry_num_kernels; i++) {
+        const pim_kernel_descriptor_t* kernel = &registry_kernels[i];
+        if (kernel->matrix1_dtype != matrix1_dtype ||
+            kernel->matrix2_dtype != matrix2_dtype ||
+            kernel->result_dtype != result_dtype) {
+            continue;
+        }
+        if (kernel->preferred) {
+            best = kernel;
+            break;
+        }
+        uint64_t tiles_by_rows = (result_rows + kernel->tile_rows - 1) / kernel->tile_rows;
+        uint64_t tiles_by_cols = (result_cols + kernel->tile_cols - 1) / kernel->tile_cols;
+        uint64_t num_tiles = tiles_by_rows * tiles_by_cols;
+        uint64_t tile_area = (uint64_t)kernel->tile_rows * kernel->tile_cols;
+        uint64_t busy_tasklets = num_tiles < kernel->nr_tasklets ? num_tiles : kernel->nr_tasklets;
+        uint64_t waste = num_tiles * tile_area - (uint64_t)result_rows * result_cols;
+        bool better = !best ||
+                      busy_tasklets > best_busy_tasklets ||
+                      (busy_tasklets == best_busy_tasklets && waste < best_waste) ||
+                      (busy_tasklets == best_busy_tasklets && waste == best_waste && tile_area > best_tile_area);
+        if (better) {
+            best = kernel;
+            best_busy_tasklets = busy_tasklets;
+            best_waste = waste;
+            best_tile_area = tile_area;
+        }
+    }
+
+    pthread_mutex_unlock(&registry_mutex);
+    return best;
+}
+
+int pim_kernel_registry_read_plan(struct dpu_set_t dpu_set, pim_kernel_descriptor_t* kernel, dpu_pim_kernel_plan_t* plan) {
+    if (!kernel || !plan) return -1;
+    struct dpu_set_t dpu;
+    dpu_error_t err = DPU_ERR_INTERNAL;
+    DPU_FOREACH(dpu_set, dpu) {
+        err = dpu_copy_from(dpu, "KERNEL_PLAN", 0, plan, sizeof(*plan));
+        break;
+    }
+    if (err != DPU_OK) {
+        PIM_LOG_ERROR("Failed to read the kernel plan of %s (error %d)", kernel->binary, err);
+        return -1;
+    }
+    if (plan->matrix1_dtype != kernel->matrix1_dtype || plan->matrix2_dtype != kernel->matrix2_dtype ||
+        plan->result_dtype != kernel->result_dtype) {
+        PIM_LOG_ERROR("Kernel %s is built for %s x %s -> %s, the manifest lists %s x %s -> %s", kernel->name,
+                      pim_dtype_name((dpu_pim_dtype_t)plan->matrix1_dtype), pim_dtype_name((dpu_pim_dtype_t)plan->matrix2_dtype),
+                      pim_dtype_name((dpu_pim_dtype_t)plan->result_dtype), pim_dtype_name(kernel->matrix1_dtype),
+                      pim_dtype_name(kernel->matrix2_dtype), pim_dtype_name(kernel->result_dtype));
+        return -1;
+    }
+    if (plan->nr_tasklets != kernel->nr_tasklets || plan->tile_rows != kernel->tile_rows) {
+        PIM_LOG_WARN("Kernel %s is built for %u tasklets and %u-row tiles, the manifest lists %u and %u", kernel->name,
+                     plan->nr_tasklets, plan->tile_rows, kernel->nr_tasklets, kernel->tile_rows);
+    }
+    kernel->nr_tasklets = plan->nr_tasklets;
+    kernel->tile_rows = plan->tile_rows;
+    kernel->tile_cols = plan->tile_cols;
+    kernel->micro_rows = plan->micro_rows;
+    kernel->micro_cols = plan->micro_cols;
+    kernel->multiply = (dpu_pim_multiply_t)plan->multiply;
+    return 0;
+}
+
+int pim_kernel_registry_read_status(struct dpu_set_t dpu_set, uint32_t num_dpus) {
+    int32_t* statuses = (int32_t*)malloc((size_t)num_dpus * sizeof(int32_t));
+    if (!statuses) {
+        PIM_LOG_ERROR("Failed to allocate memory for %u DPU statuses", num_dpus);
+        return -1;
+    }
+    struct dpu_set_t dpu;
+    uint32_t i;
+    dpu_error_t err = DPU_OK;
+    DPU_FOREACH(dpu_set, dpu, i) {
+        if (err == DPU_OK) {
+            err = dpu_prepare_xfer(dpu, statuses + i);
+        }
+    }
+    if (err == DPU_OK) {
+        err = dpu_push_xfer(dpu_set, DPU_XFER_FROM_DPU, "KERNEL_STATUS", 0, sizeof(int32_t), DPU_XFER_DEFAULT);
+    }
+    if (err != DPU_OK) {
+        PIM_LOG_ERROR("Failed to read the launch status of %u DPUs (error %d)", num_dpus, err);
+        free(statuses);
+        return -1;
+    }
+    int status = 0;
+    for (i = 0; i < num_dpus; i++) {
+        if (statuses[i] != 0) {
+            PIM_LOG_ERROR("DPU %u of the launch reported status %d", i, statuses[i]);
+            status = -1;
+        }
+    }
+    free(statuses);
+    return status;
+}
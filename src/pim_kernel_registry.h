@@ -0,0 +1,122 @@
+#ifndef __PIM_KERNEL_REGISTRY_H___
+#define __PIM_KERNEL_REGISTRY_H___
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pim_dpu_pool.h"
+#include "pim_dtype.h"
+
+#define PIM_KERNEL_REGISTRY_MAX_NAME 64
+
+/**
+ * @brief Description of one specialised DPU kernel binary.
+ */
+typedef struct {
+    char name[PIM_KERNEL_REGISTRY_MAX_NAME];          ///< Kernel variant name
+    char binary[PIM_DPU_POOL_MAX_BINARY_PATH];        ///< Path of the DPU binary
+    dpu_pim_dtype_t matrix1_dtype;                    ///< Element type of the first matrix the kernel is built for
+    dpu_pim_dtype_t matrix2_dtype;                    ///< Element type of the second matrix the kernel is built for
+    dpu_pim_dtype_t result_dtype;                     ///< Element type of the result matrix the kernel is built for
+    uint32_t nr_tasklets;                             ///< Number of tasklets the kernel is built for
+    uint32_t tile_rows;                               ///< Rows of the output tile computed by a tasklet
+    uint32_t tile_cols;                               ///< Columns of the output tile computed by a tasklet
+    uint32_t micro_rows;                              ///< Rows of the register block of the tiled micro-kernel
+    uint32_t micro_cols;                              ///< Columns of the register block of the tiled micro-kernel
+    dpu_pim_multiply_t multiply;                      ///< Multiplication of 8-bit operands in the tiled micro-kernel
+    bool preferred;                                   ///< Selected for its element types whatever the shape (see pim_kernel_registry_prefer)
+} pim_kernel_descriptor_t;
+
+/**
+ * @brief Load kernel descriptors from a manifest file, replacing the registry contents.
+ * @details The manifest is written by `make build-dpu` (scripts/build_dpu_kernels.py). Each non-comment line holds
+ *          `name binary matrix1_dtype matrix2_dtype result_dtype nr_tasklets tile_rows tile_cols [micro_rows micro_cols
+ *          [multiply]]`, where element types are written by name ("int8", "uint8", ...) and the multiplication as in
+ *          defn/dpu_kernels.yaml ("c", "builtin", "packed_builtin"). The defaults are a 2x2 register block and "c".
+ * @param manifest_path Path of the manifest file.
+ * @return Number of kernels loaded, or -1 on failure.
+ */
+int pim_kernel_registry_load(const char* manifest_path);
+
+/**
+ * @brief Register a single kernel descriptor.
+ * @details A register block left at 0x0 is taken as the default 2x2 block.
+ * @param kernel Pointer to the descriptor to copy into the registry.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_kernel_registry_register(const pim_kernel_descriptor_t* kernel);
+
+/**
+ * @brief Remove all kernels from the registry.
+ */
+void pim_kernel_registry_clear(void);
+
+/**
+ * @brief Get the number of registered kernels.
+ * @details On first use the registry is populated from the manifest named by the `PIM_DPU_KERNEL_MANIFEST`
+ *          environment variable, or from `DPU_KERNEL_MANIFEST` when it is not set. If no manifest can be read,
+ *          the default `DPU_MATRIX_MULTIPLICATION_BIN` kernel is registered. The comma-separated kernel names of the
+ *          `PIM_DPU_KERNEL_PREFER` environment variable are then preferred (see pim_kernel_registry_prefer).
+ * @return Number of registered kernels.
+ */
+uint32_t pim_kernel_registry_count(void);
+
+/**
+ * @brief Get a registered kernel by index.
+ * @param index Index of the kernel.
+ * @return Pointer to the descriptor (valid until the registry is modified), or NULL if out of bounds.
+ */
+const pim_kernel_descriptor_t* pim_kernel_registry_get(uint32_t index);
+
+/**
+ * @brief Prefer a kernel for frames of its element types.
+ * @details Builds for the same element types and tiles differ only in how they compute, e.g. their register block
+ *          or multiplication, which the shape-based selection cannot weigh; the first one listed wins it. A preferred kernel is selected
+ *          for its element types whatever the shape, replacing any kernel preferred for them before.
+ * @param matrix1_dtype Element type of the first matrix.
+ * @param matrix2_dtype Element type of the second matrix.
+ * @param result_dtype Element type of the result matrix.
+ * @param name Name of the kernel to prefer, or NULL to go back to the shape-based selection for these types.
+ * @return 0 on success, -1 if no kernel of that name is registered for these element types.
+ */
+int pim_kernel_registry_prefer(dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype,
+                               const char* name);
+
+/**
+ * @brief Select the best kernel for a per-DPU problem.
+ * @details Only kernels built for the given element types are considered. A kernel preferred for them is chosen;
+ *          otherwise the kernel that keeps the most tasklets busy on the per-DPU output slice is chosen, then the
+ *          one that wastes the least work on partial tiles, then the one with the largest tiles.
+ * @param matrix1_dtype Element type of the first matrix.
+ * @param matrix2_dtype Element type of the second matrix.
+ * @param result_dtype Element type of the result matrix.
+ * @param result_rows Rows of the result slice computed by one DPU.
+ * @param result_cols Columns of the result slice computed by one DPU.
+ * @return Pointer to the selected descriptor (valid until the registry is modified), or NULL if no kernel matches the element types.
+ */
+const pim_kernel_descriptor_t* pim_kernel_registry_select(dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype,
+                                                          uint32_t result_rows, uint32_t result_cols);
+
+/**
+ * @brief Read the WRAM plan of the binary loaded on a DPU set and adopt it in the kernel descriptor.
+ * @details The plan is read from the `KERNEL_PLAN` symbol of the first DPU. The manifest may be stale, so the tasklet
+ *          count, tile sizes, register block and multiplication of the descriptor are replaced with the ones the binary was built
+ *          with (the tile columns are the rounded ones the kernel computes).
+ * @param dpu_set DPU set holding the kernel binary.
+ * @param kernel Descriptor of the loaded binary, updated in place.
+ * @param plan Destination of the plan.
+ * @return 0 on success, -1 if the plan cannot be read or the binary is built for other element types.
+ */
+int pim_kernel_registry_read_plan(struct dpu_set_t dpu_set, pim_kernel_descriptor_t* kernel, dpu_pim_kernel_plan_t* plan);
+
+/**
+ * @brief Read the status the DPU program published for its last launch on every DPU of a set.
+ * @details `dpu_launch` succeeds whatever the DPU program returns, so the program reports failures of its tasklets
+ *          (e.g. operands the selected kernel cannot serve) in the `KERNEL_STATUS` symbol instead.
+ * @param dpu_set DPU set that ran the launch.
+ * @param num_dpus Number of DPUs in the set.
+ * @return 0 if every DPU succeeded, -1 if any DPU failed or the status cannot be read.
+ */
+int pim_kernel_registry_read_status(struct dpu_set_t dpu_set, uint32_t num_dpus);
+
+#endif // __PIM_KERNEL_REGISTRY_H___
@@ -0,0 +1,58 @@
+#ifndef __PIM_LOG_H___
+#define __PIM_LOG_H___
+
+#include <stdio.h>
+
+/**
+ * @brief Compile-time leveled logging shared by the host library and the DPU program.
+ * @details `PIM_LOG_LEVEL` (set in defn/params.yaml) selects the most verbose level that is compiled in; calls
+ *          below it expand to nothing, so their arguments are not evaluated. Host messages go to stderr as one
+ *          `key=value` line: `pim level=debug at=file.c:42 fn=function msg="..."`.
+ *          At PIM_LOG_LEVEL_DEBUG and above the host also forwards the DPU log buffers after every launch.
+ */
+
+#define PIM_LOG_LEVEL_NONE 0
+#define PIM_LOG_LEVEL_ERROR 1
+#define PIM_LOG_LEVEL_WARN 2
+#define PIM_LOG_LEVEL_INFO 3
+#define PIM_LOG_LEVEL_DEBUG 4
+#define PIM_LOG_LEVEL_TRACE 5   ///< Also logs the shape and checksum of every transferred submatrix
+
+#ifndef PIM_LOG_LEVEL
+#define PIM_LOG_LEVEL PIM_LOG_LEVEL_WARN
+#endif
+
+#define PIM_LOG_WRITE(level_name, fmt, ...) \
+    fprintf(stderr, "pim level=" level_name " at=%s:%d fn=%s msg=\"" fmt "\"\n", __FILE__, __LINE__, __func__, ##__VA_ARGS__)
+
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_ERROR
+#define PIM_LOG_ERROR(fmt, ...) PIM_LOG_WRITE("error", fmt, ##__VA_ARGS__)
+#else
+#define PIM_LOG_ERROR(fmt, ...) ((void)0)
+#endif
+
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_WARN
+#define PIM_LOG_WARN(fmt, ...) PIM_LOG_WRITE("warn", fmt, ##__VA_ARGS__)
+#else
+#define PIM_LOG_WARN(fmt, ...) ((void)0)
+#endif
+
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_INFO
+#define PIM_LOG_INFO(fmt, ...) PIM_LOG_WRITE("info", fmt, ##__VA_ARGS__)
+#else
+#define PIM_LOG_INFO(fmt, ...) ((void)0)
+#endif
+
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_DEBUG
+#define PIM_LOG_DEBUG(fmt, ...) PIM_LOG_WRITE("debug", fmt, ##__VA_ARGS__)
+#else
+#define PIM_LOG_DEBUG(fmt, ...) ((void)0)
+#endif
+
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_TRACE
+#define PIM_LOG_TRACE(fmt, ...) PIM_LOG_WRITE("trace", fmt, ##__VA_ARGS__)
+#else
+#define PIM_LOG_TRACE(fmt, ...) ((void)0)
+#endif
+
+#endif // __PIM_LOG_H___
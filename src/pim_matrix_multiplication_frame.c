@@ -13,8 +13,33 @@
 
 #include "dpu_pim_matrix_multiply_kernel_arguments.h"
 
+#include "pim_dpu_pool.h"
+#include "pim_kernel_registry.h"
+#include "pim_dtype.h"
+#include "pim_stats.h"
+#include "pim_dpu_stats.h"
+#include "pim_trace.h"
+#include "pim_log.h"
+#include "pim_xfer_model.h"
+
 #include "pim_matrix_multiplication_frame.h"
 
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_TRACE
+/**
+ * @brief FNV-1a hash of the elements of a matrix, traced instead of its contents to compare transfers between runs.
+ */
+static uint32_t matrix_checksum(const Matrix* mat) {
+    uint32_t hash = 2166136261u;
+    for (int16_t r = 0; r < mat->rows; r++) {
+        const uint8_t* row = (const uint8_t*)mat->data[r];
+        for (uint32_t b = 0; b < (uint32_t)mat->cols * mat->element_size; b++) {
+            hash = (hash ^ row[b]) * 16777619u;
+        }
+    }
+    return hash;
+}
+#endif
+
 uint32_t calculate_pad_rows(int16_t rows, int16_t element_size) {
     uint32_t col_size = rows * element_size;
     uint32_t pad = (8 - (col_size % 8)) % 8;
@@ -53,7 +78,9 @@ static void find_optimal_work_group_config(uint32_t num_dpus, uint32_t matrix1_s
         if (num_dpus % nwg != 0) continue;
         uint32_t wgs = num_dpus / nwg;
         // Check both (nwg, wgs) and (wgs, nwg) if they are different
-        double cost = (double)matrix2_size / nwg + (double)matrix1_size / wgs;
+        // Time to push both slices; proportional to the bytes per DPU unless a transfer calibration is loaded
+        double cost = pim_xfer_model_estimate_ns(PIM_XFER_TO_DPU, num_dpus, (matrix2_size + nwg - 1) / nwg) +
+                      pim_xfer_model_estimate_ns(PIM_XFER_TO_DPU, num_dpus, (matrix1_size + wgs - 1) / wgs);
         if (cost < best_cost) {
             best_cost = cost;
             best_num_work_groups = nwg;
@@ -64,20 +91,85 @@ static void find_optimal_work_group_config(uint32_t num_dpus, uint32_t matrix1_s
     *work_group_size = best_work_group_size;
 }
 
+// Compute the per-DPU MRAM regions from matrix1_start_offset and the split
+static void compute_frame_layout(pim_matrix_multiplication_frame_t* frame) {
+    uint32_t curr_offset = frame->matrix1_start_offset;
+
+    // Every DPU holds one row slice of the first matrix, one column slice of the second and one result tile,
+    // each padded for 8-byte transfers exactly as they are pushed and pulled
+    uint32_t matrix1_split_rows = (frame->matrix1_rows + (frame->work_group_size - (frame->matrix1_rows % frame->work_group_size)) % frame->work_group_size) / frame->work_group_size;
+    uint32_t matrix1_rows_transfer_aligned = matrix1_split_rows + calculate_pad_rows(matrix1_split_rows, frame->matrix1_type_size);
+    uint32_t matrix1_cols_transfer_aligned = frame->matrix1_cols + calculate_pad_cols(frame->matrix1_cols, frame->matrix1_type_size);
+    curr_offset += matrix1_rows_transfer_aligned * matrix1_cols_transfer_aligned * frame->matrix1_type_size;
+    frame->matrix2_start_offset = curr_offset;
+
+    uint32_t matrix2_split_cols = (frame->matrix2_cols + (frame->num_work_groups - (frame->matrix2_cols % frame->num_work_groups)) % frame->num_work_groups) / frame->num_work_groups;
+    uint32_t matrix2_rows_transfer_aligned = frame->matrix2_rows + calculate_pad_rows(frame->matrix2_rows, frame->matrix2_type_size);
+    uint32_t matrix2_cols_transfer_aligned = matrix2_split_cols + calculate_pad_cols(matrix2_split_cols, frame->matrix2_type_size);
+    uint32_t matrix2_slice_size = matrix2_rows_transfer_aligned * matrix2_cols_transfer_aligned * frame->matrix2_type_size;
+    curr_offset += matrix2_slice_size;
+    frame->result_start_offset = curr_offset;
+
+    // The result tile and the per-column epilogue parameters (bias, multiplier and shift) are sized for the widest
+    // output the epilogue can select, so configuring it never moves a region
+    uint32_t result_size = 0;
+    uint32_t param_count = 0;
+    uint32_t output_type_sizes[] = {frame->result_type_size, sizeof(int8_t)};
+    uint32_t num_output_types = frame->result_dtype == DPU_PIM_DTYPE_INT32 ? 2 : 1;   // Requantisation narrows to int8
+    for (uint32_t t = 0; t < num_output_types; t++) {
+        uint32_t result_rows_transfer_aligned = matrix1_split_rows + calculate_pad_rows(matrix1_split_rows, output_type_sizes[t]);
+        uint32_t result_cols_transfer_aligned = matrix2_split_cols + calculate_pad_cols(matrix2_split_cols, output_type_sizes[t]);
+        uint32_t size = result_rows_transfer_aligned * result_cols_transfer_aligned * output_type_sizes[t];
+        uint32_t count = dpu_pim_epilogue_param_count(result_cols_transfer_aligned);
+        result_size = size > result_size ? size : result_size;
+        param_count = count > param_count ? count : param_count;
+    }
+    curr_offset += result_size;
+    frame->epilogue_start_offset = curr_offset;
+    curr_offset += 3 * param_count * sizeof(int32_t);
+
+    // Row-major copy of the second matrix slice, converted on the DPUs. It is only reserved once the second matrix is
+    // loaded row-major, and comes last so that reserving it moves no region already holding data
+    frame->matrix2_staging_offset = curr_offset;
+    if (frame->matrix2_staging_reserved) {
+        curr_offset += matrix2_slice_size;
+    }
+    frame->mem_frame_end = curr_offset;
+}
+
 pim_matrix_multiplication_frame_t* create_pim_matrix_multiplication_frame(uint32_t num_dpus, uint32_t dpu_offset,
                                                                         uint32_t matrix1_rows, uint32_t matrix1_cols,
                                                                         uint32_t matrix2_rows, uint32_t matrix2_cols,
                                                                         uint32_t result_rows, uint32_t result_cols,
                                                                         uint32_t matrix1_type_size, uint32_t matrix2_type_size, uint32_t result_type_size) {
+    dpu_pim_dtype_t matrix1_dtype, matrix2_dtype, result_dtype;
+    if (pim_dtype_from_sizes(matrix1_type_size, matrix2_type_size, result_type_size, &matrix1_dtype, &matrix2_dtype, &result_dtype) != 0) {
+        PIM_LOG_ERROR("Unsupported element sizes %u x %u -> %u", matrix1_type_size, matrix2_type_size, result_type_size);
+        return NULL;
+    }
+    return create_pim_matrix_multiplication_frame_typed(num_dpus, dpu_offset, matrix1_rows, matrix1_cols, matrix2_rows, matrix2_cols,
+                                                        result_rows, result_cols, matrix1_dtype, matrix2_dtype, result_dtype);
+}
+
+pim_matrix_multiplication_frame_t* create_pim_matrix_multiplication_frame_typed(uint32_t num_dpus, uint32_t dpu_offset,
+                                                                              uint32_t matrix1_rows, uint32_t matrix1_cols,
+                                                                              uint32_t matrix2_rows, uint32_t matrix2_cols,
+                                                                              uint32_t result_rows, uint32_t result_cols,
+                                                                              dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype) {
+    if (!pim_dtype_gemm_supported(matrix1_dtype, matrix2_dtype, result_dtype)) {
+        PIM_LOG_ERROR("Unsupported element types %s x %s -> %s",
+                      pim_dtype_name(matrix1_dtype), pim_dtype_name(matrix2_dtype), pim_dtype_name(result_dtype));
+        return NULL;
+    }
+    uint32_t matrix1_type_size = pim_dtype_size(matrix1_dtype);
+    uint32_t matrix2_type_size = pim_dtype_size(matrix2_dtype);
+    uint32_t result_type_size = pim_dtype_size(result_dtype);
+
     pim_matrix_multiplication_frame_t* frame = (pim_matrix_multiplication_frame_t*)malloc(sizeof(pim_matrix_multiplication_frame_t));
     if (!frame) {
         return NULL;
     }
 
-    struct dpu_set_t set;
-    DPU_ASSERT(dpu_alloc(num_dpus, NULL, &set));
-    frame->dpu_set = set;
-
     uint32_t matrix1_size = matrix1_rows * matrix1_cols * matrix1_type_size;
     uint32_t matrix2_size = matrix2_rows * matrix2_cols * matrix2_type_size;
 
@@ -101,41 +193,286 @@ pim_matrix_multiplication_frame_t* create_pim_matrix_multiplication_frame(uint32
     frame->matrix1_type_size = matrix1_type_size;
     frame->matrix2_type_size = matrix2_type_size;
     frame->result_type_size = result_type_size;
+    frame->matrix1_dtype = matrix1_dtype;
+    frame->matrix2_dtype = matrix2_dtype;
+    frame->result_dtype = result_dtype;
 
-    uint32_t curr_offset = dpu_offset;
-    frame->matrix1_start_offset = curr_offset;
-
+    frame->matrix1_start_offset = dpu_offset;
+    frame->output_dtype = result_dtype;
+    frame->output_type_size = result_type_size;
+    frame->epilogue_flags = 0;
+    frame->clamp_min = 0;
+    frame->clamp_max = 0;
+    frame->gemm_variant = DPU_PIM_GEMM_TILED;
+    frame->gemm_variant_auto = true;
+    frame->matrix1_lut_range = false;
+    frame->matrix2_lut_range = false;
+    frame->matrix2_pending_transpose = false;
+    frame->matrix2_staged = false;
+    frame->matrix2_staging_reserved = false;
+    memset(&frame->stats, 0, sizeof(frame->stats));
+    compute_frame_layout(frame);
     uint32_t matrix1_rows_aligned = matrix1_rows + (frame->work_group_size - (matrix1_rows % frame->work_group_size)) % frame->work_group_size;
-    uint32_t matrix1_rows_transfer_aligned = matrix1_rows_aligned + calculate_pad_rows(matrix1_rows_aligned, frame->matrix1_type_size);
-    uint32_t matrix1_cols_transfer_aligned = matrix1_cols + calculate_pad_cols(matrix1_cols, frame->matrix1_type_size);
-    uint32_t matrix1_size_aligned = matrix1_rows_transfer_aligned * matrix1_cols_transfer_aligned * matrix1_type_size;
-    curr_offset += matrix1_size_aligned / frame->num_work_groups;
-    frame->matrix2_start_offset = curr_offset;
-
     uint32_t matrix2_cols_aligned = matrix2_cols + (frame->num_work_groups - (matrix2_cols % frame->num_work_groups)) % frame->num_work_groups;
-    uint32_t matrix2_rows_transfer_aligned = matrix2_rows + calculate_pad_rows(matrix2_rows, frame->matrix2_type_size);
-    uint32_t matrix2_cols_transfer_aligned = matrix2_cols_aligned + calculate_pad_cols(matrix2_cols_aligned, frame->matrix2_type_size);
-    uint32_t matrix2_size_aligned = matrix2_rows_transfer_aligned * matrix2_cols_transfer_aligned * matrix2_type_size;
-    curr_offset += matrix2_size_aligned / frame->num_work_groups;
-    frame->result_start_offset = curr_offset;
-
-    uint32_t result_rows_transfer_aligned = matrix1_rows_aligned + calculate_pad_rows(matrix1_rows_aligned, frame->result_type_size);
-    uint32_t result_cols_transfer_aligned = matrix2_cols_aligned + calculate_pad_cols(matrix2_cols_aligned, frame->result_type_size);
-    curr_offset += result_rows_transfer_aligned * result_cols_transfer_aligned * frame->result_type_size / frame->num_dpus;
-    frame->mem_frame_end = curr_offset;
 
     frame->result_valid = false;
 
-    const char* dpu_binary = "/workspace/bin/matrix_multiply_dpu";
-    DPU_ASSERT(dpu_load(frame->dpu_set, dpu_binary, NULL));
+    const pim_kernel_descriptor_t* kernel = pim_kernel_registry_select(matrix1_dtype, matrix2_dtype, result_dtype,
+                                                                       matrix1_rows_aligned / frame->work_group_size,
+                                                                       matrix2_cols_aligned / frame->num_work_groups);
+    if (!kernel) {
+        PIM_LOG_ERROR("No DPU kernel registered for element types %s x %s -> %s",
+                      pim_dtype_name(matrix1_dtype), pim_dtype_name(matrix2_dtype), pim_dtype_name(result_dtype));
+        free(frame);
+        return NULL;
+    }
+    frame->kernel = *kernel;
+
+    frame->dpu_pool_entry = pim_dpu_pool_acquire(num_dpus, frame->kernel.binary);
+    if (!frame->dpu_pool_entry) {
+        PIM_LOG_ERROR("Failed to acquire %u DPUs for PIM frame", num_dpus);
+        free(frame);
+        return NULL;
+    }
+    frame->dpu_set = frame->dpu_pool_entry->dpu_set;
+    if (pim_kernel_registry_read_plan(frame->dpu_set, &frame->kernel, &frame->kernel_plan) != 0) {
+        pim_dpu_pool_release(frame->dpu_pool_entry);
+        free(frame);
+        return NULL;
+    }
 
     return frame;
 }
 
-void destroy_pim_matrix_multiplication_frame(pim_matrix_multiplication_frame_t* frame);
+void destroy_pim_matrix_multiplication_frame(pim_matrix_multiplication_frame_t* frame) {
+    if (!frame) return;
+    pim_dpu_pool_release(frame->dpu_pool_entry);
+    free(frame);
+}
+
+int pim_matrix_multiplication_frame_set_epilogue(pim_matrix_multiplication_frame_t* frame, const pim_matrix_multiplication_epilogue_t* epilogue) {
+    if (!frame) return -1;
+
+    uint32_t flags = epilogue ? epilogue->flags : 0;
+    if ((flags & DPU_PIM_EPILOGUE_BIAS) && !epilogue->bias) {
+        PIM_LOG_ERROR("Epilogue bias requested without bias values");
+        return -1;
+    }
+    if ((flags & DPU_PIM_EPILOGUE_REQUANTIZE) && (!epilogue->multiplier || !epilogue->shift)) {
+        PIM_LOG_ERROR("Epilogue requantisation requested without multipliers or shifts");
+        return -1;
+    }
+    if ((flags & DPU_PIM_EPILOGUE_REQUANTIZE) && frame->result_dtype != DPU_PIM_DTYPE_INT32) {
+        PIM_LOG_ERROR("Epilogue requantisation needs an int32 result, got %s", pim_dtype_name(frame->result_dtype));
+        return -1;
+    }
+    if ((flags & DPU_PIM_EPILOGUE_CLAMP) && epilogue->clamp_min > epilogue->clamp_max) {
+        PIM_LOG_ERROR("Epilogue clamp range is empty");
+        return -1;
+    }
+
+    frame->epilogue_flags = flags;
+    frame->clamp_min = epilogue ? epilogue->clamp_min : 0;
+    frame->clamp_max = epilogue ? epilogue->clamp_max : 0;
+    frame->output_dtype = (flags & DPU_PIM_EPILOGUE_REQUANTIZE) ? DPU_PIM_DTYPE_INT8 : frame->result_dtype;
+    frame->output_type_size = pim_dtype_size(frame->output_dtype);
+    frame->result_valid = false;
+
+    if (!(flags & (DPU_PIM_EPILOGUE_BIAS | DPU_PIM_EPILOGUE_REQUANTIZE))) {
+        return 0;
+    }
+
+    // Every work group of columns gets the parameters of its own column slice
+    uint32_t result_cols_frame_aligned = ((frame->result_cols + (frame->num_work_groups - (frame->result_cols % frame->num_work_groups)) % frame->num_work_groups)) / frame->num_work_groups;
+    uint32_t result_cols_dpu_transfer_aligned = result_cols_frame_aligned + calculate_pad_cols(result_cols_frame_aligned, frame->output_type_size);
+    uint32_t param_count = dpu_pim_epilogue_param_count(result_cols_dpu_transfer_aligned);
+    PIM_STATS_TIMESTAMP(push_start);
+    int32_t* params = (int32_t*)calloc((size_t)frame->num_work_groups * 3 * param_count, sizeof(int32_t));
+    if (!params) {
+        PIM_LOG_ERROR("Failed to allocate memory for epilogue parameters");
+        return -1;
+    }
+    for (uint32_t group = 0; group < frame->num_work_groups; group++) {
+        int32_t* group_params = params + (size_t)group * 3 * param_count;
+        for (uint32_t j = 0; j < result_cols_frame_aligned; j++) {
+            uint32_t col = group * result_cols_frame_aligned + j;
+            if (col >= frame->result_cols) break;
+            if (flags & DPU_PIM_EPILOGUE_BIAS) group_params[j] = epilogue->bias[col];
+            if (flags & DPU_PIM_EPILOGUE_REQUANTIZE) {
+                group_params[param_count + j] = epilogue->multiplier[col];
+                group_params[2 * param_count + j] = epilogue->shift[col];
+            }
+        }
+    }
+
+    uint32_t i;
+    struct dpu_set_t dpu;
+    DPU_FOREACH(frame->dpu_set, dpu, i) {
+        DPU_ASSERT(dpu_prepare_xfer(dpu, params + (size_t)(i / frame->work_group_size) * 3 * param_count));
+    }
+    DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_TO_DPU, DPU_MRAM_HEAP_POINTER_NAME, frame->epilogue_start_offset,
+                            3 * param_count * sizeof(int32_t), DPU_XFER_DEFAULT));
+    free(params);
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_PUSH_EPILOGUE, push_start,
+                     (uint64_t)frame->work_group_size * frame->result_cols * 3 * sizeof(int32_t),
+                     (uint64_t)frame->num_dpus * 3 * param_count * sizeof(int32_t));
+    return 0;
+}
+
+int pim_matrix_multiplication_frame_set_gemm_variant(pim_matrix_multiplication_frame_t* frame, dpu_pim_gemm_variant_t variant) {
+    if (!frame) return -1;
+    if ((uint32_t)variant >= DPU_PIM_NUM_GEMM_VARIANTS) {
+        PIM_LOG_ERROR("Unknown GEMM variant %u", (uint32_t)variant);
+        return -1;
+    }
+    frame->gemm_variant = variant;
+    frame->gemm_variant_auto = false;
+    frame->result_valid = false;
+    return 0;
+}
+
+/*
+ * Whether a load has to scan an operand of the given type for DPU_PIM_GEMM_LUT: only 8-bit operands qualify, and the
+ * range only matters while the variant is chosen automatically or the lookup-table GEMM is requested
+ */
+static bool lut_scan_needed(const pim_matrix_multiplication_frame_t* frame, dpu_pim_dtype_t dtype) {
+    return pim_dtype_size(dtype) == 1 && (frame->gemm_variant_auto || frame->gemm_variant == DPU_PIM_GEMM_LUT);
+}
+
+// Whether every element of a loaded Matrix fits the operand range of DPU_PIM_GEMM_LUT, false when not scanned
+static bool matrix_fits_lut(const pim_matrix_multiplication_frame_t* frame, const Matrix* matrix, dpu_pim_dtype_t dtype) {
+    if (!lut_scan_needed(frame, dtype)) return false;
+    for (int16_t r = 0; r < matrix->rows; r++) {
+        if (!pim_dtype_values_fit_bits(dtype, matrix->data[r], matrix->cols, DPU_PIM_GEMM_LUT_BITS)) return false;
+    }
+    return true;
+}
+
+// Columns of the second matrix slice and of the result slice of one DPU, padded as laid out in MRAM
+static uint32_t gemm_slice_width(const pim_matrix_multiplication_frame_t* frame) {
+    uint32_t split_cols = (frame->matrix2_cols + frame->num_work_groups - 1) / frame->num_work_groups;
+    uint32_t slice_cols = split_cols + calculate_pad_cols(split_cols, frame->matrix2_type_size);
+    uint32_t result_cols = split_cols + calculate_pad_cols(split_cols, frame->output_type_size);
+    return slice_cols > result_cols ? slice_cols : result_cols;
+}
+
+bool pim_matrix_multiplication_frame_supports_gemm_variant(const pim_matrix_multiplication_frame_t* frame, dpu_pim_gemm_variant_t variant) {
+    if (!frame || (uint32_t)variant >= DPU_PIM_NUM_GEMM_VARIANTS) return false;
+    switch (variant) {
+        case DPU_PIM_GEMM_LUT:
+            return frame->matrix1_lut_range && frame->matrix2_lut_range;
+        case DPU_PIM_GEMM_OUTER:
+            return frame->matrix2_staged && gemm_slice_width(frame) <= frame->kernel_plan.gemm_outer_cols;
+        default:
+            return true;
+    }
+}
+
+/*
+ * Whether the shape favours the outer-product GEMM over the tiled one: every tasklet owns a result band, and the
+ * inner dimension is long enough for the shared panels to outweigh the band write-back.
+ */
+static bool prefers_outer_product(const pim_matrix_multiplication_frame_t* frame) {
+    uint32_t split_rows = (frame->result_rows + frame->work_group_size - 1) / frame->work_group_size;
+    uint32_t bands = (split_rows + frame->kernel_plan.tile_rows - 1) / frame->kernel_plan.tile_rows;
+    return bands >= frame->kernel_plan.nr_tasklets && frame->matrix1_cols >= PIM_GEMM_OUTER_MIN_INNER &&
+           pim_matrix_multiplication_frame_supports_gemm_variant(frame, DPU_PIM_GEMM_OUTER);
+}
+
+// GEMM implementation for the loaded operands: variants that cannot serve them fall back to the tiled kernel
+static dpu_pim_gemm_variant_t select_gemm_variant(const pim_matrix_multiplication_frame_t* frame) {
+    if (frame->gemm_variant_auto) {
+        if (pim_matrix_multiplication_frame_supports_gemm_variant(frame, DPU_PIM_GEMM_LUT)) return DPU_PIM_GEMM_LUT;
+        return prefers_outer_product(frame) ? DPU_PIM_GEMM_OUTER : DPU_PIM_GEMM_TILED;
+    }
+    if (!pim_matrix_multiplication_frame_supports_gemm_variant(frame, frame->gemm_variant)) {
+        if (frame->gemm_variant == DPU_PIM_GEMM_LUT) {
+            PIM_LOG_DEBUG("Operands exceed %u bits, running the tiled GEMM instead of the lookup-table GEMM", DPU_PIM_GEMM_LUT_BITS);
+        } else {
+            PIM_LOG_DEBUG("Second matrix slices exceed %u columns or are not staged row-major, running the tiled GEMM instead of the "
+                          "outer-product GEMM", frame->kernel_plan.gemm_outer_cols);
+        }
+        return DPU_PIM_GEMM_TILED;
+    }
+    return frame->gemm_variant;
+}
+
+/*
+ * Push the second matrix as padded row-major column slices to the staging region; the DPUs convert them to the
+ * column-major layout of the GEMM kernels at the next launch. Row r of B is rows[r] when rows is given, otherwise
+ * data + r * ld elements. A single unpadded slice is pushed straight from data.
+ */
+static int push_second_matrix_row_major(pim_matrix_multiplication_frame_t* frame, const void* data, uint32_t ld, void* const* rows) {
+    if (!frame->matrix2_staging_reserved) {
+        frame->matrix2_staging_reserved = true;
+        compute_frame_layout(frame);
+    }
+    PIM_STATS_TIMESTAMP(pack_start);
+    uint32_t element_size = frame->matrix2_type_size;
+    uint32_t split_cols = (frame->matrix2_cols + (frame->num_work_groups - (frame->matrix2_cols % frame->num_work_groups)) % frame->num_work_groups) / frame->num_work_groups;
+    uint32_t slice_rows = frame->matrix2_rows + calculate_pad_rows(frame->matrix2_rows, element_size);
+    uint32_t slice_cols = split_cols + calculate_pad_cols(split_cols, element_size);
+    size_t slice_size = (size_t)slice_rows * slice_cols * element_size;
+    size_t row_size = (size_t)slice_cols * element_size;
+    uint64_t matrix2_payload = (uint64_t)frame->matrix2_rows * frame->matrix2_cols * element_size;
+
+    uint32_t i;
+    struct dpu_set_t dpu;
+    if (!rows && frame->num_work_groups == 1 && ld == frame->matrix2_cols && ld == slice_cols) {
+        // B already has the slice layout; only the padding rows are pushed from a zeroed buffer
+        size_t data_size = (size_t)frame->matrix2_rows * row_size;
+        uint8_t* padding = slice_size > data_size ? (uint8_t*)calloc(1, slice_size - data_size) : NULL;
+        if (slice_size > data_size && !padding) {
+            PIM_LOG_ERROR("Failed to allocate memory for second matrix padding");
+            return -1;
+        }
+        PIM_STATS_RECORD(&frame->stats, PIM_STATS_PACK_MATRIX2, pack_start, 0, 0);
+        PIM_STATS_TIMESTAMP(push_start);
+        DPU_FOREACH(frame->dpu_set, dpu) {
+            DPU_ASSERT(dpu_prepare_xfer(dpu, (void*)data));
+        }
+        DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_TO_DPU, DPU_MRAM_HEAP_POINTER_NAME, frame->matrix2_staging_offset, data_size, DPU_XFER_DEFAULT));
+        if (padding) {
+            DPU_FOREACH(frame->dpu_set, dpu) {
+                DPU_ASSERT(dpu_prepare_xfer(dpu, padding));
+            }
+            DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_TO_DPU, DPU_MRAM_HEAP_POINTER_NAME, frame->matrix2_staging_offset + data_size,
+                                     slice_size - data_size, DPU_XFER_DEFAULT));
+            free(padding);
+        }
+        PIM_STATS_RECORD(&frame->stats, PIM_STATS_PUSH_MATRIX2, push_start, frame->work_group_size * matrix2_payload, frame->num_dpus * slice_size);
+    } else {
+        uint8_t* slices = (uint8_t*)calloc(frame->num_work_groups, slice_size);
+        if (!slices) {
+            PIM_LOG_ERROR("Failed to allocate memory for second matrix slices");
+            return -1;
+        }
+        // Every slice row is one contiguous copy out of a row of B
+        for (uint32_t r = 0; r < frame->matrix2_rows; r++) {
+            const uint8_t* row = rows ? (const uint8_t*)rows[r] : (const uint8_t*)data + (size_t)r * ld * element_size;
+            for (uint32_t g = 0; g < frame->num_work_groups && g * split_cols < frame->matrix2_cols; g++) {
+                uint32_t cols = frame->matrix2_cols - g * split_cols < split_cols ? frame->matrix2_cols - g * split_cols : split_cols;
+                memcpy(slices + g * slice_size + r * row_size, row + (size_t)g * split_cols * element_size, (size_t)cols * element_size);
+            }
+        }
+        PIM_STATS_RECORD(&frame->stats, PIM_STATS_PACK_MATRIX2, pack_start, matrix2_payload, frame->num_work_groups * slice_size);
+        DPU_FOREACH(frame->dpu_set, dpu, i) {
+            DPU_ASSERT(dpu_prepare_xfer(dpu, slices + (i / frame->work_group_size) * slice_size));
+        }
+        PIM_STATS_TIMESTAMP(push_start);
+        DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_TO_DPU, DPU_MRAM_HEAP_POINTER_NAME, frame->matrix2_staging_offset, slice_size, DPU_XFER_DEFAULT));
+        PIM_STATS_RECORD(&frame->stats, PIM_STATS_PUSH_MATRIX2, push_start, frame->work_group_size * matrix2_payload, frame->num_dpus * slice_size);
+        free(slices);
+    }
+    frame->matrix2_pending_transpose = true;
+    frame->matrix2_staged = true;
+    frame->result_valid = false; // Reset result validity after loading new matrix
+    return 0;
+}
 
 void pim_matrix_multiplication_frame_load_first_matrix(pim_matrix_multiplication_frame_t* frame, Matrix * matrix) {
     if (!frame || !matrix) return;
+    PIM_STATS_TIMESTAMP(pack_start);
     
     Matrix *matrix_split_aligned = NULL;
     Matrix **submatrices = NULL;
@@ -146,25 +483,25 @@ void pim_matrix_multiplication_frame_load_first_matrix(pim_matrix_multiplication
     uint32_t aligned_rows = (frame->work_group_size - (frame->matrix1_rows % frame->work_group_size)) % frame->work_group_size;
     matrix_split_aligned = matrix_add_rows(matrix, aligned_rows, NULL);
     if (!matrix_split_aligned) {
-        fprintf(stderr, "Failed to align matrix rows for PIM frame\n");
+        PIM_LOG_ERROR("Failed to align matrix rows for PIM frame");
         goto cleanup;
     }
     
     submatrices = matrix_split_by_rows(matrix_split_aligned, frame->work_group_size);
     if (!submatrices) {
-        fprintf(stderr, "Failed to split matrix by rows for PIM frame\n");
+        PIM_LOG_ERROR("Failed to split matrix by rows for PIM frame");
         goto cleanup;
     }
     
     submatrices_data = (void**)malloc(frame->work_group_size * sizeof(void*));
     if (!submatrices_data) {
-        fprintf(stderr, "Failed to allocate memory for submatrices data\n");
+        PIM_LOG_ERROR("Failed to allocate memory for submatrices data");
         goto cleanup;
     }
     
     submatrices_data_populated = (bool*)malloc(frame->work_group_size * sizeof(bool));
     if (!submatrices_data_populated) {
-        fprintf(stderr, "Failed to allocate memory for submatrices data populated flags\n");
+        PIM_LOG_ERROR("Failed to allocate memory for submatrices data populated flags");
         goto cleanup;
     }
     
@@ -178,14 +515,16 @@ void pim_matrix_multiplication_frame_load_first_matrix(pim_matrix_multiplication
     DPU_FOREACH(frame->dpu_set, dpu, i) {
         if (!submatrices_data_populated[i % frame->work_group_size]) {
             submatrices[i % frame->work_group_size] = matrix_align(submatrices[i % frame->work_group_size]);
-            printf("Aligned submatrix %d for PIM frame\n%s", i % frame->work_group_size, matrix_sprint(submatrices[i % frame->work_group_size], "| %u |"));
             if (!submatrices[i % frame->work_group_size]) {
-                fprintf(stderr, "Failed to align submatrix for PIM frame\n");
+                PIM_LOG_ERROR("Failed to align submatrix for PIM frame");
                 goto cleanup;
             }
+            PIM_LOG_TRACE("Aligned submatrix %u for PIM frame: shape=%dx%d checksum=%08x", i % frame->work_group_size,
+                          submatrices[i % frame->work_group_size]->rows, submatrices[i % frame->work_group_size]->cols,
+                          matrix_checksum(submatrices[i % frame->work_group_size]));
             submatrices_data[i % frame->work_group_size] = matrix_get_data_row_major(submatrices[i % frame->work_group_size]);
             if (!submatrices_data[i % frame->work_group_size]) {
-                fprintf(stderr, "Failed to get row major data from submatrix\n");
+                PIM_LOG_ERROR("Failed to get row major data from submatrix");
                 goto cleanup;
             }
             submatrices_data_populated[i % frame->work_group_size] = true;
@@ -195,7 +534,12 @@ void pim_matrix_multiplication_frame_load_first_matrix(pim_matrix_multiplication
     
     uint32_t offset = frame->matrix1_start_offset;
     uint32_t submatrix_size = submatrices[0]->rows * submatrices[0]->cols * frame->matrix1_type_size;
+    uint64_t matrix1_payload = (uint64_t)frame->matrix1_rows * frame->matrix1_cols * frame->matrix1_type_size;
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_PACK_MATRIX1, pack_start, matrix1_payload, (uint64_t)frame->work_group_size * submatrix_size);
+    PIM_STATS_TIMESTAMP(push_start);
     DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_TO_DPU, DPU_MRAM_HEAP_POINTER_NAME, offset, submatrix_size, DPU_XFER_DEFAULT));
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_PUSH_MATRIX1, push_start, frame->num_work_groups * matrix1_payload, (uint64_t)frame->num_dpus * submatrix_size);
+    frame->matrix1_lut_range = matrix_fits_lut(frame, matrix, frame->matrix1_dtype);
     frame->result_valid = false; // Reset result validity after loading new matrix
 
 cleanup:
@@ -207,77 +551,16 @@ cleanup:
 
 void pim_matrix_multiplication_frame_load_second_matrix(pim_matrix_multiplication_frame_t* frame, Matrix * matrix) {
     if (!frame || !matrix) return;
-    
-    Matrix *matrix_split_aligned = NULL;
-    Matrix **submatrices = NULL;
-    void **submatrices_data = NULL;
-    bool *submatrices_data_populated = NULL;
-    
-    // Load second matrix into MRAM at the specified offset
-    uint32_t aligned_cols = (frame->num_work_groups - (frame->matrix2_cols % frame->num_work_groups)) % frame->num_work_groups;
-    matrix_split_aligned = matrix_add_cols(matrix, aligned_cols, NULL);
-    if (!matrix_split_aligned) {
-        fprintf(stderr, "Failed to align matrix cols for PIM frame\n");
-        goto cleanup;
-    }
-    
-    submatrices = matrix_split_by_cols(matrix_split_aligned, frame->num_work_groups);
-    if (!submatrices) {
-        fprintf(stderr, "Failed to split matrix by cols for PIM frame\n");
-        goto cleanup;
-    }
-    
-    submatrices_data = (void**)malloc(frame->num_work_groups * sizeof(void*));
-    if (!submatrices_data) {
-        fprintf(stderr, "Failed to allocate memory for submatrices data\n");
-        goto cleanup;
-    }
-    
-    submatrices_data_populated = (bool*)malloc(frame->num_work_groups * sizeof(bool));
-    if (!submatrices_data_populated) {
-        fprintf(stderr, "Failed to allocate memory for submatrices data populated flags\n");
-        goto cleanup;
-    }
-    
-    for (uint32_t i = 0; i < frame->num_work_groups; i++) {
-        submatrices_data_populated[i] = false;
-    }
-    
-    // Load the aligned matrix into MRAM
-    uint32_t i;
-    struct dpu_set_t dpu;
-    DPU_FOREACH(frame->dpu_set, dpu, i) {
-        if (!submatrices_data_populated[i / frame->work_group_size]) {
-            submatrices[i / frame->work_group_size] = matrix_align(submatrices[i / frame->work_group_size]);
-            if (!submatrices[i / frame->work_group_size]) {
-                fprintf(stderr, "Failed to align submatrix for PIM frame\n");
-                goto cleanup;
-            }
-            submatrices_data[i / frame->work_group_size] = matrix_get_data_column_major(submatrices[i / frame->work_group_size]);
-            if (!submatrices_data[i / frame->work_group_size]) {
-                fprintf(stderr, "Failed to get column major data from submatrix\n");
-                goto cleanup;
-            }
-            submatrices_data_populated[i / frame->work_group_size] = true;
-        }
-        DPU_ASSERT(dpu_prepare_xfer(dpu, submatrices_data[i / frame->work_group_size]));
-    }
-    
-    uint32_t offset = frame->matrix2_start_offset;
-    uint32_t submatrix_size = submatrices[0]->rows * submatrices[0]->cols * frame->matrix2_type_size;
-    DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_TO_DPU, DPU_MRAM_HEAP_POINTER_NAME, offset, submatrix_size, DPU_XFER_DEFAULT));
-    frame->result_valid = false; // Reset result validity after loading new matrix
-
-cleanup:
-    if (submatrices_data_populated) free(submatrices_data_populated);
-    if (submatrices_data) free(submatrices_data);
-    if (submatrices) free(submatrices);
-    if (matrix_split_aligned) matrix_free(matrix_split_aligned);
+    if (push_second_matrix_row_major(frame, NULL, 0, matrix->data) != 0) return;
+    frame->matrix2_lut_range = matrix_fits_lut(frame, matrix, frame->matrix2_dtype);
 }
 
-void pim_matrix_multiplication_frame_execute(pim_matrix_multiplication_frame_t* frame) {
+int pim_matrix_multiplication_frame_execute(pim_matrix_multiplication_frame_t* frame) {
+    if (!frame) return -1;
     dpu_pim_matrix_multiply_kernel_arguments_t input_args;
     struct dpu_set_t dpu;
+    input_args.opcode = DPU_PIM_OP_GEMM;
+    input_args.gemm_variant = select_gemm_variant(frame);
     input_args.matrix1_start_offset = frame->matrix1_start_offset;
     input_args.matrix2_start_offset = frame->matrix2_start_offset;
     input_args.result_start_offset = frame->result_start_offset;
@@ -289,34 +572,66 @@ void pim_matrix_multiplication_frame_execute(pim_matrix_multiplication_frame_t*
     input_args.matrix2_rows = calculate_pad_cols(matrix2_split_cols, frame->matrix2_type_size) + matrix2_split_cols;
     uint32_t result_rows_frame_aligned = ((frame->result_rows + (frame->work_group_size - (frame->result_rows % frame->work_group_size)) % frame->work_group_size)) / frame->work_group_size;
     uint32_t result_cols_frame_aligned = ((frame->result_cols + (frame->num_work_groups - (frame->result_cols % frame->num_work_groups)) % frame->num_work_groups)) / frame->num_work_groups;
-    input_args.result_rows = result_rows_frame_aligned + calculate_pad_rows(result_rows_frame_aligned, frame->result_type_size);
-    input_args.result_cols = result_cols_frame_aligned + calculate_pad_cols(result_cols_frame_aligned, frame->result_type_size);
+    input_args.result_rows = result_rows_frame_aligned + calculate_pad_rows(result_rows_frame_aligned, frame->output_type_size);
+    input_args.result_cols = result_cols_frame_aligned + calculate_pad_cols(result_cols_frame_aligned, frame->output_type_size);
     input_args.matrix1_type_size = frame->matrix1_type_size;
     input_args.matrix2_type_size = frame->matrix2_type_size;
     input_args.result_type_size = frame->result_type_size;
+    input_args.matrix1_dtype = frame->matrix1_dtype;
+    input_args.matrix2_dtype = frame->matrix2_dtype;
+    input_args.result_dtype = frame->result_dtype;
+    input_args.output_dtype = frame->output_dtype;
+    input_args.epilogue_flags = frame->epilogue_flags;
+    input_args.epilogue_start_offset = frame->epilogue_start_offset;
+    input_args.clamp_min = frame->clamp_min;
+    input_args.clamp_max = frame->clamp_max;
+    input_args.matrix2_layout = frame->matrix2_pending_transpose ? DPU_PIM_LAYOUT_ROW_MAJOR : DPU_PIM_LAYOUT_COLUMN_MAJOR;
+    input_args.matrix2_staging_offset = frame->matrix2_staging_offset;
 
+    PIM_STATS_TIMESTAMP(args_start);
     DPU_FOREACH(frame->dpu_set, dpu) {
         DPU_ASSERT(dpu_prepare_xfer(dpu, &input_args));
     }
 
     DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_TO_DPU, "MATRIX_MULTIPLY_ARGUMENTS", 0,
                             sizeof(dpu_pim_matrix_multiply_kernel_arguments_t), DPU_XFER_DEFAULT));
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_PUSH_ARGS, args_start,
+                     (uint64_t)frame->num_dpus * sizeof(dpu_pim_matrix_multiply_kernel_arguments_t),
+                     (uint64_t)frame->num_dpus * sizeof(dpu_pim_matrix_multiply_kernel_arguments_t));
 
+    PIM_STATS_TIMESTAMP(launch_start);
     DPU_ASSERT(dpu_launch(frame->dpu_set, DPU_SYNCHRONOUS));
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_LAUNCH, launch_start, 0, 0);
+    int status = pim_kernel_registry_read_status(frame->dpu_set, frame->num_dpus);
+    // The DPUs keep the converted slice for later launches; the outer-product GEMM leaves the slice row-major
+    if (status == 0 && input_args.gemm_variant != DPU_PIM_GEMM_OUTER) frame->matrix2_pending_transpose = false;
+#if PIM_ENABLE_STATS
+    if (pim_trace_enabled()) {
+        pim_dpu_stats_t dpu_stats;
+        if (pim_dpu_stats_collect(frame->dpu_set, frame->num_dpus, frame->kernel.nr_tasklets, &dpu_stats) == 0) {
+            pim_trace_dpu_launch("gemm", launch_start, &dpu_stats);
+            pim_dpu_stats_free(&dpu_stats);
+        }
+    }
+#endif
 
-    // #ifdef DEBUG
+#if PIM_LOG_LEVEL >= PIM_LOG_LEVEL_DEBUG
     DPU_FOREACH(frame->dpu_set, dpu) {
-        DPU_ASSERT(dpu_log_read(dpu, stdout));
+        DPU_ASSERT(dpu_log_read(dpu, stderr));
     }
-    // #endif // DEBUG
+#endif
 
-    frame->result_valid = true; // Mark result as valid after execution
-    return;
+    frame->result_valid = status == 0; // A failed launch leaves no valid result
+    return status;
 }
 
 Matrix * pim_matrix_multiplication_frame_get_result(pim_matrix_multiplication_frame_t* frame) {
     if (!frame) {
-        fprintf(stderr, "Frame is NULL\n");
+        PIM_LOG_ERROR("Frame is NULL");
+        return NULL;
+    }
+    if (!frame->result_valid) {
+        PIM_LOG_ERROR("PIM frame has no valid result");
         return NULL;
     }
     
@@ -328,24 +643,24 @@ Matrix * pim_matrix_multiplication_frame_get_result(pim_matrix_multiplication_fr
     
     uint32_t result_rows_frame_aligned = ((frame->result_rows + (frame->work_group_size - (frame->result_rows % frame->work_group_size)) % frame->work_group_size)) / frame->work_group_size;
     uint32_t result_cols_frame_aligned = ((frame->result_cols + (frame->num_work_groups - (frame->result_cols % frame->num_work_groups)) % frame->num_work_groups)) / frame->num_work_groups;
-    uint32_t result_rows_dpu_transfer_aligned = result_rows_frame_aligned + calculate_pad_rows(result_rows_frame_aligned, frame->result_type_size);
-    uint32_t result_cols_dpu_transfer_aligned = result_cols_frame_aligned + calculate_pad_cols(result_cols_frame_aligned, frame->result_type_size);
-    uint32_t result_size_aligned = result_rows_dpu_transfer_aligned * result_cols_dpu_transfer_aligned * frame->matrix2_type_size;
+    uint32_t result_rows_dpu_transfer_aligned = result_rows_frame_aligned + calculate_pad_rows(result_rows_frame_aligned, frame->output_type_size);
+    uint32_t result_cols_dpu_transfer_aligned = result_cols_frame_aligned + calculate_pad_cols(result_cols_frame_aligned, frame->output_type_size);
+    uint32_t result_size_aligned = result_rows_dpu_transfer_aligned * result_cols_dpu_transfer_aligned * frame->output_type_size;
     uint32_t result_submatrices_by_rows = frame->work_group_size;
     uint32_t result_submatrices_by_cols = frame->num_work_groups;
     
-    printf("Result matrix size: %u rows, %u cols, %u type size, total size: %u bytes\n",
-           result_rows_frame_aligned, result_cols_frame_aligned, frame->result_type_size, result_size_aligned);
+    PIM_LOG_DEBUG("Result tile: %u rows, %u cols, %u type size, total size: %u bytes",
+                  result_rows_frame_aligned, result_cols_frame_aligned, frame->output_type_size, result_size_aligned);
     
     submatrices_data = (void***)malloc(result_submatrices_by_rows * sizeof(void**));
     if (!submatrices_data) {
-        fprintf(stderr, "Failed to allocate memory for submatrices data\n");
+        PIM_LOG_ERROR("Failed to allocate memory for submatrices data");
         goto cleanup;
     }
     
     submatrices_row_populated = (bool*)malloc(result_submatrices_by_rows * sizeof(bool));
     if (!submatrices_row_populated) {
-        fprintf(stderr, "Failed to allocate memory for submatrices row populated flags\n");
+        PIM_LOG_ERROR("Failed to allocate memory for submatrices row populated flags");
         goto cleanup;
     }
     
@@ -356,6 +671,7 @@ Matrix * pim_matrix_multiplication_frame_get_result(pim_matrix_multiplication_fr
     
     uint32_t i;
     struct dpu_set_t dpu;
+    PIM_STATS_TIMESTAMP(pull_start);
     DPU_FOREACH(frame->dpu_set, dpu, i) {
         uint32_t row = i % result_submatrices_by_rows;
         uint32_t col = i / result_submatrices_by_rows;
@@ -363,7 +679,7 @@ Matrix * pim_matrix_multiplication_frame_get_result(pim_matrix_multiplication_fr
         if (!submatrices_row_populated[row]) {
             submatrices_data[row] = malloc(result_submatrices_by_cols * sizeof(void*));
             if (!submatrices_data[row]) {
-                fprintf(stderr, "Failed to allocate memory for submatrix data row\n");
+                PIM_LOG_ERROR("Failed to allocate memory for submatrix data row");
                 goto cleanup;
             }
             for (uint32_t j = 0; j < result_submatrices_by_cols; j++) {
@@ -372,26 +688,29 @@ Matrix * pim_matrix_multiplication_frame_get_result(pim_matrix_multiplication_fr
             submatrices_row_populated[row] = true;
         }
         
-        submatrices_data[row][col] = malloc(result_rows_dpu_transfer_aligned * result_cols_dpu_transfer_aligned * frame->result_type_size);
+        submatrices_data[row][col] = malloc(result_size_aligned);
         if (!submatrices_data[row][col]) {
-            fprintf(stderr, "Failed to allocate memory for submatrix data element\n");
+            PIM_LOG_ERROR("Failed to allocate memory for submatrix data element");
             goto cleanup;
         }
         DPU_ASSERT(dpu_prepare_xfer(dpu, submatrices_data[row][col]));
     }
     
     DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_FROM_DPU, DPU_MRAM_HEAP_POINTER_NAME, frame->result_start_offset,
-                            result_rows_dpu_transfer_aligned * result_cols_dpu_transfer_aligned * frame->result_type_size, DPU_XFER_DEFAULT));
+                            result_size_aligned, DPU_XFER_DEFAULT));
+    uint64_t result_payload = (uint64_t)frame->result_rows * frame->result_cols * frame->output_type_size;
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_PULL_RESULT, pull_start, result_payload, (uint64_t)frame->num_dpus * result_size_aligned);
+    PIM_STATS_TIMESTAMP(unpack_start);
     
     submatrices = (Matrix***)malloc(result_submatrices_by_rows * sizeof(Matrix**));
     if (!submatrices) {
-        fprintf(stderr, "Failed to allocate memory for submatrices\n");
+        PIM_LOG_ERROR("Failed to allocate memory for submatrices");
         goto cleanup;
     }
     
     row_submatrices = (Matrix**)malloc(result_submatrices_by_rows * sizeof(Matrix*));
     if (!row_submatrices) {
-        fprintf(stderr, "Failed to allocate memory for row submatrices\n");
+        PIM_LOG_ERROR("Failed to allocate memory for row submatrices");
         goto cleanup;
     }
     
@@ -403,7 +722,7 @@ Matrix * pim_matrix_multiplication_frame_get_result(pim_matrix_multiplication_fr
     for (uint32_t i = 0; i < result_submatrices_by_rows; i++) {
         submatrices[i] = (Matrix**)malloc(result_submatrices_by_cols * sizeof(Matrix*));
         if (!submatrices[i]) {
-            fprintf(stderr, "Failed to allocate memory for submatrix row %u\n", i);
+            PIM_LOG_ERROR("Failed to allocate memory for submatrix row %u", i);
             goto cleanup;
         }
         
@@ -412,17 +731,18 @@ Matrix * pim_matrix_multiplication_frame_get_result(pim_matrix_multiplication_fr
         }
         
         for (uint32_t j = 0; j < result_submatrices_by_cols; j++) {
-            submatrices[i][j] = matrix_create_from_row_major_array(result_rows_dpu_transfer_aligned, result_cols_dpu_transfer_aligned, submatrices_data[i][j], frame->result_type_size);
+            submatrices[i][j] = matrix_create_from_row_major_array(result_rows_dpu_transfer_aligned, result_cols_dpu_transfer_aligned, submatrices_data[i][j], frame->output_type_size);
             if (!submatrices[i][j]) {
-                fprintf(stderr, "Failed to create submatrix from row major array\n");
+                PIM_LOG_ERROR("Failed to create submatrix from row major array");
                 goto cleanup;
             }
             
-            printf("Submatrix %d:%d for PIM frame\n%s", i, j, matrix_sprint(submatrices[i][j], "| %u |"));
+            PIM_LOG_TRACE("Result submatrix %u:%u for PIM frame: shape=%dx%d checksum=%08x", i, j,
+                          submatrices[i][j]->rows, submatrices[i][j]->cols, matrix_checksum(submatrices[i][j]));
             
             Matrix *extracted = matrix_extract_submatrix(submatrices[i][j], result_rows_frame_aligned, result_cols_frame_aligned);
             if (!extracted) {
-                fprintf(stderr, "Failed to extract submatrix\n");
+                PIM_LOG_ERROR("Failed to extract submatrix");
                 goto cleanup;
             }
             matrix_free(submatrices[i][j]);
@@ -431,25 +751,26 @@ Matrix * pim_matrix_multiplication_frame_get_result(pim_matrix_multiplication_fr
         
         row_submatrices[i] = matrix_join_by_cols(submatrices[i], result_submatrices_by_cols);
         if (!row_submatrices[i]) {
-            fprintf(stderr, "Failed to join submatrices by columns\n");
+            PIM_LOG_ERROR("Failed to join submatrices by columns");
             goto cleanup;
         }
     }
     
     result = matrix_join_by_rows(row_submatrices, result_submatrices_by_rows);
     if (!result) {
-        fprintf(stderr, "Failed to join submatrices by rows\n");
+        PIM_LOG_ERROR("Failed to join submatrices by rows");
         goto cleanup;
     }
     
     Matrix *final_result = matrix_extract_submatrix(result, frame->result_rows, frame->result_cols);
     if (!final_result) {
-        fprintf(stderr, "Failed to extract final result submatrix\n");
+        PIM_LOG_ERROR("Failed to extract final result submatrix");
         goto cleanup;
     }
     
     matrix_free(result);
     result = final_result;
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_UNPACK_RESULT, unpack_start, result_payload, result_payload);
     
     // Clean up intermediate allocations but keep the result
     if (submatrices) {
@@ -536,4 +857,194 @@ cleanup:
     if (submatrices_row_populated) free(submatrices_row_populated);
     
     return NULL;
-}
\ No newline at end of file
+}
+
+// Copy count elements of element_size bytes, reading every src_stride-th element of src
+static void copy_strided_elements(uint8_t* dst, const uint8_t* src, uint32_t count, uint32_t src_stride, uint32_t element_size) {
+    if (src_stride == 1) {
+        memcpy(dst, src, (size_t)count * element_size);
+        return;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        memcpy(dst + (size_t)i * element_size, src + (size_t)i * src_stride * element_size, element_size);
+    }
+}
+
+int pim_matrix_multiplication_frame_load_first_matrix_strided(pim_matrix_multiplication_frame_t* frame, const void* data, uint32_t ld, bool transposed) {
+    if (!frame || !data) return -1;
+    if (ld < (transposed ? frame->matrix1_rows : frame->matrix1_cols)) {
+        PIM_LOG_ERROR("Leading dimension %u too small for first matrix", ld);
+        return -1;
+    }
+    PIM_STATS_TIMESTAMP(pack_start);
+
+    // Row slices in the same padded row-major layout as pim_matrix_multiplication_frame_load_first_matrix
+    uint32_t element_size = frame->matrix1_type_size;
+    uint32_t split_rows = (frame->matrix1_rows + (frame->work_group_size - (frame->matrix1_rows % frame->work_group_size)) % frame->work_group_size) / frame->work_group_size;
+    uint32_t slice_rows = split_rows + calculate_pad_rows(split_rows, element_size);
+    uint32_t slice_cols = frame->matrix1_cols + calculate_pad_cols(frame->matrix1_cols, element_size);
+    size_t slice_size = (size_t)slice_rows * slice_cols * element_size;
+    uint8_t* slices = (uint8_t*)calloc(frame->work_group_size, slice_size);
+    if (!slices) {
+        PIM_LOG_ERROR("Failed to allocate memory for first matrix slices");
+        return -1;
+    }
+
+    const uint8_t* source = (const uint8_t*)data;
+    for (uint32_t r = 0; r < frame->matrix1_rows; r++) {
+        uint8_t* dst = slices + (r / split_rows) * slice_size + (size_t)(r % split_rows) * slice_cols * element_size;
+        // op(A)[r][k] is A[r*ld + k], or A[k*ld + r] when transposed
+        const uint8_t* src = transposed ? source + (size_t)r * element_size : source + (size_t)r * ld * element_size;
+        copy_strided_elements(dst, src, frame->matrix1_cols, transposed ? ld : 1, element_size);
+    }
+    uint64_t matrix1_payload = (uint64_t)frame->matrix1_rows * frame->matrix1_cols * element_size;
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_PACK_MATRIX1, pack_start, matrix1_payload, frame->work_group_size * slice_size);
+
+    uint32_t i;
+    struct dpu_set_t dpu;
+    DPU_FOREACH(frame->dpu_set, dpu, i) {
+        DPU_ASSERT(dpu_prepare_xfer(dpu, slices + (i % frame->work_group_size) * slice_size));
+    }
+    PIM_STATS_TIMESTAMP(push_start);
+    DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_TO_DPU, DPU_MRAM_HEAP_POINTER_NAME, frame->matrix1_start_offset, slice_size, DPU_XFER_DEFAULT));
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_PUSH_MATRIX1, push_start, frame->num_work_groups * matrix1_payload, frame->num_dpus * slice_size);
+    // Slice padding is zero, so the packed slices have the value range of op(A)
+    frame->matrix1_lut_range = lut_scan_needed(frame, frame->matrix1_dtype) &&
+        pim_dtype_values_fit_bits(frame->matrix1_dtype, slices, frame->work_group_size * slice_size, DPU_PIM_GEMM_LUT_BITS);
+    free(slices);
+    frame->result_valid = false; // Reset result validity after loading new matrix
+    return 0;
+}
+
+int pim_matrix_multiplication_frame_load_second_matrix_strided(pim_matrix_multiplication_frame_t* frame, const void* data, uint32_t ld, bool transposed) {
+    if (!frame || !data) return -1;
+    if (ld < (transposed ? frame->matrix2_rows : frame->matrix2_cols)) {
+        PIM_LOG_ERROR("Leading dimension %u too small for second matrix", ld);
+        return -1;
+    }
+    uint32_t element_size = frame->matrix2_type_size;
+    if (!transposed) {
+        // Rows of B are rows of the slices, so B goes row-major and the DPUs convert it
+        if (push_second_matrix_row_major(frame, data, ld, NULL) != 0) return -1;
+        frame->matrix2_lut_range = lut_scan_needed(frame, frame->matrix2_dtype);
+        for (uint32_t r = 0; r < frame->matrix2_rows && frame->matrix2_lut_range; r++) {
+            frame->matrix2_lut_range = pim_dtype_values_fit_bits(frame->matrix2_dtype, (const uint8_t*)data + (size_t)r * ld * element_size,
+                                                                 frame->matrix2_cols, DPU_PIM_GEMM_LUT_BITS);
+        }
+        return 0;
+    }
+    PIM_STATS_TIMESTAMP(pack_start);
+
+    // A transposed B holds the columns of op(B) contiguously, so it packs into the column-major slices with plain copies
+    uint32_t split_cols = (frame->matrix2_cols + (frame->num_work_groups - (frame->matrix2_cols % frame->num_work_groups)) % frame->num_work_groups) / frame->num_work_groups;
+    uint32_t slice_rows = frame->matrix2_rows + calculate_pad_rows(frame->matrix2_rows, element_size);
+    uint32_t slice_cols = split_cols + calculate_pad_cols(split_cols, element_size);
+    size_t slice_size = (size_t)slice_rows * slice_cols * element_size;
+    uint8_t* slices = (uint8_t*)calloc(frame->num_work_groups, slice_size);
+    if (!slices) {
+        PIM_LOG_ERROR("Failed to allocate memory for second matrix slices");
+        return -1;
+    }
+
+    const uint8_t* source = (const uint8_t*)data;
+    for (uint32_t c = 0; c < frame->matrix2_cols; c++) {
+        uint8_t* dst = slices + (c / split_cols) * slice_size + (size_t)(c % split_cols) * slice_rows * element_size;
+        // op(B)[k][c] is B[c*ld + k]
+        memcpy(dst, source + (size_t)c * ld * element_size, (size_t)frame->matrix2_rows * element_size);
+    }
+    uint64_t matrix2_payload = (uint64_t)frame->matrix2_rows * frame->matrix2_cols * element_size;
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_PACK_MATRIX2, pack_start, matrix2_payload, frame->num_work_groups * slice_size);
+
+    uint32_t i;
+    struct dpu_set_t dpu;
+    DPU_FOREACH(frame->dpu_set, dpu, i) {
+        DPU_ASSERT(dpu_prepare_xfer(dpu, slices + (i / frame->work_group_size) * slice_size));
+    }
+    PIM_STATS_TIMESTAMP(push_start);
+    DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_TO_DPU, DPU_MRAM_HEAP_POINTER_NAME, frame->matrix2_start_offset, slice_size, DPU_XFER_DEFAULT));
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_PUSH_MATRIX2, push_start, frame->work_group_size * matrix2_payload, frame->num_dpus * slice_size);
+    frame->matrix2_lut_range = lut_scan_needed(frame, frame->matrix2_dtype) &&
+        pim_dtype_values_fit_bits(frame->matrix2_dtype, slices, frame->num_work_groups * slice_size, DPU_PIM_GEMM_LUT_BITS);
+    free(slices);
+    frame->matrix2_pending_transpose = false;
+    frame->matrix2_staged = false;
+    frame->result_valid = false; // Reset result validity after loading new matrix
+    return 0;
+}
+
+int pim_matrix_multiplication_frame_get_result_into(pim_matrix_multiplication_frame_t* frame, void* result, uint32_t ld) {
+    if (!frame || !result) return -1;
+    if (!frame->result_valid) {
+        PIM_LOG_ERROR("PIM frame has no valid result");
+        return -1;
+    }
+    if (ld < frame->result_cols) {
+        PIM_LOG_ERROR("Leading dimension %u too small for result matrix", ld);
+        return -1;
+    }
+
+    uint32_t element_size = frame->output_type_size;
+    uint32_t split_rows = ((frame->result_rows + (frame->work_group_size - (frame->result_rows % frame->work_group_size)) % frame->work_group_size)) / frame->work_group_size;
+    uint32_t split_cols = ((frame->result_cols + (frame->num_work_groups - (frame->result_cols % frame->num_work_groups)) % frame->num_work_groups)) / frame->num_work_groups;
+    uint32_t tile_rows = split_rows + calculate_pad_rows(split_rows, element_size);
+    uint32_t tile_cols = split_cols + calculate_pad_cols(split_cols, element_size);
+    size_t tile_size = (size_t)tile_rows * tile_cols * element_size;
+    uint8_t* tiles = (uint8_t*)malloc((size_t)frame->num_dpus * tile_size);
+    if (!tiles) {
+        PIM_LOG_ERROR("Failed to allocate memory for result tiles");
+        return -1;
+    }
+
+    PIM_STATS_TIMESTAMP(pull_start);
+    uint32_t i;
+    struct dpu_set_t dpu;
+    DPU_FOREACH(frame->dpu_set, dpu, i) {
+        DPU_ASSERT(dpu_prepare_xfer(dpu, tiles + i * tile_size));
+    }
+    DPU_ASSERT(dpu_push_xfer(frame->dpu_set, DPU_XFER_FROM_DPU, DPU_MRAM_HEAP_POINTER_NAME, frame->result_start_offset, tile_size, DPU_XFER_DEFAULT));
+    uint64_t result_payload = (uint64_t)frame->result_rows * frame->result_cols * element_size;
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_PULL_RESULT, pull_start, result_payload, frame->num_dpus * tile_size);
+    PIM_STATS_TIMESTAMP(unpack_start);
+
+    // Copy the valid part of every tile straight into the strided destination
+    uint8_t* destination = (uint8_t*)result;
+    for (i = 0; i < frame->num_dpus; i++) {
+        uint32_t row_start = (i % frame->work_group_size) * split_rows;
+        uint32_t col_start = (i / frame->work_group_size) * split_cols;
+        if (row_start >= frame->result_rows || col_start >= frame->result_cols) continue;
+        uint32_t rows = frame->result_rows - row_start < split_rows ? frame->result_rows - row_start : split_rows;
+        uint32_t cols = frame->result_cols - col_start < split_cols ? frame->result_cols - col_start : split_cols;
+        for (uint32_t r = 0; r < rows; r++) {
+            memcpy(destination + ((size_t)(row_start + r) * ld + col_start) * element_size,
+                   tiles + i * tile_size + (size_t)r * tile_cols * element_size, (size_t)cols * element_size);
+        }
+    }
+    free(tiles);
+    PIM_STATS_RECORD(&frame->stats, PIM_STATS_UNPACK_RESULT, unpack_start, result_payload, result_payload);
+    return 0;
+}
+
+int pim_matrix_multiplication_frame_get_stats(const pim_matrix_multiplication_frame_t* frame, pim_stats_t* stats) {
+    if (!frame || !stats) return -1;
+#if PIM_ENABLE_STATS
+    *stats = frame->stats;
+    return 0;
+#else
+    memset(stats, 0, sizeof(*stats));
+    return -1;
+#endif
+}
+
+void pim_matrix_multiplication_frame_reset_stats(pim_matrix_multiplication_frame_t* frame) {
+    if (!frame) return;
+    memset(&frame->stats, 0, sizeof(frame->stats));
+}
+
+int pim_matrix_multiplication_frame_get_dpu_stats(pim_matrix_multiplication_frame_t* frame, pim_dpu_stats_t* stats) {
+    if (!frame || !stats) return -1;
+    if (!frame->result_valid) {
+        PIM_LOG_ERROR("PIM frame has not been executed");
+        return -1;
+    }
+    return pim_dpu_stats_collect(frame->dpu_set, frame->num_dpus, frame->kernel.nr_tasklets, stats);
+}
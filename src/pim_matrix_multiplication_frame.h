@@ -3,6 +3,33 @@
 
 #include <dpu.h>
 
+#include <matrix.h>
+
+#include "pim_dpu_pool.h"
+#include "pim_kernel_registry.h"
+#include "pim_dtype.h"
+#include "pim_stats.h"
+#include "pim_dpu_stats.h"
+
+#ifndef PIM_GEMM_OUTER_MIN_INNER
+#define PIM_GEMM_OUTER_MIN_INNER 64   ///< Shortest inner dimension for which new frames prefer DPU_PIM_GEMM_OUTER
+#endif
+
+/**
+ * @brief Fused epilogue applied on the DPU before the result is written back.
+ * @details `flags` combines `dpu_pim_epilogue_flags_t` stages. Per-column arrays hold `result_cols` entries and
+ *          are only read for the stages that need them. Requantisation maps int32 results to int8 as
+ *          round(value * multiplier[col] / 2^shift[col]), so a quarter of the bytes are written back and pulled.
+ */
+typedef struct {
+    uint32_t flags;                 ///< dpu_pim_epilogue_flags_t bitmask, 0 disables the epilogue
+    const int32_t* bias;            ///< Per-column bias for DPU_PIM_EPILOGUE_BIAS
+    const int32_t* multiplier;      ///< Per-column multiplier for DPU_PIM_EPILOGUE_REQUANTIZE
+    const int32_t* shift;           ///< Per-column right shift for DPU_PIM_EPILOGUE_REQUANTIZE
+    int32_t clamp_min;              ///< Lower bound for DPU_PIM_EPILOGUE_CLAMP
+    int32_t clamp_max;              ///< Upper bound for DPU_PIM_EPILOGUE_CLAMP
+} pim_matrix_multiplication_epilogue_t;
+
 typedef struct {
     uint32_t num_work_groups;
     uint32_t work_group_size;
@@ -16,18 +43,41 @@ typedef struct {
     uint32_t matrix1_type_size;       ///< Size of first matrix elements (1 for
     uint32_t matrix2_type_size;       ///< Size of second matrix elements (1 for
     uint32_t result_type_size;        ///< Size of result matrix elements (2 for
+    dpu_pim_dtype_t matrix1_dtype;    ///< Element type of the first matrix
+    dpu_pim_dtype_t matrix2_dtype;    ///< Element type of the second matrix
+    dpu_pim_dtype_t result_dtype;     ///< Element type of the result matrix
+    dpu_pim_dtype_t output_dtype;     ///< Element type written back after the epilogue
+    uint32_t output_type_size;        ///< Size of elements written back after the epilogue
+    uint32_t epilogue_flags;          ///< Fused epilogue stages (dpu_pim_epilogue_flags_t bitmask)
+    int32_t clamp_min;                ///< Lower bound for DPU_PIM_EPILOGUE_CLAMP
+    int32_t clamp_max;                ///< Upper bound for DPU_PIM_EPILOGUE_CLAMP
+    dpu_pim_gemm_variant_t gemm_variant; ///< GEMM implementation run on the DPUs
+    bool gemm_variant_auto;           ///< Whether the GEMM implementation is chosen from the loaded operands
+    bool matrix1_lut_range;           ///< Whether the loaded first matrix fits DPU_PIM_GEMM_LUT_BITS bits; false when not scanned
+    bool matrix2_lut_range;           ///< Whether the loaded second matrix fits DPU_PIM_GEMM_LUT_BITS bits; false when not scanned
     uint32_t matrix1_start_offset;    ///< MRAM offset for first matrix
     uint32_t matrix2_start_offset;    ///< MRAM offset for second matrix
+    uint32_t matrix2_staging_offset;  ///< MRAM offset for the second matrix pushed row-major, converted on the DPUs; the last region
+    bool matrix2_pending_transpose;   ///< Whether the staged second matrix is converted at the next launch
+    bool matrix2_staged;              ///< Whether the staging region holds the loaded second matrix, as DPU_PIM_GEMM_OUTER reads it
+    bool matrix2_staging_reserved;    ///< Whether the layout includes the staging region, reserved by the first row-major load
     uint32_t result_start_offset;     ///< MRAM offset for result matrix
-    uint32_t mem_frame_end;           ///< MRAM offset for end of memory frame
+    uint32_t epilogue_start_offset;   ///< MRAM offset for per-column epilogue parameters
+    uint32_t mem_frame_end;           ///< MRAM offset for end of memory frame; grows when the staging region is reserved
     bool result_valid;              ///< Flag indicating if result is valid
     struct dpu_set_t dpu_set; ///< DPU set for execution
+    pim_dpu_pool_entry_t* dpu_pool_entry; ///< Pool entry owning the DPU set
+    pim_kernel_descriptor_t kernel; ///< DPU kernel selected for the frame
+    dpu_pim_kernel_plan_t kernel_plan; ///< WRAM plan of the kernel binary, read when the frame is created
+    pim_stats_t stats;              ///< Host phase counters, see `pim_matrix_multiplication_frame_get_stats`
 } pim_matrix_multiplication_frame_t;
 
 /**
  * @brief Create a new PIM matrix multiplication frame - a structure for managing
  *        the state and data of a matrix multiplication operation on a PIM architecture.
- * @details This function allocates memory for the frame, initializes how the matrices should be split to optimize the memory utilization.
+ * @details Element sizes are mapped to element types with `pim_dtype_from_sizes`, so 1-byte operands are treated as
+ *          uint8 and a 2-byte result as uint16. Use `create_pim_matrix_multiplication_frame_typed` for signed inputs.
+ *          See `create_pim_matrix_multiplication_frame_typed` for the remaining behaviour.
  * @param num_dpus Number of DPUs to use.
  * @param dpu_offset Offset for DPU memory.
  * @param matrix1_rows Number of rows in the first matrix.
@@ -47,8 +97,80 @@ pim_matrix_multiplication_frame_t* create_pim_matrix_multiplication_frame(uint32
                                                                         uint32_t result_rows, uint32_t result_cols,
                                                                         uint32_t matrix1_type_size, uint32_t matrix2_type_size, uint32_t result_type_size);
 
+/**
+ * @brief Create a new PIM matrix multiplication frame for the given element types.
+ * @details This function allocates memory for the frame, initializes how the matrices should be split to optimize the memory utilization.
+ *          The DPUs are split into row and column groups so that the estimated time to push both operand slices is
+ *          smallest; estimates come from the transfer calibration when one is available (see pim_xfer_model.h).
+ *          Supported combinations are listed in `pim_dtype_gemm_supported`; products are accumulated in at least 32 bits
+ *          on the DPU, so only the final store narrows to the result type.
+ *          The DPU kernel binary is selected from the kernel registry according to the element types and the
+ *          per-DPU result slice. The DPU set is taken from the process-wide DPU pool, so repeated frame creation
+ *          reuses allocated DPUs and skips loading the binary when it is already resident.
+ * @param num_dpus Number of DPUs to use.
+ * @param dpu_offset Offset for DPU memory.
+ * @param matrix1_rows Number of rows in the first matrix.
+ * @param matrix1_cols Number of columns in the first matrix.
+ * @param matrix2_rows Number of rows in the second matrix.
+ * @param matrix2_cols Number of columns in the second matrix.
+ * @param result_rows Number of rows in the result matrix.
+ * @param result_cols Number of columns in the result matrix.
+ * @param matrix1_dtype Element type of the first matrix.
+ * @param matrix2_dtype Element type of the second matrix.
+ * @param result_dtype Element type of the result matrix.
+ * @return Pointer to the new frame, or NULL on failure.
+ */
+pim_matrix_multiplication_frame_t* create_pim_matrix_multiplication_frame_typed(uint32_t num_dpus, uint32_t dpu_offset,
+                                                                              uint32_t matrix1_rows, uint32_t matrix1_cols,
+                                                                              uint32_t matrix2_rows, uint32_t matrix2_cols,
+                                                                              uint32_t result_rows, uint32_t result_cols,
+                                                                              dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype);
+
+/**
+ * @brief Destroy a PIM matrix multiplication frame.
+ * @details The DPU set is returned to the DPU pool (not freed) and the frame memory is released.
+ * @param frame Pointer to the PIM matrix multiplication frame.
+ */
 void destroy_pim_matrix_multiplication_frame(pim_matrix_multiplication_frame_t* frame);
 
+/**
+ * @brief Configure the fused epilogue of the frame.
+ * @details The per-column parameters are pushed to the DPUs immediately. The result region is sized for either
+ *          output element type, so matrices that are already loaded stay valid. Requantisation requires an int32 result
+ *          and makes `pim_matrix_multiplication_frame_get_result` return an int8 matrix.
+ * @param frame Pointer to the PIM matrix multiplication frame.
+ * @param epilogue Epilogue configuration, or NULL to disable the epilogue.
+ * @return 0 on success, -1 on invalid configuration.
+ */
+int pim_matrix_multiplication_frame_set_epilogue(pim_matrix_multiplication_frame_t* frame, const pim_matrix_multiplication_epilogue_t* epilogue);
+
+/**
+ * @brief Select the GEMM implementation run on the DPUs.
+ * @details All variants produce the same result from the loaded matrices, so the variant can be changed between
+ *          executions without reloading them. New frames choose the variant from the loaded operands: 8-bit
+ *          operands whose values all fit `DPU_PIM_GEMM_LUT_BITS` bits run `DPU_PIM_GEMM_LUT`. Otherwise the
+ *          outer-product form `DPU_PIM_GEMM_OUTER` runs when it is supported, every tasklet gets a band of
+ *          `tile_rows` result rows and the inner dimension has at least `PIM_GEMM_OUTER_MIN_INNER` elements. Anything
+ *          else runs the inner-product form `DPU_PIM_GEMM_TILED`. A variant set explicitly that does not support the
+ *          operands also falls back to `DPU_PIM_GEMM_TILED`. Loads only scan 8-bit operands for the lookup-table range
+ *          while the variant is automatic or `DPU_PIM_GEMM_LUT`, so select the variant before loading the operands.
+ * @param frame Pointer to the PIM matrix multiplication frame.
+ * @param variant GEMM implementation.
+ * @return 0 on success, -1 on an unknown variant.
+ */
+int pim_matrix_multiplication_frame_set_gemm_variant(pim_matrix_multiplication_frame_t* frame, dpu_pim_gemm_variant_t variant);
+
+/**
+ * @brief Whether a GEMM implementation can run on the loaded operands.
+ * @details `DPU_PIM_GEMM_LUT` needs both operands within `DPU_PIM_GEMM_LUT_BITS` bits, as scanned when they were loaded. `DPU_PIM_GEMM_OUTER` needs the
+ *          second matrix loaded row-major (not through a transposed strided load), and slices no wider than the
+ *          `gemm_outer_cols` of the kernel plan. Every other variant serves any operands.
+ * @param frame Pointer to the PIM matrix multiplication frame.
+ * @param variant GEMM implementation.
+ * @return true if `pim_matrix_multiplication_frame_execute` would run the variant instead of falling back.
+ */
+bool pim_matrix_multiplication_frame_supports_gemm_variant(const pim_matrix_multiplication_frame_t* frame, dpu_pim_gemm_variant_t variant);
+
 /**
  * @brief Load the first matrix (Left side of the multiplication) into the frame.
  * @param frame Pointer to the PIM matrix multiplication frame.
@@ -58,16 +180,46 @@ void pim_matrix_multiplication_frame_load_first_matrix(pim_matrix_multiplication
 
 /**
  * @brief Load the second matrix (Right side of the multiplication) into the frame.
+ * @details The rows of B are pushed row-major into a staging region and converted to the column-major layout of the
+ *          GEMM kernels on the DPUs at the next `pim_matrix_multiplication_frame_execute`, so the host never transposes B.
  * @param frame Pointer to the PIM matrix multiplication frame.
  * @param matrix Pointer to the second matrix.
  */
 void pim_matrix_multiplication_frame_load_second_matrix(pim_matrix_multiplication_frame_t* frame, Matrix * matrix);
 
+/**
+ * @brief Load the first matrix from a strided row-major buffer.
+ * @details Packs op(A) straight into the per-DPU row slices, so transposed or sub-matrix operands need no host
+ *          transpose or copy into a `Matrix` first. op(A) is `matrix1_rows` x `matrix1_cols`.
+ * @param frame Pointer to the PIM matrix multiplication frame.
+ * @param data Row-major elements of A, of the frame's first matrix element type.
+ * @param ld Leading dimension (row stride in elements) of A as stored.
+ * @param transposed Whether op(A) is the transpose of the stored A.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_matrix_multiplication_frame_load_first_matrix_strided(pim_matrix_multiplication_frame_t* frame, const void* data, uint32_t ld, bool transposed);
+
+/**
+ * @brief Load the second matrix from a strided row-major buffer.
+ * @details op(B) is `matrix2_rows` x `matrix2_cols`. A transposed B is packed into the column-major per-DPU slices
+ *          with contiguous copies. Otherwise B is pushed row-major like `pim_matrix_multiplication_frame_load_second_matrix`,
+ *          straight from `data` when the frame uses one column slice and the rows of B are whole 8-byte multiples.
+ * @param frame Pointer to the PIM matrix multiplication frame.
+ * @param data Row-major elements of B, of the frame's second matrix element type.
+ * @param ld Leading dimension (row stride in elements) of B as stored.
+ * @param transposed Whether op(B) is the transpose of the stored B.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_matrix_multiplication_frame_load_second_matrix_strided(pim_matrix_multiplication_frame_t* frame, const void* data, uint32_t ld, bool transposed);
+
 /**
  * @brief Execute the matrix multiplication on the PIM architecture.
+ * @details After the launch the status published by every DPU is read back; if any DPU failed, the frame holds no
+ *          valid result.
  * @param frame Pointer to the PIM matrix multiplication frame.
+ * @return 0 on success, -1 if any DPU reported a failure.
  */
-void pim_matrix_multiplication_frame_execute(pim_matrix_multiplication_frame_t* frame);
+int pim_matrix_multiplication_frame_execute(pim_matrix_multiplication_frame_t* frame);
 
 /**
  * @brief Get the result of the matrix multiplication from the frame.
@@ -78,4 +230,42 @@ void pim_matrix_multiplication_frame_execute(pim_matrix_multiplication_frame_t*
  */
 Matrix * pim_matrix_multiplication_frame_get_result(pim_matrix_multiplication_frame_t* frame);
 
+/**
+ * @brief Copy the result of the matrix multiplication into a strided row-major buffer.
+ * @details Like `pim_matrix_multiplication_frame_get_result`, but every DPU tile is copied straight into place
+ *          instead of being assembled into a new `Matrix`. Elements are of the frame's output element type.
+ * @param frame Pointer to the PIM matrix multiplication frame.
+ * @param result Destination buffer of at least `result_rows` rows of `ld` elements.
+ * @param ld Leading dimension (row stride in elements) of the destination.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_matrix_multiplication_frame_get_result_into(pim_matrix_multiplication_frame_t* frame, void* result, uint32_t ld);
+
+/**
+ * @brief Get the host phase counters of the frame.
+ * @details Every load, execute and result call adds its time, byte counts and one call to the phases it runs
+ *          (see `pim_stats_phase_t`). Transfer phases count every byte sent to or pulled from all DPUs, so slices
+ *          replicated across work groups count once per DPU; padding bytes are split and alignment padding.
+ *          Counters accumulate from frame creation or the last `pim_matrix_multiplication_frame_reset_stats`.
+ * @param frame Pointer to the PIM matrix multiplication frame.
+ * @param stats Destination for the counters.
+ * @return 0 on success, -1 on failure or when built with `PIM_ENABLE_STATS=0` (stats are then zeroed).
+ */
+int pim_matrix_multiplication_frame_get_stats(const pim_matrix_multiplication_frame_t* frame, pim_stats_t* stats);
+
+/**
+ * @brief Reset the host phase counters of the frame.
+ * @param frame Pointer to the PIM matrix multiplication frame.
+ */
+void pim_matrix_multiplication_frame_reset_stats(pim_matrix_multiplication_frame_t* frame);
+
+/**
+ * @brief Pull and aggregate the DPU cycle counters of the last execution.
+ * @details See `pim_dpu_stats_t`. Only valid after `pim_matrix_multiplication_frame_execute`.
+ * @param frame Pointer to the PIM matrix multiplication frame.
+ * @param stats Destination; release it with `pim_dpu_stats_free`.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_matrix_multiplication_frame_get_dpu_stats(pim_matrix_multiplication_frame_t* frame, pim_dpu_stats_t* stats);
+
 #endif // __PIM_MATRIX_MULTIPLICATION_FRAME_H___
\ No newline at end of file
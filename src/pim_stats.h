@@ -0,0 +1,117 @@
+#ifndef __PIM_STATS_H___
+#define __PIM_STATS_H___
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "pim_trace.h"
+
+/**
+ * @brief Host-side instrumentation of PIM frames.
+ * @details Enabled by default; build with `-DPIM_ENABLE_STATS=0` to compile every timestamp and counter out, in which
+ *          case the `PIM_STATS_*` macros expand to nothing and their arguments are not evaluated.
+ */
+#ifndef PIM_ENABLE_STATS
+#define PIM_ENABLE_STATS 1
+#endif
+
+/**
+ * @brief Host phases of a PIM matrix multiplication.
+ */
+typedef enum {
+    PIM_STATS_PACK_MATRIX1 = 0,   ///< Splitting, padding and laying out the first matrix slices
+    PIM_STATS_PUSH_MATRIX1,       ///< Transfer of the first matrix slices to MRAM
+    PIM_STATS_PACK_MATRIX2,       ///< Splitting, padding and laying out the second matrix slices
+    PIM_STATS_PUSH_MATRIX2,       ///< Transfer of the second matrix slices to MRAM
+    PIM_STATS_PUSH_EPILOGUE,      ///< Transfer of the per-column epilogue parameters to MRAM
+    PIM_STATS_PUSH_ARGS,          ///< Transfer of the kernel arguments
+    PIM_STATS_LAUNCH,             ///< Synchronous DPU launch
+    PIM_STATS_PULL_RESULT,        ///< Transfer of the result tiles from MRAM
+    PIM_STATS_UNPACK_RESULT,      ///< Clipping and joining the result tiles
+    PIM_STATS_NUM_PHASES
+} pim_stats_phase_t;
+
+/**
+ * @brief Counters of one phase.
+ * @details Byte counts are what the phase moved or produced: `payload_bytes` are matrix elements and
+ *          `padding_bytes` are the alignment and split padding travelling with them.
+ */
+typedef struct {
+    uint64_t calls;            ///< Number of times the phase ran
+    uint64_t nanoseconds;      ///< Total monotonic time spent in the phase
+    uint64_t payload_bytes;    ///< Bytes of matrix data
+    uint64_t padding_bytes;    ///< Bytes of padding
+} pim_stats_phase_counters_t;
+
+/**
+ * @brief Per-phase counters of a frame.
+ */
+typedef struct {
+    pim_stats_phase_counters_t phases[PIM_STATS_NUM_PHASES];
+} pim_stats_t;
+
+/**
+ * @brief Get a printable name of a phase.
+ * @param phase Phase.
+ * @return Static name, or "unknown" for an invalid phase.
+ */
+static inline const char* pim_stats_phase_name(pim_stats_phase_t phase) {
+    switch (phase) {
+        case PIM_STATS_PACK_MATRIX1: return "pack_matrix1";
+        case PIM_STATS_PUSH_MATRIX1: return "push_matrix1";
+        case PIM_STATS_PACK_MATRIX2: return "pack_matrix2";
+        case PIM_STATS_PUSH_MATRIX2: return "push_matrix2";
+        case PIM_STATS_PUSH_EPILOGUE: return "push_epilogue";
+        case PIM_STATS_PUSH_ARGS: return "push_args";
+        case PIM_STATS_LAUNCH: return "launch";
+        case PIM_STATS_PULL_RESULT: return "pull_result";
+        case PIM_STATS_UNPACK_RESULT: return "unpack_result";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Read the monotonic clock.
+ * @return Nanoseconds since an arbitrary fixed point.
+ */
+static inline uint64_t pim_stats_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Account one run of a phase that started at `start_ns`.
+ * @details The run is also recorded as a trace event while tracing is on (see pim_trace.h).
+ * @param stats Counters of the frame.
+ * @param phase Phase that ran.
+ * @param start_ns Timestamp taken with `pim_stats_now_ns` when the phase started.
+ * @param payload_bytes Bytes of matrix data moved or produced.
+ * @param total_bytes All bytes moved or produced, including padding.
+ */
+static inline void pim_stats_record(pim_stats_t* stats, pim_stats_phase_t phase, uint64_t start_ns, uint64_t payload_bytes, uint64_t total_bytes) {
+    uint64_t end_ns = pim_stats_now_ns();
+    uint64_t padding_bytes = total_bytes > payload_bytes ? total_bytes - payload_bytes : 0;
+    pim_stats_phase_counters_t* counters = &stats->phases[phase];
+    counters->calls++;
+    counters->nanoseconds += end_ns - start_ns;
+    counters->payload_bytes += payload_bytes;
+    counters->padding_bytes += padding_bytes;
+    if (pim_trace_enabled()) {
+        pim_trace_arg_t args[2] = {{"payload_bytes", payload_bytes}, {"padding_bytes", padding_bytes}};
+        pim_trace_host_event(pim_stats_phase_name(phase), "host", start_ns, end_ns, args, 2);
+    }
+}
+
+#if PIM_ENABLE_STATS
+#define PIM_STATS_TIMESTAMP(name) uint64_t name = pim_stats_now_ns()
+#define PIM_STATS_RECORD(stats, phase, start_ns, payload_bytes, total_bytes) \
+    pim_stats_record((stats), (phase), (start_ns), (payload_bytes), (total_bytes))
+#else
+#define PIM_STATS_TIMESTAMP(name)
+// sizeof keeps byte-count locals referenced without evaluating them
+#define PIM_STATS_RECORD(stats, phase, start_ns, payload_bytes, total_bytes) ((void)sizeof((payload_bytes) + (total_bytes)))
+#endif
+
+#endif // __PIM_STATS_H___
@@ -0,0 +1,182 @@
+#include <string.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <pthread.h>
+
+#include "pim_stats.h"
+#include "pim_dpu_stats.h"
+#include "pim_log.h"
+
+#include "pim_trace.h"
+
+#define PIM_TRACE_MAX_NAME 48
+#define PIM_TRACE_HOST_PID 0          ///< Trace process of all host threads
+#define PIM_TRACE_DPU_PID_BASE 1      ///< Trace process of DPU i is PIM_TRACE_DPU_PID_BASE + i
+
+typedef struct {
+    char name[PIM_TRACE_MAX_NAME];
+    const char* category;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    uint32_t pid;
+    uint32_t tid;
+    uint32_t num_args;
+    pim_trace_arg_t args[PIM_TRACE_MAX_ARGS];
+} trace_event_t;
+
+static trace_event_t* trace_events = NULL;
+static uint32_t trace_num_events = 0;
+static uint32_t trace_capacity = 0;
+static uint32_t trace_num_dpus = 0;       // Largest DPU count seen, for naming the DPU tracks
+static uint64_t trace_origin_ns = 0;
+static volatile bool trace_recording = false;
+static pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t trace_env_once = PTHREAD_ONCE_INIT;
+static uint32_t trace_next_thread_id = 0;
+static __thread uint32_t trace_thread_id = 0;   // 0 until the thread records its first event
+
+static void trace_write_at_exit(void) {
+    pim_trace_stop(getenv("PIM_TRACE_FILE"));
+}
+
+static void trace_init_from_env(void) {
+    if (getenv("PIM_TRACE_FILE") && pim_trace_start() == 0) {
+        atexit(trace_write_at_exit);
+    }
+}
+
+// Must be called with trace_mutex held
+static trace_event_t* trace_append(void) {
+    if (trace_num_events == trace_capacity) {
+        uint32_t new_capacity = trace_capacity ? trace_capacity * 2 : 1024;
+        trace_event_t* new_events = (trace_event_t*)realloc(trace_events, new_capacity * sizeof(trace_event_t));
+        if (!new_events) {
+            PIM_LOG_ERROR("Failed to grow trace buffer");
+            return NULL;
+        }
+        trace_events = new_events;
+        trace_capacity = new_capacity;
+    }
+    return &trace_events[trace_num_events++];
+}
+
+static void trace_fill(trace_event_t* event, const char* name, const char* category, uint64_t start_ns, uint64_t duration_ns,
+                       uint32_t pid, uint32_t tid, const pim_trace_arg_t* args, uint32_t num_args) {
+    strncpy(event->name, name, PIM_TRACE_MAX_NAME - 1);
+    event->name[PIM_TRACE_MAX_NAME - 1] = '\0';
+    event->category = category;
+    event->start_ns = start_ns;
+    event->duration_ns = duration_ns;
+    event->pid = pid;
+    event->tid = tid;
+    event->num_args = num_args < PIM_TRACE_MAX_ARGS ? num_args : PIM_TRACE_MAX_ARGS;
+    for (uint32_t i = 0; i < event->num_args; i++) {
+        event->args[i] = args[i];
+    }
+}
+
+int pim_trace_start(void) {
+    pthread_mutex_lock(&trace_mutex);
+    trace_num_events = 0;
+    trace_num_dpus = 0;
+    trace_origin_ns = pim_stats_now_ns();
+    trace_recording = true;
+    pthread_mutex_unlock(&trace_mutex);
+    return 0;
+}
+
+int pim_trace_stop(const char* path) {
+    pthread_mutex_lock(&trace_mutex);
+    trace_recording = false;
+    int status = 0;
+    if (path) {
+        FILE* file = fopen(path, "w");
+        if (!file) {
+            PIM_LOG_ERROR("Failed to open trace file %s", path);
+            status = -1;
+        } else {
+            fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+            fprintf(file, "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%u,\"args\":{\"name\":\"host\"}}", PIM_TRACE_HOST_PID);
+            for (uint32_t d = 0; d < trace_num_dpus; d++) {
+                fprintf(file, ",\n{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%u,\"args\":{\"name\":\"DPU %u\"}}",
+                        PIM_TRACE_DPU_PID_BASE + d, d);
+            }
+            for (uint32_t i = 0; i < trace_num_events; i++) {
+                const trace_event_t* event = &trace_events[i];
+                // Chrome trace timestamps are microseconds relative to the start of the trace
+                fprintf(file, ",\n{\"ph\":\"X\",\"name\":\"%s\",\"cat\":\"%s\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+                        event->name, event->category, event->pid, event->tid,
+                        (double)(int64_t)(event->start_ns - trace_origin_ns) / 1000.0, (double)event->duration_ns / 1000.0);
+                for (uint32_t a = 0; a < event->num_args; a++) {
+                    fprintf(file, "%s\"%s\":%llu", a ? "," : "", event->args[a].key, (unsigned long long)event->args[a].value);
+                }
+                fprintf(file, "}}");
+            }
+            fprintf(file, "\n]}\n");
+            if (fclose(file) != 0) {
+                status = -1;
+            }
+        }
+    }
+    free(trace_events);
+    trace_events = NULL;
+    trace_num_events = 0;
+    trace_capacity = 0;
+    pthread_mutex_unlock(&trace_mutex);
+    return status;
+}
+
+bool pim_trace_enabled(void) {
+    pthread_once(&trace_env_once, trace_init_from_env);
+    return trace_recording;
+}
+
+uint32_t pim_trace_event_count(void) {
+    pthread_mutex_lock(&trace_mutex);
+    uint32_t count = trace_num_events;
+    pthread_mutex_unlock(&trace_mutex);
+    return count;
+}
+
+void pim_trace_host_event(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns,
+                          const pim_trace_arg_t* args, uint32_t num_args) {
+    if (!pim_trace_enabled() || !name || !category) return;
+    pthread_mutex_lock(&trace_mutex);
+    if (trace_thread_id == 0) {
+        trace_thread_id = ++trace_next_thread_id;
+    }
+    trace_event_t* event = trace_recording ? trace_append() : NULL;
+    if (event) {
+        trace_fill(event, name, category, start_ns, end_ns > start_ns ? end_ns - start_ns : 0,
+                   PIM_TRACE_HOST_PID, trace_thread_id, args, args ? num_args : 0);
+    }
+    pthread_mutex_unlock(&trace_mutex);
+}
+
+void pim_trace_dpu_launch(const char* name, uint64_t launch_start_ns, const pim_dpu_stats_t* stats) {
+    if (!pim_trace_enabled() || !name || !stats || !stats->tasklets) return;
+    pthread_mutex_lock(&trace_mutex);
+    if (stats->num_dpus > trace_num_dpus) {
+        trace_num_dpus = stats->num_dpus;
+    }
+    for (uint32_t d = 0; d < stats->num_dpus && trace_recording; d++) {
+        for (uint32_t t = 0; t < stats->nr_tasklets; t++) {
+            const dpu_pim_tasklet_stats_t* tasklet = &stats->tasklets[(size_t)d * stats->nr_tasklets + t];
+            trace_event_t* event = trace_append();
+            if (!event) break;
+            pim_trace_arg_t args[PIM_TRACE_MAX_ARGS] = {
+                {"cycles", tasklet->total_cycles},
+                {"mram_read_cycles", tasklet->mram_read_cycles},
+                {"compute_cycles", tasklet->compute_cycles},
+                {"mram_write_cycles", tasklet->mram_write_cycles},
+            };
+            trace_fill(event, name, "dpu", launch_start_ns, tasklet->total_cycles * 1000 / PIM_DPU_FREQUENCY_MHZ,
+                       PIM_TRACE_DPU_PID_BASE + d, t, args, PIM_TRACE_MAX_ARGS);
+        }
+    }
+    pthread_mutex_unlock(&trace_mutex);
+}
@@ -0,0 +1,79 @@
+#ifndef __PIM_TRACE_H___
+#define __PIM_TRACE_H___
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pim_dpu_stats.h"
+
+#ifndef PIM_DPU_FREQUENCY_MHZ
+#define PIM_DPU_FREQUENCY_MHZ 350   ///< DPU clock used to convert cycle counters to host time
+#endif
+
+#define PIM_TRACE_MAX_ARGS 4
+
+/**
+ * @brief Timeline of host and DPU activity in the Chrome trace-event format.
+ * @details Tracing is off by default. Once started, every frame phase timed by `PIM_STATS_RECORD` becomes a
+ *          complete event on the track of the calling thread, and every frame launch adds one event per DPU tasklet
+ *          on a track per DPU. DPU events start at the host timestamp of the launch and last the tasklet's cycles
+ *          converted with PIM_DPU_FREQUENCY_MHZ; their arguments hold the MRAM and compute cycles. The written
+ *          JSON file opens in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *          Setting the `PIM_TRACE_FILE` environment variable starts tracing on first use and writes the file at exit.
+ *          Tracing needs the frame timestamps, so it records nothing when built with `PIM_ENABLE_STATS=0`.
+ */
+
+/**
+ * @brief One named integer argument of an event.
+ */
+typedef struct {
+    const char* key;    ///< Static string naming the argument
+    uint64_t value;
+} pim_trace_arg_t;
+
+/**
+ * @brief Start recording, dropping previously recorded events.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_trace_start(void);
+
+/**
+ * @brief Stop recording and write the recorded events.
+ * @param path Output JSON file, or NULL to discard the events.
+ * @return 0 on success, -1 on failure.
+ */
+int pim_trace_stop(const char* path);
+
+/**
+ * @brief Check whether events are being recorded.
+ * @return true while tracing is on.
+ */
+bool pim_trace_enabled(void);
+
+/**
+ * @brief Get the number of recorded events.
+ * @return Number of events since `pim_trace_start`.
+ */
+uint32_t pim_trace_event_count(void);
+
+/**
+ * @brief Record a host event on the track of the calling thread.
+ * @param name Event name (copied).
+ * @param category Static category string.
+ * @param start_ns Start timestamp from `pim_stats_now_ns`.
+ * @param end_ns End timestamp from `pim_stats_now_ns`.
+ * @param args Event arguments, may be NULL.
+ * @param num_args Number of arguments (at most PIM_TRACE_MAX_ARGS).
+ */
+void pim_trace_host_event(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns,
+                          const pim_trace_arg_t* args, uint32_t num_args);
+
+/**
+ * @brief Record the tasklets of a launch on the per-DPU tracks.
+ * @param name Event name of the operation (copied).
+ * @param launch_start_ns Host timestamp taken just before `dpu_launch`.
+ * @param stats Counters of the launch from `pim_dpu_stats_collect`.
+ */
+void pim_trace_dpu_launch(const char* name, uint64_t launch_start_ns, const pim_dpu_stats_t* stats);
+
+#endif // __PIM_TRACE_H___
@@ -0,0 +1,196 @@
+#include <string.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <pthread.h>
+
+#include "pim_log.h"
+
+#include "pim_xfer_model.h"
+
+#ifndef PIM_XFER_CALIBRATION_FILE
+#define PIM_XFER_CALIBRATION_FILE "/workspace/bin/xfer_calibration.txt"
+#endif
+
+typedef struct {
+    pim_xfer_direction_t direction;
+    uint32_t num_dpus;
+    uint64_t bytes_per_dpu;
+    double nanoseconds;
+} xfer_sample_t;
+
+static const char* direction_names[PIM_XFER_NUM_DIRECTIONS] = {
+    [PIM_XFER_TO_DPU] = "to",
+    [PIM_XFER_FROM_DPU] = "from",
+    [PIM_XFER_BROADCAST] = "broadcast",
+};
+
+static xfer_sample_t* model_samples = NULL;
+static uint32_t model_num_samples = 0;
+static uint32_t model_capacity = 0;
+static bool model_initialized = false;
+static pthread_mutex_t model_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+const char* pim_xfer_direction_name(pim_xfer_direction_t direction) {
+    if ((uint32_t)direction >= PIM_XFER_NUM_DIRECTIONS) return "unknown";
+    return direction_names[direction];
+}
+
+int pim_xfer_direction_from_name(const char* name, pim_xfer_direction_t* direction) {
+    if (!name || !direction) return -1;
+    for (uint32_t i = 0; i < PIM_XFER_NUM_DIRECTIONS; i++) {
+        if (strcmp(name, direction_names[i]) == 0) {
+            *direction = (pim_xfer_direction_t)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int model_append(const xfer_sample_t* sample) {
+    if (model_num_samples == model_capacity) {
+        uint32_t new_capacity = model_capacity ? model_capacity * 2 : 32;
+        xfer_sample_t* new_samples = (xfer_sample_t*)realloc(model_samples, new_capacity * sizeof(xfer_sample_t));
+        if (!new_samples) {
+            PIM_LOG_ERROR("Failed to grow transfer model");
+            return -1;
+        }
+        model_samples = new_samples;
+        model_capacity = new_capacity;
+    }
+    model_samples[model_num_samples++] = *sample;
+    return 0;
+}
+
+static int model_load_file(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+
+    model_num_samples = 0;
+    char line[256];
+    uint32_t line_number = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        char* start = line;
+        while (*start == ' ' || *start == '\t') start++;
+        if (*start == '#' || *start == '\n' || *start == '\0') continue;
+
+        xfer_sample_t sample;
+        char direction[16];
+        unsigned long long bytes_per_dpu;
+        int fields = sscanf(start, "%15s %u %llu %lf", direction, &sample.num_dpus, &bytes_per_dpu, &sample.nanoseconds);
+        sample.bytes_per_dpu = bytes_per_dpu;
+        if (fields != 4 || sample.num_dpus == 0 || sample.bytes_per_dpu == 0 || sample.nanoseconds <= 0 ||
+            pim_xfer_direction_from_name(direction, &sample.direction) != 0) {
+            PIM_LOG_WARN("Malformed transfer calibration entry at %s:%u", path, line_number);
+            continue;
+        }
+        if (model_append(&sample) != 0) {
+            fclose(file);
+            return -1;
+        }
+    }
+    fclose(file);
+    return (int)model_num_samples;
+}
+
+// Must be called with model_mutex held
+static void model_ensure_initialized(void) {
+    if (model_initialized) return;
+    model_initialized = true;
+    const char* path = getenv("PIM_XFER_CALIBRATION");
+    if (!path) {
+        path = PIM_XFER_CALIBRATION_FILE;
+    }
+    if (model_load_file(path) < 0) {
+        model_num_samples = 0;
+    }
+}
+
+int pim_xfer_model_load(const char* path) {
+    if (!path) return -1;
+    pthread_mutex_lock(&model_mutex);
+    model_initialized = true;
+    int loaded = model_load_file(path);
+    if (loaded < 0) {
+        PIM_LOG_ERROR("Failed to read transfer calibration %s", path);
+    }
+    pthread_mutex_unlock(&model_mutex);
+    return loaded;
+}
+
+void pim_xfer_model_clear(void) {
+    pthread_mutex_lock(&model_mutex);
+    free(model_samples);
+    model_samples = NULL;
+    model_num_samples = 0;
+    model_capacity = 0;
+    model_initialized = true;
+    pthread_mutex_unlock(&model_mutex);
+}
+
+bool pim_xfer_model_calibrated(void) {
+    pthread_mutex_lock(&model_mutex);
+    model_ensure_initialized();
+    bool calibrated = model_num_samples > 0;
+    pthread_mutex_unlock(&model_mutex);
+    return calibrated;
+}
+
+static uint32_t distance(uint32_t a, uint32_t b) {
+    return a > b ? a - b : b - a;
+}
+
+double pim_xfer_model_estimate_ns(pim_xfer_direction_t direction, uint32_t num_dpus, uint64_t bytes_per_dpu) {
+    pthread_mutex_lock(&model_mutex);
+    model_ensure_initialized();
+
+    // DPU count measured closest to the request
+    uint32_t group_dpus = 0;
+    for (uint32_t i = 0; i < model_num_samples; i++) {
+        const xfer_sample_t* sample = &model_samples[i];
+        if (sample->direction != direction) continue;
+        if (group_dpus == 0 || distance(sample->num_dpus, num_dpus) < distance(group_dpus, num_dpus)) {
+            group_dpus = sample->num_dpus;
+        }
+    }
+    if (group_dpus == 0) {
+        pthread_mutex_unlock(&model_mutex);
+        return (double)num_dpus * (double)bytes_per_dpu;
+    }
+
+    // Closest measured sizes below and above the request
+    const xfer_sample_t* below = NULL;
+    const xfer_sample_t* above = NULL;
+    for (uint32_t i = 0; i < model_num_samples; i++) {
+        const xfer_sample_t* sample = &model_samples[i];
+        if (sample->direction != direction || sample->num_dpus != group_dpus) continue;
+        if (sample->bytes_per_dpu <= bytes_per_dpu && (!below || sample->bytes_per_dpu > below->bytes_per_dpu)) {
+            below = sample;
+        }
+        if (sample->bytes_per_dpu >= bytes_per_dpu && (!above || sample->bytes_per_dpu < above->bytes_per_dpu)) {
+            above = sample;
+        }
+    }
+
+    double nanoseconds;
+    if (below && above) {
+        if (above->bytes_per_dpu == below->bytes_per_dpu) {
+            nanoseconds = below->nanoseconds;
+        } else {
+            double fraction = (double)(bytes_per_dpu - below->bytes_per_dpu) / (double)(above->bytes_per_dpu - below->bytes_per_dpu);
+            nanoseconds = below->nanoseconds + fraction * (above->nanoseconds - below->nanoseconds);
+        }
+    } else if (above) {
+        nanoseconds = above->nanoseconds;
+    } else {
+        nanoseconds = below->nanoseconds * (double)bytes_per_dpu / (double)below->bytes_per_dpu;
+    }
+    pthread_mutex_unlock(&model_mutex);
+    return nanoseconds * (double)num_dpus / (double)group_dpus;
+}
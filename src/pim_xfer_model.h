@@ -0,0 +1,69 @@
+#ifndef __PIM_XFER_MODEL_H___
+#define __PIM_XFER_MODEL_H___
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Host-DPU transfer kinds covered by the cost model.
+ */
+typedef enum {
+    PIM_XFER_TO_DPU = 0,       ///< Per-DPU buffers pushed with dpu_prepare_xfer/dpu_push_xfer
+    PIM_XFER_FROM_DPU = 1,     ///< Per-DPU buffers pulled with dpu_prepare_xfer/dpu_push_xfer
+    PIM_XFER_BROADCAST = 2,    ///< One buffer sent to every DPU with dpu_broadcast_to
+    PIM_XFER_NUM_DIRECTIONS
+} pim_xfer_direction_t;
+
+/**
+ * @brief Get the calibration file name of a transfer kind ("to", "from", "broadcast").
+ * @param direction Transfer kind.
+ * @return Static name, or "unknown" for an invalid kind.
+ */
+const char* pim_xfer_direction_name(pim_xfer_direction_t direction);
+
+/**
+ * @brief Parse the calibration file name of a transfer kind.
+ * @param name Name as returned by `pim_xfer_direction_name`.
+ * @param direction Destination.
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int pim_xfer_direction_from_name(const char* name, pim_xfer_direction_t* direction);
+
+/**
+ * @brief Load transfer measurements from a calibration file, replacing the current ones.
+ * @details The file is written by `make bench-xfer` (bench/pim-xfer-bench.c). Each non-comment line holds
+ *          `direction num_dpus bytes_per_dpu nanoseconds`, the time of one synchronous transfer of `bytes_per_dpu`
+ *          bytes to or from each of `num_dpus` DPUs. Malformed lines are reported and skipped.
+ * @param path Path of the calibration file.
+ * @return Number of measurements loaded, or -1 if the file cannot be read.
+ */
+int pim_xfer_model_load(const char* path);
+
+/**
+ * @brief Remove all measurements, so estimates fall back to the uncalibrated model.
+ */
+void pim_xfer_model_clear(void);
+
+/**
+ * @brief Check whether any measurement is loaded.
+ * @details On first use the measurements are read from the file named by the `PIM_XFER_CALIBRATION` environment
+ *          variable, or from `PIM_XFER_CALIBRATION_FILE` when it is not set. A missing file leaves the model
+ *          uncalibrated.
+ * @return true if estimates are based on measurements.
+ */
+bool pim_xfer_model_calibrated(void);
+
+/**
+ * @brief Estimate the time of one synchronous transfer.
+ * @details Measurements of the DPU count closest to `num_dpus` are used and scaled by the ratio of DPU counts. Between
+ *          measured sizes the time is interpolated linearly; below the smallest size the smallest measurement is used,
+ *          as such transfers are dominated by fixed costs, and above the largest size its bandwidth is extrapolated.
+ *          Without measurements for the kind, the estimate is one nanosecond per byte moved.
+ * @param direction Transfer kind.
+ * @param num_dpus Number of DPUs taking part.
+ * @param bytes_per_dpu Bytes moved to or from every DPU.
+ * @return Estimated nanoseconds.
+ */
+double pim_xfer_model_estimate_ns(pim_xfer_direction_t direction, uint32_t num_dpus, uint64_t bytes_per_dpu);
+
+#endif // __PIM_XFER_MODEL_H___
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_assertions.h"
+
+#include "matrix.h"
+#include "pim_dpu_pool.h"
+#include "pim_kernel_registry.h"
+#include "pim_matrix_multiplication_frame.h"
+
+int test_pim_dpu_pool_reuses_released_set() {
+    printf("Running test_pim_dpu_pool_reuses_released_set...\n");
+    pim_dpu_pool_stats_t before, after;
+    pim_dpu_pool_get_stats(&before);
+    pim_matrix_multiplication_frame_t* frame1 = create_pim_matrix_multiplication_frame(4, 0, 16, 16, 16, 16, 16, 16,
+                                                                                       sizeof(int8_t), sizeof(int8_t), sizeof(uint16_t));
+    ASSERT_TRUE(frame1 != NULL, "First frame creation failed");
+    pim_dpu_pool_entry_t* entry = frame1->dpu_pool_entry;
+    destroy_pim_matrix_multiplication_frame(frame1);
+    pim_matrix_multiplication_frame_t* frame2 = create_pim_matrix_multiplication_frame(4, 0, 8, 8, 8, 8, 8, 8,
+                                                                                       sizeof(int8_t), sizeof(int8_t), sizeof(uint16_t));
+    ASSERT_TRUE(frame2 != NULL, "Second frame creation failed");
+    ASSERT_TRUE(frame2->dpu_pool_entry == entry, "Released DPU set should be reused");
+    destroy_pim_matrix_multiplication_frame(frame2);
+    pim_dpu_pool_get_stats(&after);
+    ASSERT_TRUE(after.num_allocations - before.num_allocations <= 1, "At most one allocation for two sequential frames");
+    ASSERT_TRUE(after.num_loads - before.num_loads <= 1, "Binary should be loaded at most once");
+    ASSERT_TRUE(after.num_load_skips - before.num_load_skips >= 1, "Second frame should skip the binary load");
+    return 0;
+}
+
+int test_pim_dpu_pool_concurrent_frames_get_distinct_sets() {
+    printf("Running test_pim_dpu_pool_concurrent_frames_get_distinct_sets...\n");
+    pim_matrix_multiplication_frame_t* frame1 = create_pim_matrix_multiplication_frame(2, 0, 8, 8, 8, 8, 8, 8,
+                                                                                       sizeof(int8_t), sizeof(int8_t), sizeof(uint16_t));
+    pim_matrix_multiplication_frame_t* frame2 = create_pim_matrix_multiplication_frame(2, 0, 8, 8, 8, 8, 8, 8,
+                                                                                       sizeof(int8_t), sizeof(int8_t), sizeof(uint16_t));
+    ASSERT_TRUE(frame1 != NULL && frame2 != NULL, "Frame creation failed");
+    ASSERT_TRUE(frame1->dpu_pool_entry != frame2->dpu_pool_entry, "Frames alive at the same time must not share a DPU set");
+    destroy_pim_matrix_multiplication_frame(frame1);
+    destroy_pim_matrix_multiplication_frame(frame2);
+    return 0;
+}
+
+int test_pim_dpu_pool_invalid_request_error() {
+    printf("Running test_pim_dpu_pool_invalid_request_error...\n");
+    ASSERT_TRUE(pim_dpu_pool_acquire(0, "/workspace/bin/matrix_multiply_dpu") == NULL, "Zero DPUs should fail");
+    ASSERT_TRUE(pim_dpu_pool_acquire(1, NULL) == NULL, "NULL binary should fail");
+    return 0;
+}
+
+int test_pim_dpu_pool_evicts_idle_sets_when_full() {
+    printf("Running test_pim_dpu_pool_evicts_idle_sets_when_full...\n");
+    const pim_kernel_descriptor_t* kernel = pim_kernel_registry_select(DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32, 8, 8);
+    ASSERT_TRUE(kernel != NULL, "No kernel to load");
+    // Start from an empty pool and learn how many DPUs the system can hand out
+    pim_dpu_pool_destroy();
+    struct dpu_set_t all;
+    uint32_t total = 0;
+    ASSERT_EQ(dpu_alloc(DPU_ALLOCATE_ALL, NULL, &all), DPU_OK, "Allocate all DPUs");
+    ASSERT_EQ(dpu_get_nr_dpus(all, &total), DPU_OK, "Count DPUs");
+    ASSERT_EQ(dpu_free(all), DPU_OK, "Free all DPUs");
+    if (total < 3) {
+        printf("Skipping: %u DPUs cannot hold two sets of different sizes\n", total);
+        return 0;
+    }
+
+    // Together the two sets need more DPUs than the system has
+    uint32_t first_dpus = total / 2 + 1;
+    pim_dpu_pool_stats_t before, after;
+    pim_dpu_pool_get_stats(&before);
+    pim_dpu_pool_entry_t* first = pim_dpu_pool_acquire(first_dpus, kernel->binary);
+    ASSERT_TRUE(first != NULL, "First set acquisition failed");
+    ASSERT_TRUE(pim_dpu_pool_acquire(total, kernel->binary) == NULL, "A set in use must not be freed for another request");
+    pim_dpu_pool_release(first);
+
+    pim_dpu_pool_entry_t* second = pim_dpu_pool_acquire(total, kernel->binary);
+    ASSERT_TRUE(second != NULL, "The idle set should be freed to make room");
+    ASSERT_EQ(second->num_dpus, total, "Second set size");
+    pim_dpu_pool_get_stats(&after);
+    ASSERT_EQ(after.num_evictions - before.num_evictions, 1, "Exactly the idle set should be freed");
+    ASSERT_EQ(after.num_entries, 1, "Only the new set should remain in the pool");
+    pim_dpu_pool_release(second);
+    pim_dpu_pool_destroy();
+    return 0;
+}
+
+int main() {
+    int fails = 0;
+    fails += test_pim_dpu_pool_reuses_released_set();
+    fails += test_pim_dpu_pool_concurrent_frames_get_distinct_sets();
+    fails += test_pim_dpu_pool_invalid_request_error();
+    fails += test_pim_dpu_pool_evicts_idle_sets_when_full();
+    if (fails == 0) {
+        printf("[PASS] All DPU pool tests passed!\n");
+        return 0;
+    } else {
+        printf("[FAIL] %d DPU pool tests failed.\n", fails);
+        return 1;
+    }
+}
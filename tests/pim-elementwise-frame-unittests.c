@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_assertions.h"
+
+#include "matrix.h"
+#include "pim_elementwise_frame.h"
+
+static int64_t load_as_int64(const void* data, uint32_t index, dpu_pim_dtype_t dtype) {
+    switch (dtype) {
+        case DPU_PIM_DTYPE_INT8: return ((const int8_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT8: return ((const uint8_t*)data)[index];
+        case DPU_PIM_DTYPE_INT16: return ((const int16_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT16: return ((const uint16_t*)data)[index];
+        case DPU_PIM_DTYPE_INT32: return ((const int32_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT32: return ((const uint32_t*)data)[index];
+        case DPU_PIM_DTYPE_INT64: return ((const int64_t*)data)[index];
+        default: return 0;
+    }
+}
+
+static void fill_values(void* data, uint32_t count, dpu_pim_dtype_t dtype, uint32_t seed) {
+    uint32_t size = pim_dtype_size(dtype);
+    for (uint32_t i = 0; i < count; i++) {
+        int64_t value = (int64_t)((i * 2654435761u + seed) >> 7) % 201 - 100;
+        if (dtype == DPU_PIM_DTYPE_UINT8 || dtype == DPU_PIM_DTYPE_UINT16) value += 100;
+        memcpy((uint8_t*)data + i * size, &value, size);
+    }
+}
+
+static int check_result(const void* result, uint32_t index, int64_t expected, uint32_t result_size, const char* op) {
+    int64_t truncated = 0;
+    memcpy(&truncated, &expected, result_size);
+    int64_t actual = 0;
+    memcpy(&actual, (const uint8_t*)result + index * result_size, result_size);
+    if (actual != truncated) {
+        printf("%s mismatch at %u: expected %lld, got %lld\n", op, index, (long long)truncated, (long long)actual);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_elementwise(uint32_t rows, uint32_t cols, uint32_t num_dpus,
+                             dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype) {
+    uint32_t matrix1_size = pim_dtype_size(matrix1_dtype);
+    uint32_t matrix2_size = pim_dtype_size(matrix2_dtype);
+    uint32_t result_size = pim_dtype_size(result_dtype);
+    void* data1 = malloc(rows * cols * matrix1_size);
+    void* data2 = malloc(rows * cols * matrix2_size);
+    void* result = malloc(rows * cols * result_size);
+    ASSERT_TRUE(data1 != NULL && data2 != NULL && result != NULL, "Allocation failed");
+    fill_values(data1, rows * cols, matrix1_dtype, 17);
+    fill_values(data2, rows * cols, matrix2_dtype, 101);
+    Matrix* matrix1 = matrix_create_from_row_major_array(rows, cols, data1, matrix1_size);
+    Matrix* matrix2 = matrix_create_from_row_major_array(rows, cols, data2, matrix2_size);
+    ASSERT_TRUE(matrix1 != NULL && matrix2 != NULL, "Matrix creation failed");
+
+    pim_elementwise_frame_t* frame = create_pim_elementwise_frame(num_dpus, 0, rows, cols, matrix1_dtype, matrix2_dtype, result_dtype);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    ASSERT_EQ(pim_elementwise_frame_load_first_matrix(frame, matrix1), 0, "Load first matrix");
+    ASSERT_EQ(pim_elementwise_frame_load_second_matrix(frame, matrix2), 0, "Load second matrix");
+
+    ASSERT_EQ(pim_elementwise_frame_add(frame), 0, "Add");
+    ASSERT_EQ(pim_elementwise_frame_get_result(frame, result), 0, "Get sum");
+    for (uint32_t i = 0; i < rows * cols; i++) {
+        int64_t expected = load_as_int64(data1, i, matrix1_dtype) + load_as_int64(data2, i, matrix2_dtype);
+        if (check_result(result, i, expected, result_size, "Add")) return 1;
+    }
+
+    // The reduction runs on the resident first matrix, without reloading it
+    ASSERT_EQ(pim_elementwise_frame_reduce_rows(frame), 0, "Reduce rows");
+    ASSERT_EQ(pim_elementwise_frame_get_result(frame, result), 0, "Get row sums");
+    for (uint32_t r = 0; r < rows; r++) {
+        int64_t expected = 0;
+        for (uint32_t c = 0; c < cols; c++) {
+            expected += load_as_int64(data1, r * cols + c, matrix1_dtype);
+        }
+        if (check_result(result, r, expected, result_size, "Reduce rows")) return 1;
+    }
+
+    destroy_pim_elementwise_frame(frame);
+    matrix_free(matrix1);
+    matrix_free(matrix2);
+    free(data1);
+    free(data2);
+    free(result);
+    return 0;
+}
+
+int test_pim_elementwise_int8() {
+    printf("Running test_pim_elementwise_int8...\n");
+    return check_elementwise(100, 300, 4, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+}
+
+int test_pim_elementwise_uint8_legacy() {
+    printf("Running test_pim_elementwise_uint8_legacy...\n");
+    return check_elementwise(37, 21, 3, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT16);
+}
+
+int test_pim_elementwise_int16_int64() {
+    printf("Running test_pim_elementwise_int16_int64...\n");
+    return check_elementwise(9, 250, 2, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT64);
+}
+
+int test_pim_elementwise_invalid_frames() {
+    printf("Running test_pim_elementwise_invalid_frames...\n");
+    ASSERT_TRUE(create_pim_elementwise_frame(4, 0, 16, 16, DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT8) == NULL,
+                "Unsupported element types should be rejected");
+    ASSERT_TRUE(create_pim_elementwise_frame(4, 0, 0, 16, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32) == NULL,
+                "Empty matrices should be rejected");
+    pim_elementwise_frame_t* frame = create_pim_elementwise_frame(4, 0, 16, 16, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    const dpu_pim_kernel_plan_t* plan = &frame->kernel_plan;
+    ASSERT_TRUE(plan->elementwise_wram_bytes > 0 && plan->elementwise_wram_bytes <= plan->wram_heap_budget,
+                "Elementwise plan should fit the heap");
+    ASSERT_TRUE(plan->reduce_wram_bytes > 0 && plan->reduce_wram_bytes <= plan->wram_heap_budget,
+                "Row reduction plan should fit the heap");
+
+    int8_t data[8 * 16] = {0};
+    Matrix* wrong_shape = matrix_create_from_row_major_array(8, 16, data, sizeof(int8_t));
+    ASSERT_TRUE(wrong_shape != NULL, "Matrix creation failed");
+    ASSERT_EQ(pim_elementwise_frame_load_first_matrix(frame, wrong_shape), -1, "Matrix of another shape should be rejected");
+    matrix_free(wrong_shape);
+
+    int32_t result[16 * 16];
+    ASSERT_EQ(pim_elementwise_frame_get_result(frame, result), -1, "Result should be invalid before execution");
+    // A binary built for other element types rejects the launch, and the stale MRAM must not become the result
+    frame->result_dtype = DPU_PIM_DTYPE_UINT32;
+    ASSERT_EQ(pim_elementwise_frame_add(frame), -1, "The DPUs should reject the element types of the addition");
+    ASSERT_EQ(pim_elementwise_frame_reduce_rows(frame), -1, "The DPUs should reject the element types of the reduction");
+    ASSERT_TRUE(!frame->result_valid, "A failed launch should leave no valid result");
+    ASSERT_EQ(pim_elementwise_frame_get_result(frame, result), -1, "Result should be invalid after a failed launch");
+    destroy_pim_elementwise_frame(frame);
+    return 0;
+}
+
+int main() {
+    int fails = 0;
+    fails += test_pim_elementwise_int8();
+    fails += test_pim_elementwise_uint8_legacy();
+    fails += test_pim_elementwise_int16_int64();
+    fails += test_pim_elementwise_invalid_frames();
+    if (fails == 0) {
+        printf("[PASS] All PIM elementwise tests passed!\n");
+        return 0;
+    } else {
+        printf("[FAIL] %d PIM elementwise tests failed.\n", fails);
+        return 1;
+    }
+}
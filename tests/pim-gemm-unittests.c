@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_assertions.h"
+
+#include "pim_gemm.h"
+#include "pim_trace.h"
+
+static void fill_int8(int8_t* data, uint32_t count, uint32_t seed) {
+    for (uint32_t i = 0; i < count; i++) {
+        data[i] = (int8_t)((int32_t)((i * 2654435761u + seed) >> 7) % 201 - 100);
+    }
+}
+
+static int check_gemm(pim_transpose_t trans_a, pim_transpose_t trans_b, uint32_t m, uint32_t n, uint32_t k,
+                      uint32_t lda_pad, uint32_t ldb_pad, uint32_t ldc_pad, int32_t alpha, int32_t beta, uint32_t num_dpus) {
+    // Stored shapes: A is m x k (k x m when transposed), B is k x n (n x k when transposed)
+    uint32_t a_rows = trans_a == PIM_TRANS ? k : m;
+    uint32_t lda = (trans_a == PIM_TRANS ? m : k) + lda_pad;
+    uint32_t b_rows = trans_b == PIM_TRANS ? n : k;
+    uint32_t ldb = (trans_b == PIM_TRANS ? k : n) + ldb_pad;
+    uint32_t ldc = n + ldc_pad;
+    int8_t* a = (int8_t*)malloc(a_rows * lda);
+    int8_t* b = (int8_t*)malloc(b_rows * ldb);
+    int32_t* c = (int32_t*)malloc(m * ldc * sizeof(int32_t));
+    int32_t* c_initial = (int32_t*)malloc(m * ldc * sizeof(int32_t));
+    ASSERT_TRUE(a != NULL && b != NULL && c != NULL && c_initial != NULL, "Allocation failed");
+    fill_int8(a, a_rows * lda, 3);
+    fill_int8(b, b_rows * ldb, 11);
+    for (uint32_t i = 0; i < m * ldc; i++) {
+        c_initial[i] = (int32_t)(i % 97) - 48;
+    }
+    memcpy(c, c_initial, m * ldc * sizeof(int32_t));
+
+    pim_gemm_set_num_dpus(num_dpus);
+    ASSERT_EQ(pim_gemm(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc), 0, "GEMM");
+
+    for (uint32_t i = 0; i < m; i++) {
+        for (uint32_t j = 0; j < ldc; j++) {
+            int32_t expected = c_initial[i * ldc + j];
+            if (j < n) {
+                int32_t sum = 0;
+                for (uint32_t p = 0; p < k; p++) {
+                    int32_t a_value = trans_a == PIM_TRANS ? a[p * lda + i] : a[i * lda + p];
+                    int32_t b_value = trans_b == PIM_TRANS ? b[j * ldb + p] : b[p * ldb + j];
+                    sum += a_value * b_value;
+                }
+                expected = alpha * sum + (beta ? beta * c_initial[i * ldc + j] : 0);
+            }
+            // Columns past n belong to the caller and must not be touched
+            if (c[i * ldc + j] != expected) {
+                printf("Mismatch at (%u, %u): expected %d, got %d\n", i, j, expected, c[i * ldc + j]);
+                return 1;
+            }
+        }
+    }
+    free(a);
+    free(b);
+    free(c);
+    free(c_initial);
+    return 0;
+}
+
+int test_pim_gemm_no_trans() {
+    printf("Running test_pim_gemm_no_trans...\n");
+    return check_gemm(PIM_NO_TRANS, PIM_NO_TRANS, 19, 23, 37, 0, 0, 0, 1, 0, 4);
+}
+
+int test_pim_gemm_transposes() {
+    printf("Running test_pim_gemm_transposes...\n");
+    int fails = 0;
+    fails += check_gemm(PIM_TRANS, PIM_NO_TRANS, 17, 12, 29, 0, 0, 0, 1, 0, 4);
+    fails += check_gemm(PIM_NO_TRANS, PIM_TRANS, 17, 12, 29, 0, 0, 0, 1, 0, 4);
+    fails += check_gemm(PIM_TRANS, PIM_TRANS, 17, 12, 29, 0, 0, 0, 1, 0, 6);
+    return fails;
+}
+
+int test_pim_gemm_leading_dimensions() {
+    printf("Running test_pim_gemm_leading_dimensions...\n");
+    int fails = 0;
+    fails += check_gemm(PIM_NO_TRANS, PIM_NO_TRANS, 13, 9, 21, 5, 3, 7, 1, 0, 4);
+    fails += check_gemm(PIM_TRANS, PIM_TRANS, 13, 9, 21, 2, 11, 1, 1, 0, 3);
+    return fails;
+}
+
+int test_pim_gemm_alpha_beta() {
+    printf("Running test_pim_gemm_alpha_beta...\n");
+    int fails = 0;
+    fails += check_gemm(PIM_NO_TRANS, PIM_NO_TRANS, 16, 16, 16, 1, 0, 0, 3, 2, 4);
+    fails += check_gemm(PIM_TRANS, PIM_NO_TRANS, 11, 14, 9, 0, 0, 3, -2, 1, 4);
+    // alpha = 0 and k = 0 only scale C
+    fails += check_gemm(PIM_NO_TRANS, PIM_NO_TRANS, 5, 7, 4, 0, 0, 0, 0, -1, 4);
+    fails += check_gemm(PIM_NO_TRANS, PIM_NO_TRANS, 5, 7, 0, 0, 0, 0, 1, 2, 4);
+    return fails;
+}
+
+int test_pim_gemm_invalid_arguments() {
+    printf("Running test_pim_gemm_invalid_arguments...\n");
+    int8_t a[16] = {0};
+    int8_t b[16] = {0};
+    int32_t c[16] = {0};
+    ASSERT_EQ(pim_gemm(PIM_NO_TRANS, PIM_NO_TRANS, 4, 4, 4, 1, a, 4, b, 4, 0, NULL, 4), -1, "NULL C should fail");
+    ASSERT_EQ(pim_gemm(PIM_NO_TRANS, PIM_NO_TRANS, 4, 4, 4, 1, a, 4, b, 4, 0, c, 3), -1, "Small ldc should fail");
+    ASSERT_EQ(pim_gemm(PIM_NO_TRANS, PIM_NO_TRANS, 4, 4, 4, 1, a, 3, b, 4, 0, c, 4), -1, "Small lda should fail");
+    ASSERT_EQ(pim_gemm(PIM_NO_TRANS, PIM_TRANS, 4, 4, 4, 1, a, 4, b, 3, 0, c, 4), -1, "Small ldb should fail");
+    return 0;
+}
+
+int test_pim_gemm_trace() {
+    printf("Running test_pim_gemm_trace...\n");
+    const char* path = "pim-gemm-unittests-trace.json";
+    ASSERT_EQ(pim_trace_start(), 0, "Start trace");
+    ASSERT_TRUE(pim_trace_enabled(), "Tracing should be on");
+    int fails = check_gemm(PIM_NO_TRANS, PIM_TRANS, 12, 10, 16, 0, 0, 0, 1, 0, 4);
+    ASSERT_EQ(fails, 0, "Traced GEMM");
+#if PIM_ENABLE_STATS
+    ASSERT_TRUE(pim_trace_event_count() > 0, "GEMM phases should be traced");
+#endif
+    ASSERT_EQ(pim_trace_stop(path), 0, "Write trace");
+    ASSERT_TRUE(!pim_trace_enabled(), "Tracing should be off");
+
+    FILE* file = fopen(path, "r");
+    ASSERT_TRUE(file != NULL, "Trace file should exist");
+    char contents[1 << 16];
+    size_t length = fread(contents, 1, sizeof(contents) - 1, file);
+    contents[length] = '\0';
+    fclose(file);
+    remove(path);
+    ASSERT_TRUE(strncmp(contents, "{\"displayTimeUnit\"", 18) == 0, "Trace should be a Chrome trace object");
+#if PIM_ENABLE_STATS
+    ASSERT_TRUE(strstr(contents, "\"name\":\"push_matrix1\"") != NULL, "Trace should hold host phases");
+    ASSERT_TRUE(strstr(contents, "\"cat\":\"dpu\"") != NULL, "Trace should hold DPU tasklets");
+#endif
+    return 0;
+}
+
+int main() {
+    int fails = 0;
+    fails += test_pim_gemm_no_trans();
+    fails += test_pim_gemm_transposes();
+    fails += test_pim_gemm_leading_dimensions();
+    fails += test_pim_gemm_alpha_beta();
+    fails += test_pim_gemm_invalid_arguments();
+    fails += test_pim_gemm_trace();
+    if (fails == 0) {
+        printf("[PASS] All PIM GEMM tests passed!\n");
+        return 0;
+    } else {
+        printf("[FAIL] %d PIM GEMM tests failed.\n", fails);
+        return 1;
+    }
+}
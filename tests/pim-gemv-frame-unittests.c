@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_assertions.h"
+
+#include "matrix.h"
+#include "pim_gemv_frame.h"
+
+static int64_t load_as_int64(const void* data, uint32_t index, dpu_pim_dtype_t dtype) {
+    switch (dtype) {
+        case DPU_PIM_DTYPE_INT8: return ((const int8_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT8: return ((const uint8_t*)data)[index];
+        case DPU_PIM_DTYPE_INT16: return ((const int16_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT16: return ((const uint16_t*)data)[index];
+        case DPU_PIM_DTYPE_INT32: return ((const int32_t*)data)[index];
+        case DPU_PIM_DTYPE_UINT32: return ((const uint32_t*)data)[index];
+        case DPU_PIM_DTYPE_INT64: return ((const int64_t*)data)[index];
+        default: return 0;
+    }
+}
+
+static void fill_values(void* data, uint32_t count, dpu_pim_dtype_t dtype, uint32_t seed) {
+    uint32_t size = pim_dtype_size(dtype);
+    for (uint32_t i = 0; i < count; i++) {
+        int64_t value = (int64_t)((i * 2654435761u + seed) >> 7) % 201 - 100;
+        if (dtype == DPU_PIM_DTYPE_UINT8 || dtype == DPU_PIM_DTYPE_UINT16) value += 100;
+        memcpy((uint8_t*)data + i * size, &value, size);
+    }
+}
+
+static int check_gemv(uint32_t rows, uint32_t cols, uint32_t num_dpus, uint32_t num_vectors,
+                      dpu_pim_dtype_t matrix_dtype, dpu_pim_dtype_t vector_dtype, dpu_pim_dtype_t result_dtype) {
+    uint32_t matrix_size = pim_dtype_size(matrix_dtype);
+    uint32_t vector_size = pim_dtype_size(vector_dtype);
+    uint32_t result_size = pim_dtype_size(result_dtype);
+    void* matrix_data = malloc(rows * cols * matrix_size);
+    void* vector = malloc(cols * vector_size);
+    void* result = malloc(rows * result_size);
+    ASSERT_TRUE(matrix_data != NULL && vector != NULL && result != NULL, "Allocation failed");
+    fill_values(matrix_data, rows * cols, matrix_dtype, 17);
+    Matrix* matrix = matrix_create_from_row_major_array(rows, cols, matrix_data, matrix_size);
+    ASSERT_TRUE(matrix != NULL, "Matrix creation failed");
+
+    pim_gemv_frame_t* frame = create_pim_gemv_frame(num_dpus, 0, rows, cols, matrix_dtype, vector_dtype, result_dtype);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    ASSERT_EQ(pim_gemv_frame_load_matrix(frame, matrix), 0, "Load matrix");
+    // The matrix stays resident while several vectors are multiplied
+    for (uint32_t v = 0; v < num_vectors; v++) {
+        fill_values(vector, cols, vector_dtype, 101 + v * 7);
+        ASSERT_EQ(pim_gemv_frame_load_vector(frame, vector), 0, "Load vector");
+        ASSERT_EQ(pim_gemv_frame_execute(frame), 0, "Execute");
+        ASSERT_EQ(pim_gemv_frame_get_result(frame, result), 0, "Get result");
+        for (uint32_t r = 0; r < rows; r++) {
+            int64_t expected = 0;
+            for (uint32_t c = 0; c < cols; c++) {
+                expected += load_as_int64(matrix_data, r * cols + c, matrix_dtype) * load_as_int64(vector, c, vector_dtype);
+            }
+            int64_t truncated = 0;
+            memcpy(&truncated, &expected, result_size);
+            int64_t actual = 0;
+            memcpy(&actual, (uint8_t*)result + r * result_size, result_size);
+            if (actual != truncated) {
+                printf("Mismatch at row %u: expected %lld, got %lld\n", r, (long long)truncated, (long long)actual);
+                return 1;
+            }
+        }
+    }
+    destroy_pim_gemv_frame(frame);
+    matrix_free(matrix);
+    free(matrix_data);
+    free(vector);
+    free(result);
+    return 0;
+}
+
+int test_pim_gemv_int8() {
+    printf("Running test_pim_gemv_int8...\n");
+    return check_gemv(100, 1000, 4, 2, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+}
+
+int test_pim_gemv_uint8_legacy() {
+    printf("Running test_pim_gemv_uint8_legacy...\n");
+    return check_gemv(37, 21, 3, 1, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT16);
+}
+
+int test_pim_gemv_int16_int64() {
+    printf("Running test_pim_gemv_int16_int64...\n");
+    return check_gemv(64, 300, 4, 1, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT64);
+}
+
+int test_pim_gemv_invalid_frames() {
+    printf("Running test_pim_gemv_invalid_frames...\n");
+    ASSERT_TRUE(create_pim_gemv_frame(4, 0, 16, DPU_PIM_GEMV_MAX_VECTOR_BYTES + 8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32) == NULL,
+                "Vector larger than the WRAM budget should be rejected");
+    ASSERT_TRUE(create_pim_gemv_frame(4, 0, 16, 16, DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT8) == NULL,
+                "Unsupported element types should be rejected");
+    pim_gemv_frame_t* frame = create_pim_gemv_frame(4, 0, 16, 16, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    int32_t result[16];
+    ASSERT_EQ(pim_gemv_frame_get_result(frame, result), -1, "Result should be invalid before execution");
+    // A binary built for other element types rejects the launch, and the stale MRAM must not become the result
+    frame->result_dtype = DPU_PIM_DTYPE_UINT32;
+    ASSERT_EQ(pim_gemv_frame_execute(frame), -1, "The DPUs should reject the element types");
+    ASSERT_TRUE(!frame->result_valid, "A failed launch should leave no valid result");
+    ASSERT_EQ(pim_gemv_frame_get_result(frame, result), -1, "Result should be invalid after a failed launch");
+    destroy_pim_gemv_frame(frame);
+    return 0;
+}
+
+int main() {
+    int fails = 0;
+    fails += test_pim_gemv_int8();
+    fails += test_pim_gemv_uint8_legacy();
+    fails += test_pim_gemv_int16_int64();
+    fails += test_pim_gemv_invalid_frames();
+    if (fails == 0) {
+        printf("[PASS] All PIM GEMV tests passed!\n");
+        return 0;
+    } else {
+        printf("[FAIL] %d PIM GEMV tests failed.\n", fails);
+        return 1;
+    }
+}
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_assertions.h"
+
+#include "pim_kernel_registry.h"
+
+static const char* write_test_manifest() {
+    static char path[] = "/tmp/pim_kernel_registry_test_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    FILE* manifest = fdopen(fd, "w");
+    fprintf(manifest, "# name binary matrix1_dtype matrix2_dtype result_dtype nr_tasklets tile_rows tile_cols micro_rows micro_cols multiply\n");
+    fprintf(manifest, "small_tiles /bin/small uint8 uint8 uint16 16 2 2\n");
+    fprintf(manifest, "big_tiles /bin/big uint8 uint8 uint16 16 16 16\n");
+    fprintf(manifest, "few_tasklets /bin/few uint8 uint8 uint16 4 8 8\n");
+    fprintf(manifest, "wide_result /bin/wide int8 int8 int32 16 8 8\n");
+    fprintf(manifest, "wide_result_mr4 /bin/wide_mr4 int8 int8 int32 16 8 8 4 1\n");
+    fprintf(manifest, "wide_result_packed /bin/wide_packed int8 int8 int32 16 8 8 2 2 packed_builtin\n");
+    fprintf(manifest, "unknown_multiply /bin/unknown int8 int8 int32 16 8 8 2 2 simd\n");
+    fprintf(manifest, "malformed_line /bin/bad uint8 uint8\n");
+    fprintf(manifest, "unknown_dtype /bin/unknown float32 float32 float32 16 8 8\n");
+    fclose(manifest);
+    return path;
+}
+
+int test_pim_kernel_registry_load_manifest() {
+    printf("Running test_pim_kernel_registry_load_manifest...\n");
+    const char* path = write_test_manifest();
+    ASSERT_TRUE(path != NULL, "Manifest creation failed");
+    ASSERT_EQ(pim_kernel_registry_load(path), 6, "Loaded kernels");
+    ASSERT_EQ(pim_kernel_registry_count(), 6, "Registry count");
+    const pim_kernel_descriptor_t* kernel = pim_kernel_registry_get(1);
+    ASSERT_TRUE(kernel != NULL, "Kernel 1 should exist");
+    ASSERT_STR_EQ(kernel->name, "big_tiles", "Kernel 1 name");
+    ASSERT_STR_EQ(kernel->binary, "/bin/big", "Kernel 1 binary");
+    ASSERT_EQ(kernel->tile_rows, 16, "Kernel 1 tile rows");
+    ASSERT_TRUE(kernel->micro_rows == 2 && kernel->micro_cols == 2, "Register block should default to 2x2");
+    ASSERT_EQ(kernel->multiply, DPU_PIM_MULTIPLY_C, "Multiplication should default to C");
+    kernel = pim_kernel_registry_get(4);
+    ASSERT_TRUE(kernel != NULL && kernel->micro_rows == 4 && kernel->micro_cols == 1, "Kernel 4 register block");
+    kernel = pim_kernel_registry_get(5);
+    ASSERT_TRUE(kernel != NULL && kernel->multiply == DPU_PIM_MULTIPLY_PACKED_BUILTIN, "Kernel 5 multiplication");
+    ASSERT_TRUE(pim_kernel_registry_get(6) == NULL, "Out of bounds kernel should be NULL");
+    remove(path);
+    return 0;
+}
+
+int test_pim_kernel_registry_select_by_shape() {
+    printf("Running test_pim_kernel_registry_select_by_shape...\n");
+    // Large slices keep all tasklets busy with any tile, so the largest tiles win
+    const pim_kernel_descriptor_t* kernel = pim_kernel_registry_select(DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT16, 256, 256);
+    ASSERT_TRUE(kernel != NULL, "Kernel should be selected for large slice");
+    ASSERT_STR_EQ(kernel->name, "big_tiles", "Large slice kernel");
+    // Small slices need small tiles to keep tasklets busy
+    kernel = pim_kernel_registry_select(DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT16, 8, 8);
+    ASSERT_TRUE(kernel != NULL, "Kernel should be selected for small slice");
+    ASSERT_STR_EQ(kernel->name, "small_tiles", "Small slice kernel");
+    // Element types must match exactly, including signedness
+    kernel = pim_kernel_registry_select(DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32, 8, 8);
+    ASSERT_TRUE(kernel != NULL, "Kernel should be selected for wide result");
+    ASSERT_STR_EQ(kernel->name, "wide_result", "Wide result kernel");
+    // Builds that only differ by their register block tie with the first one unless preferred
+    ASSERT_EQ(pim_kernel_registry_prefer(DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32, "wide_result_mr4"), 0, "Prefer kernel");
+    kernel = pim_kernel_registry_select(DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32, 8, 8);
+    ASSERT_STR_EQ(kernel->name, "wide_result_mr4", "Preferred kernel");
+    kernel = pim_kernel_registry_select(DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT16, 8, 8);
+    ASSERT_STR_EQ(kernel->name, "small_tiles", "Other element types keep the shape-based selection");
+    ASSERT_EQ(pim_kernel_registry_prefer(DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT16, "wide_result_mr4"), -1,
+              "A kernel of other element types cannot be preferred");
+    ASSERT_EQ(pim_kernel_registry_prefer(DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32, NULL), 0, "Clear preference");
+    kernel = pim_kernel_registry_select(DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32, 8, 8);
+    ASSERT_STR_EQ(kernel->name, "wide_result", "Shape-based selection after clearing the preference");
+    ASSERT_TRUE(pim_kernel_registry_select(DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_INT32, 8, 8) == NULL,
+                "No kernel for unregistered element types");
+    return 0;
+}
+
+int test_pim_kernel_registry_register_and_clear() {
+    printf("Running test_pim_kernel_registry_register_and_clear...\n");
+    pim_kernel_registry_clear();
+    ASSERT_EQ(pim_kernel_registry_count(), 0, "Registry should be empty after clear");
+    pim_kernel_descriptor_t kernel = {0};
+    strcpy(kernel.name, "registered");
+    strcpy(kernel.binary, "/bin/registered");
+    kernel.matrix1_dtype = DPU_PIM_DTYPE_INT16;
+    kernel.matrix2_dtype = DPU_PIM_DTYPE_INT16;
+    kernel.result_dtype = DPU_PIM_DTYPE_INT64;
+    kernel.nr_tasklets = 16;
+    kernel.tile_rows = 4;
+    kernel.tile_cols = 4;
+    ASSERT_EQ(pim_kernel_registry_register(&kernel), 0, "Register kernel");
+    const pim_kernel_descriptor_t* selected = pim_kernel_registry_select(DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT64, 32, 32);
+    ASSERT_TRUE(selected != NULL, "Registered kernel should be selected");
+    ASSERT_STR_EQ(selected->name, "registered", "Registered kernel name");
+    kernel.nr_tasklets = 0;
+    ASSERT_EQ(pim_kernel_registry_register(&kernel), -1, "Kernel without tasklets should be rejected");
+    ASSERT_EQ(pim_kernel_registry_load("/nonexistent/manifest"), -1, "Missing manifest should fail");
+    return 0;
+}
+
+int test_pim_dtype_helpers() {
+    printf("Running test_pim_dtype_helpers...\n");
+    dpu_pim_dtype_t dtype;
+    ASSERT_EQ(pim_dtype_from_name("int16", &dtype), 0, "Parse int16");
+    ASSERT_EQ(dtype, DPU_PIM_DTYPE_INT16, "Parsed dtype");
+    ASSERT_EQ(pim_dtype_size(dtype), 2, "int16 size");
+    ASSERT_STR_EQ(pim_dtype_name(DPU_PIM_DTYPE_UINT8), "uint8", "uint8 name");
+    ASSERT_EQ(pim_dtype_from_name("float32", &dtype), -1, "Unknown dtype name");
+    dpu_pim_dtype_t m1, m2, res;
+    ASSERT_EQ(pim_dtype_from_sizes(1, 1, 2, &m1, &m2, &res), 0, "Legacy sizes");
+    ASSERT_TRUE(m1 == DPU_PIM_DTYPE_UINT8 && m2 == DPU_PIM_DTYPE_UINT8 && res == DPU_PIM_DTYPE_UINT16, "Legacy sizes map to uint8 x uint8 -> uint16");
+    ASSERT_EQ(pim_dtype_from_sizes(3, 1, 2, &m1, &m2, &res), -1, "Invalid size");
+    ASSERT_TRUE(pim_dtype_gemm_supported(DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_INT32), "int8 x uint8 -> int32");
+    ASSERT_TRUE(pim_dtype_gemm_supported(DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT64), "int16 x int16 -> int64");
+    ASSERT_TRUE(pim_dtype_gemm_supported(DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT32), "int32 x int32 -> int32");
+    ASSERT_TRUE(!pim_dtype_gemm_supported(DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_UINT16), "int8 x int8 -> uint16 unsupported");
+    ASSERT_TRUE(!pim_dtype_gemm_supported(DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT64), "int32 x int32 -> int64 unsupported");
+    return 0;
+}
+
+int main() {
+    int fails = 0;
+    fails += test_pim_dtype_helpers();
+    fails += test_pim_kernel_registry_load_manifest();
+    fails += test_pim_kernel_registry_select_by_shape();
+    fails += test_pim_kernel_registry_register_and_clear();
+    if (fails == 0) {
+        printf("[PASS] All kernel registry tests passed!\n");
+        return 0;
+    } else {
+        printf("[FAIL] %d kernel registry tests failed.\n", fails);
+        return 1;
+    }
+}
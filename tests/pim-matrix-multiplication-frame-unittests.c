@@ -43,6 +43,7 @@ Matrix*  dpu_multiply_matrices(Matrix* matrix1, Matrix* matrix2, uint32_t num_dp
     pim_matrix_multiplication_frame_load_second_matrix(frame, matrix2);
     pim_matrix_multiplication_frame_execute(frame);
     Matrix* result = pim_matrix_multiplication_frame_get_result(frame);
+    destroy_pim_matrix_multiplication_frame(frame);
     if (!result) {
         fprintf(stderr, "Result retrieval failed");
         return NULL;
@@ -50,6 +51,595 @@ Matrix*  dpu_multiply_matrices(Matrix* matrix1, Matrix* matrix2, uint32_t num_dp
     return result;
 }
 
+static int64_t matrix_get_as_int64(const Matrix* matrix, int r, int c, dpu_pim_dtype_t dtype) {
+    int64_t value = 0;
+    switch (dtype) {
+        case DPU_PIM_DTYPE_INT8: { int8_t v; matrix_get(matrix, r, c, &v); value = v; break; }
+        case DPU_PIM_DTYPE_UINT8: { uint8_t v; matrix_get(matrix, r, c, &v); value = v; break; }
+        case DPU_PIM_DTYPE_INT16: { int16_t v; matrix_get(matrix, r, c, &v); value = v; break; }
+        case DPU_PIM_DTYPE_UINT16: { uint16_t v; matrix_get(matrix, r, c, &v); value = v; break; }
+        case DPU_PIM_DTYPE_INT32: { int32_t v; matrix_get(matrix, r, c, &v); value = v; break; }
+        case DPU_PIM_DTYPE_UINT32: { uint32_t v; matrix_get(matrix, r, c, &v); value = v; break; }
+        case DPU_PIM_DTYPE_INT64: { int64_t v; matrix_get(matrix, r, c, &v); value = v; break; }
+        default: break;
+    }
+    return value;
+}
+
+Matrix* host_multiply_matrices_typed(const Matrix* matrix1, const Matrix* matrix2,
+                                     dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype) {
+    if (!matrix1 || !matrix2 || matrix1->cols != matrix2->rows) return NULL;
+    uint32_t result_size = pim_dtype_size(result_dtype);
+    uint8_t * result_data_row_major = malloc(matrix1->rows * matrix2->cols * result_size);
+    if (!result_data_row_major) return NULL;
+    for (int i = 0; i < matrix1->rows; i++) {
+        for (int j = 0; j < matrix2->cols; j++) {
+            int64_t sum = 0;
+            for (int k = 0; k < matrix1->cols; k++) {
+                sum += matrix_get_as_int64(matrix1, i, k, matrix1_dtype) * matrix_get_as_int64(matrix2, k, j, matrix2_dtype);
+            }
+            // Little-endian truncation to the result type
+            memcpy(result_data_row_major + (i*matrix2->cols + j) * result_size, &sum, result_size);
+        }
+    }
+    Matrix* result = matrix_create_from_row_major_array(matrix1->rows, matrix2->cols, result_data_row_major, result_size);
+    free(result_data_row_major);
+    return result;
+}
+
+Matrix* dpu_multiply_matrices_typed(Matrix* matrix1, Matrix* matrix2, uint32_t num_dpus,
+                                    dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype) {
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(num_dpus, 0, matrix1->rows, matrix1->cols, matrix2->rows, matrix2->cols, matrix1->rows, matrix2->cols,
+                                                                                            matrix1_dtype, matrix2_dtype, result_dtype);
+    if (!frame) {
+        fprintf(stderr, "Frame creation failed");
+        return NULL;
+    }
+    pim_matrix_multiplication_frame_load_first_matrix(frame, matrix1);
+    pim_matrix_multiplication_frame_load_second_matrix(frame, matrix2);
+    pim_matrix_multiplication_frame_execute(frame);
+    Matrix* result = pim_matrix_multiplication_frame_get_result(frame);
+    destroy_pim_matrix_multiplication_frame(frame);
+    if (!result) {
+        fprintf(stderr, "Result retrieval failed");
+        return NULL;
+    }
+    return result;
+}
+
+static int check_typed_multiplication(uint16_t rows, uint16_t inner, uint16_t cols, uint32_t num_dpus,
+                                      dpu_pim_dtype_t matrix1_dtype, dpu_pim_dtype_t matrix2_dtype, dpu_pim_dtype_t result_dtype,
+                                      int64_t min_value, int64_t max_value) {
+    uint32_t size1 = pim_dtype_size(matrix1_dtype), size2 = pim_dtype_size(matrix2_dtype);
+    uint8_t* data1 = malloc(rows * inner * size1);
+    uint8_t* data2 = malloc(inner * cols * size2);
+    ASSERT_TRUE(data1 != NULL && data2 != NULL, "Data allocation failed");
+    // Values sweep the whole range so that long dot products overflow 16-bit accumulators
+    int64_t range = max_value - min_value + 1;
+    for (int i = 0; i < rows * inner; i++) {
+        int64_t value = min_value + (i * 37 + 11) % range;
+        memcpy(data1 + i * size1, &value, size1);
+    }
+    for (int i = 0; i < inner * cols; i++) {
+        int64_t value = max_value - (i * 53 + 7) % range;
+        memcpy(data2 + i * size2, &value, size2);
+    }
+    Matrix* matrix1 = matrix_create_from_row_major_array(rows, inner, data1, size1);
+    Matrix* matrix2 = matrix_create_from_row_major_array(inner, cols, data2, size2);
+    free(data1);
+    free(data2);
+    ASSERT_TRUE(matrix1 != NULL, "Matrix 1 creation failed");
+    ASSERT_TRUE(matrix2 != NULL, "Matrix 2 creation failed");
+    Matrix* result = dpu_multiply_matrices_typed(matrix1, matrix2, num_dpus, matrix1_dtype, matrix2_dtype, result_dtype);
+    ASSERT_TRUE(result != NULL, "Result matrix should not be NULL");
+    Matrix* expected_result = host_multiply_matrices_typed(matrix1, matrix2, matrix1_dtype, matrix2_dtype, result_dtype);
+    ASSERT_TRUE(expected_result != NULL, "Expected result matrix should not be NULL");
+    ASSERT_TRUE(matrix_compare(result, expected_result), "Result matrix should match expected result");
+    matrix_free(matrix1);
+    matrix_free(matrix2);
+    matrix_free(result);
+    matrix_free(expected_result);
+    return 0;
+}
+
+int test_pim_int8_int32_accumulation() {
+    printf("Running test_pim_int8_int32_accumulation...\n");
+    if (check_typed_multiplication(16, 64, 16, 4, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32, INT8_MIN, INT8_MAX)) return 1;
+    if (check_typed_multiplication(12, 64, 20, 4, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_INT32, 0, UINT8_MAX)) return 1;
+    if (check_typed_multiplication(16, 40, 16, 4, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_INT32, INT8_MIN, INT8_MAX)) return 1;
+    return 0;
+}
+
+int test_pim_int16_multiplication() {
+    printf("Running test_pim_int16_multiplication...\n");
+    if (check_typed_multiplication(16, 32, 16, 4, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT32, -1000, 1000)) return 1;
+    if (check_typed_multiplication(16, 32, 12, 4, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT64, INT16_MIN, INT16_MAX)) return 1;
+    return 0;
+}
+
+int test_pim_int32_multiplication() {
+    printf("Running test_pim_int32_multiplication...\n");
+    return check_typed_multiplication(16, 16, 16, 4, DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT32, -100000, 100000);
+}
+
+int test_pim_unsupported_dtype_combination() {
+    printf("Running test_pim_unsupported_dtype_combination...\n");
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(4, 0, 16, 16, 16, 16, 16, 16,
+                                                                                            DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT32, DPU_PIM_DTYPE_INT8);
+    ASSERT_TRUE(frame == NULL, "Narrowing int32 x int32 -> int8 should be rejected");
+    return 0;
+}
+
+static int check_epilogue_multiplication(uint16_t rows, uint16_t inner, uint16_t cols, uint32_t num_dpus,
+                                         const pim_matrix_multiplication_epilogue_t* epilogue) {
+    int8_t* data1 = malloc(rows * inner);
+    int8_t* data2 = malloc(inner * cols);
+    ASSERT_TRUE(data1 != NULL && data2 != NULL, "Data allocation failed");
+    for (int i = 0; i < rows * inner; i++) data1[i] = (int8_t)((i * 37 + 11) % 256 - 128);
+    for (int i = 0; i < inner * cols; i++) data2[i] = (int8_t)(127 - (i * 53 + 7) % 256);
+    Matrix* matrix1 = matrix_create_from_row_major_array(rows, inner, data1, sizeof(int8_t));
+    Matrix* matrix2 = matrix_create_from_row_major_array(inner, cols, data2, sizeof(int8_t));
+    free(data1);
+    free(data2);
+    ASSERT_TRUE(matrix1 != NULL && matrix2 != NULL, "Matrix creation failed");
+
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(num_dpus, 0, rows, inner, inner, cols, rows, cols,
+                                                                                            DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    pim_matrix_multiplication_frame_load_first_matrix(frame, matrix1);
+    pim_matrix_multiplication_frame_load_second_matrix(frame, matrix2);
+    ASSERT_EQ(pim_matrix_multiplication_frame_set_epilogue(frame, epilogue), 0, "Set epilogue");
+    pim_matrix_multiplication_frame_execute(frame);
+    Matrix* result = pim_matrix_multiplication_frame_get_result(frame);
+    destroy_pim_matrix_multiplication_frame(frame);
+    ASSERT_TRUE(result != NULL, "Result matrix should not be NULL");
+
+    bool requantize = epilogue->flags & DPU_PIM_EPILOGUE_REQUANTIZE;
+    ASSERT_EQ(result->element_size, requantize ? sizeof(int8_t) : sizeof(int32_t), "Result element size");
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int64_t expected = 0;
+            for (int k = 0; k < inner; k++) {
+                expected += matrix_get_as_int64(matrix1, i, k, DPU_PIM_DTYPE_INT8) * matrix_get_as_int64(matrix2, k, j, DPU_PIM_DTYPE_INT8);
+            }
+            if (epilogue->flags & DPU_PIM_EPILOGUE_BIAS) expected += epilogue->bias[j];
+            if (requantize) {
+                expected *= epilogue->multiplier[j];
+                if (epilogue->shift[j] > 0) expected = (expected + ((int64_t)1 << (epilogue->shift[j] - 1))) >> epilogue->shift[j];
+                expected = expected < INT8_MIN ? INT8_MIN : (expected > INT8_MAX ? INT8_MAX : expected);
+            }
+            if ((epilogue->flags & DPU_PIM_EPILOGUE_RELU) && expected < 0) expected = 0;
+            if (epilogue->flags & DPU_PIM_EPILOGUE_CLAMP) {
+                expected = expected < epilogue->clamp_min ? epilogue->clamp_min : (expected > epilogue->clamp_max ? epilogue->clamp_max : expected);
+            }
+            int64_t actual = matrix_get_as_int64(result, i, j, requantize ? DPU_PIM_DTYPE_INT8 : DPU_PIM_DTYPE_INT32);
+            if (actual != expected) {
+                printf("Mismatch at (%d, %d): expected %lld, got %lld\n", i, j, (long long)expected, (long long)actual);
+                return 1;
+            }
+        }
+    }
+    matrix_free(matrix1);
+    matrix_free(matrix2);
+    matrix_free(result);
+    return 0;
+}
+
+int test_pim_epilogue_requantize() {
+    printf("Running test_pim_epilogue_requantize...\n");
+    enum { rows = 16, inner = 64, cols = 20 };
+    int32_t bias[cols], multiplier[cols], shift[cols];
+    for (int j = 0; j < cols; j++) {
+        bias[j] = (j - cols / 2) * 1000;
+        multiplier[j] = 3 + j;
+        shift[j] = 14 + j % 4;
+    }
+    pim_matrix_multiplication_epilogue_t epilogue = {
+        .flags = DPU_PIM_EPILOGUE_BIAS | DPU_PIM_EPILOGUE_REQUANTIZE | DPU_PIM_EPILOGUE_RELU,
+        .bias = bias, .multiplier = multiplier, .shift = shift,
+    };
+    return check_epilogue_multiplication(rows, inner, cols, 4, &epilogue);
+}
+
+int test_pim_epilogue_bias_clamp() {
+    printf("Running test_pim_epilogue_bias_clamp...\n");
+    enum { rows = 12, inner = 32, cols = 16 };
+    int32_t bias[cols];
+    for (int j = 0; j < cols; j++) bias[j] = j * 250 - 2000;
+    pim_matrix_multiplication_epilogue_t epilogue = {
+        .flags = DPU_PIM_EPILOGUE_BIAS | DPU_PIM_EPILOGUE_CLAMP,
+        .bias = bias, .clamp_min = -20000, .clamp_max = 30000,
+    };
+    if (check_epilogue_multiplication(rows, inner, cols, 4, &epilogue)) return 1;
+
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame(4, 0, 16, 16, 16, 16, 16, 16,
+                                                                                      sizeof(uint8_t), sizeof(uint8_t), sizeof(uint16_t));
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    pim_matrix_multiplication_epilogue_t requantize = { .flags = DPU_PIM_EPILOGUE_REQUANTIZE, .multiplier = bias, .shift = bias };
+    ASSERT_EQ(pim_matrix_multiplication_frame_set_epilogue(frame, &requantize), -1, "Requantisation needs an int32 result");
+    destroy_pim_matrix_multiplication_frame(frame);
+    return 0;
+}
+
+static int check_gemm_variants(uint16_t rows, uint16_t inner, uint16_t cols, uint32_t num_dpus,
+                               const pim_matrix_multiplication_epilogue_t* epilogue, dpu_pim_gemm_variant_t first_variant) {
+    int8_t* data1 = malloc(rows * inner);
+    int8_t* data2 = malloc(inner * cols);
+    ASSERT_TRUE(data1 != NULL && data2 != NULL, "Data allocation failed");
+    for (int i = 0; i < rows * inner; i++) data1[i] = (int8_t)((i * 29 + 5) % 256 - 128);
+    for (int i = 0; i < inner * cols; i++) data2[i] = (int8_t)(127 - (i * 61 + 3) % 256);
+    Matrix* matrix1 = matrix_create_from_row_major_array(rows, inner, data1, sizeof(int8_t));
+    Matrix* matrix2 = matrix_create_from_row_major_array(inner, cols, data2, sizeof(int8_t));
+    free(data1);
+    free(data2);
+    ASSERT_TRUE(matrix1 != NULL && matrix2 != NULL, "Matrix creation failed");
+
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(num_dpus, 0, rows, inner, inner, cols, rows, cols,
+                                                                                            DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    ASSERT_EQ(pim_matrix_multiplication_frame_set_gemm_variant(frame, DPU_PIM_NUM_GEMM_VARIANTS), -1, "Unknown variant");
+    ASSERT_EQ(pim_matrix_multiplication_frame_set_epilogue(frame, epilogue), 0, "Set epilogue");
+    pim_matrix_multiplication_frame_load_first_matrix(frame, matrix1);
+    pim_matrix_multiplication_frame_load_second_matrix(frame, matrix2);
+    // Every variant from first_variant on runs on the matrices loaded once and must match the first one
+    Matrix* reference = NULL;
+    for (uint32_t variant = first_variant; variant < DPU_PIM_NUM_GEMM_VARIANTS; variant++) {
+        ASSERT_EQ(pim_matrix_multiplication_frame_set_gemm_variant(frame, (dpu_pim_gemm_variant_t)variant), 0, "Set variant");
+        pim_matrix_multiplication_frame_execute(frame);
+        Matrix* result = pim_matrix_multiplication_frame_get_result(frame);
+        ASSERT_TRUE(result != NULL, "Result matrix should not be NULL");
+        if (!reference) {
+            reference = result;
+            continue;
+        }
+        if (!matrix_compare(result, reference)) {
+            printf("GEMM variant %u differs from variant %u\n", variant, (uint32_t)first_variant);
+            return 1;
+        }
+        matrix_free(result);
+    }
+    destroy_pim_matrix_multiplication_frame(frame);
+    if (!epilogue) {
+        Matrix* expected = host_multiply_matrices_typed(matrix1, matrix2, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+        ASSERT_TRUE(expected != NULL, "Expected result matrix should not be NULL");
+        ASSERT_TRUE(matrix_compare(reference, expected), "Result matrix should match expected result");
+        matrix_free(expected);
+    }
+    matrix_free(matrix1);
+    matrix_free(matrix2);
+    matrix_free(reference);
+    return 0;
+}
+
+int test_pim_gemm_variants() {
+    printf("Running test_pim_gemm_variants...\n");
+    if (check_gemm_variants(12, 40, 20, 4, NULL, DPU_PIM_GEMM_NAIVE)) return 1;
+    enum { cols = 24 };
+    int32_t bias[cols], multiplier[cols], shift[cols];
+    for (int j = 0; j < cols; j++) {
+        bias[j] = j * 100 - 1200;
+        multiplier[j] = 5 + j;
+        shift[j] = 12 + j % 3;
+    }
+    pim_matrix_multiplication_epilogue_t epilogue = {
+        .flags = DPU_PIM_EPILOGUE_BIAS | DPU_PIM_EPILOGUE_REQUANTIZE,
+        .bias = bias, .multiplier = multiplier, .shift = shift,
+    };
+    return check_gemm_variants(16, 64, cols, 2, &epilogue, DPU_PIM_GEMM_NAIVE);
+}
+
+int test_pim_gemm_large_slice() {
+    printf("Running test_pim_gemm_large_slice...\n");
+    // Over 512 result columns and operand slices beyond WRAM; only the naive variant keeps whole slices resident
+    return check_gemm_variants(20, 264, 600, 1, NULL, DPU_PIM_GEMM_THREAD_MEMORY_MANAGER);
+}
+
+int test_pim_gemm_kernel_builds() {
+    printf("Running test_pim_gemm_kernel_builds...\n");
+    // Every int8 build is preferred in turn, so the builds the shape-based selection never picks are checked too
+    int fails = 0;
+    bool other_block = false;
+    uint32_t multiplies = 0;
+    for (uint32_t i = 0; i < pim_kernel_registry_count(); i++) {
+        pim_kernel_descriptor_t kernel = *pim_kernel_registry_get(i);
+        if (kernel.matrix1_dtype != DPU_PIM_DTYPE_INT8 || kernel.matrix2_dtype != DPU_PIM_DTYPE_INT8 ||
+            kernel.result_dtype != DPU_PIM_DTYPE_INT32) {
+            continue;
+        }
+        ASSERT_EQ(pim_kernel_registry_prefer(DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32, kernel.name), 0, "Prefer kernel");
+        pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(1, 0, 8, 8, 8, 8, 8, 8,
+                                                                                                DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+        if (!frame || strcmp(frame->kernel.name, kernel.name) != 0) {
+            printf("Kernel %s was not selected\n", kernel.name);
+            fails++;
+            if (frame) destroy_pim_matrix_multiplication_frame(frame);
+            continue;
+        }
+        other_block |= frame->kernel.micro_rows != 2 || frame->kernel.micro_cols != 2;
+        multiplies |= 1u << frame->kernel.multiply;
+        destroy_pim_matrix_multiplication_frame(frame);
+        // Rows and columns that are not multiples of the register block leave partial blocks on the tile edges
+        if (check_gemm_variants(13, 40, 23, 1, NULL, DPU_PIM_GEMM_NAIVE)) {
+            printf("GEMM variants differ for kernel %s\n", kernel.name);
+            fails++;
+        }
+    }
+    ASSERT_EQ(pim_kernel_registry_prefer(DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32, NULL), 0, "Clear preference");
+    ASSERT_EQ(fails, 0, "Every int8 kernel build should match the host");
+    ASSERT_TRUE(other_block, "A kernel build with a register block other than 2x2 should be checked");
+    ASSERT_EQ(multiplies, (1u << DPU_PIM_NUM_MULTIPLIES) - 1, "Kernel builds of every multiplication should be checked");
+    return 0;
+}
+
+int test_pim_gemm_lut() {
+    printf("Running test_pim_gemm_lut...\n");
+    // int4 values stored as int8 and uint8 make new frames pick the lookup-table GEMM
+    enum { rows = 12, inner = 72, cols = 20 };
+    int8_t data1[rows * inner];
+    uint8_t data2[inner * cols];
+    for (int i = 0; i < rows * inner; i++) data1[i] = (int8_t)((i * 7 + 3) % 16 - 8);
+    for (int i = 0; i < inner * cols; i++) data2[i] = (uint8_t)((i * 5 + 1) % 16);
+    Matrix* matrix1 = matrix_create_from_row_major_array(rows, inner, data1, sizeof(int8_t));
+    Matrix* matrix2 = matrix_create_from_row_major_array(inner, cols, data2, sizeof(uint8_t));
+    ASSERT_TRUE(matrix1 != NULL && matrix2 != NULL, "Matrix creation failed");
+    Matrix* expected = host_multiply_matrices_typed(matrix1, matrix2, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(expected != NULL, "Expected result matrix should not be NULL");
+
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(2, 0, rows, inner, inner, cols, rows, cols,
+                                                                                            DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    pim_matrix_multiplication_frame_load_first_matrix(frame, matrix1);
+    ASSERT_EQ(pim_matrix_multiplication_frame_load_second_matrix_strided(frame, data2, cols, false), 0, "Strided load");
+    ASSERT_TRUE(frame->matrix1_lut_range && frame->matrix2_lut_range, "Operands should fit the lookup table");
+    pim_matrix_multiplication_frame_execute(frame);
+    Matrix* result = pim_matrix_multiplication_frame_get_result(frame);
+    ASSERT_TRUE(result != NULL && matrix_compare(result, expected), "Lookup-table result should match expected result");
+    matrix_free(result);
+
+    // One value out of range: the frame runs the tiled GEMM even when the lookup table is requested
+    data2[inner * cols - 1] = 16;
+    ASSERT_EQ(pim_matrix_multiplication_frame_set_gemm_variant(frame, DPU_PIM_GEMM_LUT), 0, "Set variant");
+    ASSERT_EQ(pim_matrix_multiplication_frame_load_second_matrix_strided(frame, data2, cols, false), 0, "Strided load");
+    ASSERT_TRUE(!frame->matrix2_lut_range, "Second matrix should exceed the lookup table");
+    pim_matrix_multiplication_frame_execute(frame);
+    result = pim_matrix_multiplication_frame_get_result(frame);
+    Matrix* matrix2_wide = matrix_create_from_row_major_array(inner, cols, data2, sizeof(uint8_t));
+    Matrix* expected_wide = host_multiply_matrices_typed(matrix1, matrix2_wide, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(result != NULL && expected_wide != NULL && matrix_compare(result, expected_wide), "Fallback result should match expected result");
+
+    destroy_pim_matrix_multiplication_frame(frame);
+
+    // With another variant selected before the loads, the operands are not scanned
+    frame = create_pim_matrix_multiplication_frame_typed(2, 0, rows, inner, inner, cols, rows, cols,
+                                                         DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_UINT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    ASSERT_EQ(pim_matrix_multiplication_frame_set_gemm_variant(frame, DPU_PIM_GEMM_TILED), 0, "Set variant");
+    pim_matrix_multiplication_frame_load_first_matrix(frame, matrix1);
+    pim_matrix_multiplication_frame_load_second_matrix(frame, matrix2);
+    ASSERT_TRUE(!frame->matrix1_lut_range && !frame->matrix2_lut_range, "Operands should not be scanned for the tiled GEMM");
+    ASSERT_TRUE(!pim_matrix_multiplication_frame_supports_gemm_variant(frame, DPU_PIM_GEMM_LUT), "Unscanned operands should not run the lookup table");
+    ASSERT_EQ(pim_matrix_multiplication_frame_execute(frame), 0, "Execute");
+    matrix_free(result);
+    result = pim_matrix_multiplication_frame_get_result(frame);
+    ASSERT_TRUE(result != NULL && matrix_compare(result, expected), "Tiled result should match expected result");
+    destroy_pim_matrix_multiplication_frame(frame);
+
+    matrix_free(result);
+    matrix_free(expected);
+    matrix_free(expected_wide);
+    matrix_free(matrix1);
+    matrix_free(matrix2);
+    matrix_free(matrix2_wide);
+    return 0;
+}
+
+static int check_row_major_second_matrix(uint16_t rows, uint16_t inner, uint16_t cols, uint32_t num_dpus) {
+    int16_t* data1 = malloc(rows * inner * sizeof(int16_t));
+    int16_t* data2 = malloc(inner * cols * sizeof(int16_t));
+    ASSERT_TRUE(data1 != NULL && data2 != NULL, "Data allocation failed");
+    for (int i = 0; i < inner * cols; i++) data2[i] = (int16_t)((i * 53 + 7) % 601 - 300);
+    Matrix* matrix2 = matrix_create_from_row_major_array(inner, cols, data2, sizeof(int16_t));
+    ASSERT_TRUE(matrix2 != NULL, "Matrix creation failed");
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(num_dpus, 0, rows, inner, inner, cols, rows, cols,
+                                                                                            DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    ASSERT_EQ(pim_matrix_multiplication_frame_load_second_matrix_strided(frame, data2, cols, false), 0, "Strided load");
+    ASSERT_TRUE(frame->matrix2_pending_transpose, "Second matrix should be staged row-major");
+
+    // The second launch reuses the slices converted by the first
+    for (int launch = 0; launch < 2; launch++) {
+        for (int i = 0; i < rows * inner; i++) data1[i] = (int16_t)((i * 37 + 11 + launch * 101) % 501 - 250);
+        Matrix* matrix1 = matrix_create_from_row_major_array(rows, inner, data1, sizeof(int16_t));
+        ASSERT_TRUE(matrix1 != NULL, "Matrix creation failed");
+        pim_matrix_multiplication_frame_load_first_matrix(frame, matrix1);
+        pim_matrix_multiplication_frame_execute(frame);
+        ASSERT_TRUE(!frame->matrix2_pending_transpose, "Second matrix should be converted by the launch");
+        Matrix* result = pim_matrix_multiplication_frame_get_result(frame);
+        Matrix* expected = host_multiply_matrices_typed(matrix1, matrix2, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT32);
+        ASSERT_TRUE(result != NULL && expected != NULL && matrix_compare(result, expected), "Result matrix should match expected result");
+        matrix_free(result);
+        matrix_free(expected);
+        matrix_free(matrix1);
+    }
+    destroy_pim_matrix_multiplication_frame(frame);
+    matrix_free(matrix2);
+    free(data1);
+    free(data2);
+    return 0;
+}
+
+int test_pim_row_major_second_matrix() {
+    printf("Running test_pim_row_major_second_matrix...\n");
+    // Tall result: one column slice, pushed straight from the caller's buffer; wide result: packed column slices
+    if (check_row_major_second_matrix(64, 21, 16, 4)) return 1;
+    return check_row_major_second_matrix(4, 37, 90, 4);
+}
+
+// Compare the frame result with A * B plus a per-column bias
+static int check_biased_result(pim_matrix_multiplication_frame_t* frame, const Matrix* matrix1, const Matrix* matrix2, const int32_t* bias) {
+    Matrix* result = pim_matrix_multiplication_frame_get_result(frame);
+    Matrix* expected = host_multiply_matrices_typed(matrix1, matrix2, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(result != NULL && expected != NULL, "Result matrix should not be NULL");
+    for (int i = 0; i < result->rows; i++) {
+        for (int j = 0; j < result->cols; j++) {
+            int64_t want = matrix_get_as_int64(expected, i, j, DPU_PIM_DTYPE_INT32) + bias[j];
+            int64_t actual = matrix_get_as_int64(result, i, j, DPU_PIM_DTYPE_INT32);
+            if (actual != want) {
+                printf("Mismatch at (%d, %d): expected %lld, got %lld\n", i, j, (long long)want, (long long)actual);
+                return 1;
+            }
+        }
+    }
+    matrix_free(result);
+    matrix_free(expected);
+    return 0;
+}
+
+int test_pim_staging_region_reserved_on_row_major_load() {
+    printf("Running test_pim_staging_region_reserved_on_row_major_load...\n");
+    enum { rows = 12, inner = 27, cols = 20 };
+    int8_t data1[rows * inner], data2[inner * cols], data2_transposed[cols * inner];
+    int32_t bias[cols];
+    for (int i = 0; i < rows * inner; i++) data1[i] = (int8_t)((i * 37 + 11) % 256 - 128);
+    for (int k = 0; k < inner; k++) {
+        for (int j = 0; j < cols; j++) {
+            data2[k * cols + j] = (int8_t)(127 - ((k * cols + j) * 53 + 7) % 256);
+            data2_transposed[j * inner + k] = data2[k * cols + j];
+        }
+    }
+    for (int j = 0; j < cols; j++) bias[j] = j * 100 - 1000;
+    Matrix* matrix1 = matrix_create_from_row_major_array(rows, inner, data1, sizeof(int8_t));
+    Matrix* matrix2 = matrix_create_from_row_major_array(inner, cols, data2, sizeof(int8_t));
+    ASSERT_TRUE(matrix1 != NULL && matrix2 != NULL, "Matrix creation failed");
+
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(4, 0, rows, inner, inner, cols, rows, cols,
+                                                                                            DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    uint32_t frame_end = frame->mem_frame_end;
+    uint32_t epilogue_offset = frame->epilogue_start_offset;
+    ASSERT_TRUE(!frame->matrix2_staging_reserved, "New frames should not reserve the staging region");
+    pim_matrix_multiplication_epilogue_t epilogue = { .flags = DPU_PIM_EPILOGUE_BIAS, .bias = bias };
+    ASSERT_EQ(pim_matrix_multiplication_frame_set_epilogue(frame, &epilogue), 0, "Set epilogue");
+    pim_matrix_multiplication_frame_load_first_matrix(frame, matrix1);
+
+    // A transposed load packs the column-major slices on the host and needs no staging region
+    ASSERT_EQ(pim_matrix_multiplication_frame_load_second_matrix_strided(frame, data2_transposed, inner, true), 0, "Transposed load");
+    ASSERT_TRUE(!frame->matrix2_staging_reserved && frame->mem_frame_end == frame_end, "Transposed load should not reserve the staging region");
+    ASSERT_EQ(pim_matrix_multiplication_frame_execute(frame), 0, "Execute with the column-major second matrix");
+    if (check_biased_result(frame, matrix1, matrix2, bias)) return 1;
+
+    // A row-major load appends the staging region; the loaded first matrix and the epilogue parameters stay in place
+    pim_matrix_multiplication_frame_load_second_matrix(frame, matrix2);
+    ASSERT_TRUE(frame->matrix2_staging_reserved && frame->matrix2_staging_offset == frame_end, "Staging region should follow the frame");
+    ASSERT_TRUE(frame->mem_frame_end > frame_end, "Staging region should extend the frame");
+    ASSERT_EQ(frame->epilogue_start_offset, epilogue_offset, "Reserving the staging region should not move the epilogue");
+    ASSERT_EQ(pim_matrix_multiplication_frame_execute(frame), 0, "Execute with the row-major second matrix");
+    if (check_biased_result(frame, matrix1, matrix2, bias)) return 1;
+
+    destroy_pim_matrix_multiplication_frame(frame);
+    matrix_free(matrix1);
+    matrix_free(matrix2);
+    return 0;
+}
+
+// Fill count elements of the given size with small signed values derived from seed (little-endian)
+static void fill_small_values(uint8_t* data, int count, uint32_t size, int seed) {
+    for (int i = 0; i < count; i++) {
+        int64_t value = (i * 37 + seed) % 501 - 250;
+        memcpy(data + (size_t)i * size, &value, size);
+    }
+}
+
+/*
+ * Multiply with the outer-product GEMM selected explicitly (or automatically when automatic is set), check that the
+ * row-major second matrix survives it, then switch to the tiled GEMM, which converts it.
+ */
+static int check_gemm_outer(uint16_t rows, uint16_t inner, uint16_t cols, uint32_t num_dpus, dpu_pim_dtype_t dtype, bool automatic) {
+    uint32_t size = pim_dtype_size(dtype);
+    uint8_t* data1 = malloc((size_t)rows * inner * size);
+    uint8_t* data2 = malloc((size_t)inner * cols * size);
+    uint8_t* data2_t = malloc((size_t)inner * cols * size);
+    ASSERT_TRUE(data1 != NULL && data2 != NULL && data2_t != NULL, "Data allocation failed");
+    fill_small_values(data2, inner * cols, size, 3);
+    for (int k = 0; k < inner; k++) {
+        for (int c = 0; c < cols; c++) memcpy(data2_t + ((size_t)c * inner + k) * size, data2 + ((size_t)k * cols + c) * size, size);
+    }
+    Matrix* matrix2 = matrix_create_from_row_major_array(inner, cols, data2, size);
+    ASSERT_TRUE(matrix2 != NULL, "Matrix creation failed");
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(num_dpus, 0, rows, inner, inner, cols, rows, cols,
+                                                                                            dtype, dtype, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    ASSERT_EQ(pim_matrix_multiplication_frame_load_second_matrix_strided(frame, data2, cols, false), 0, "Strided load");
+    ASSERT_TRUE(pim_matrix_multiplication_frame_supports_gemm_variant(frame, DPU_PIM_GEMM_OUTER), "Outer-product GEMM should fit");
+    if (!automatic) {
+        ASSERT_EQ(pim_matrix_multiplication_frame_set_gemm_variant(frame, DPU_PIM_GEMM_OUTER), 0, "Set variant");
+    }
+
+    for (int launch = 0; launch < 3; launch++) {
+        if (launch == 2) {
+            ASSERT_EQ(pim_matrix_multiplication_frame_set_gemm_variant(frame, DPU_PIM_GEMM_TILED), 0, "Set variant");
+        }
+        fill_small_values(data1, rows * inner, size, 11 + launch * 101);
+        Matrix* matrix1 = matrix_create_from_row_major_array(rows, inner, data1, size);
+        ASSERT_TRUE(matrix1 != NULL, "Matrix creation failed");
+        pim_matrix_multiplication_frame_load_first_matrix(frame, matrix1);
+        pim_matrix_multiplication_frame_execute(frame);
+        // Only the outer-product GEMM leaves the second matrix row-major
+        ASSERT_EQ(frame->matrix2_pending_transpose, launch < 2, "Second matrix should be converted by the tiled GEMM only");
+        Matrix* result = pim_matrix_multiplication_frame_get_result(frame);
+        Matrix* expected = host_multiply_matrices_typed(matrix1, matrix2, dtype, dtype, DPU_PIM_DTYPE_INT32);
+        ASSERT_TRUE(result != NULL && expected != NULL && matrix_compare(result, expected), "Result matrix should match expected result");
+        matrix_free(result);
+        matrix_free(expected);
+        matrix_free(matrix1);
+    }
+
+    // A transposed load packs the column-major layout directly, so there is no row-major slice to stream
+    ASSERT_EQ(pim_matrix_multiplication_frame_load_second_matrix_strided(frame, data2_t, inner, true), 0, "Transposed load");
+    ASSERT_TRUE(!pim_matrix_multiplication_frame_supports_gemm_variant(frame, DPU_PIM_GEMM_OUTER), "Outer-product GEMM needs a row-major load");
+    destroy_pim_matrix_multiplication_frame(frame);
+    matrix_free(matrix2);
+    free(data1);
+    free(data2);
+    free(data2_t);
+    return 0;
+}
+
+int test_pim_gemm_outer() {
+    printf("Running test_pim_gemm_outer...\n");
+    // Inner dimensions that leave a partial last panel, int16 and int32 operands
+    if (check_gemm_outer(72, 100, 36, 2, DPU_PIM_DTYPE_INT16, false)) return 1;
+    if (check_gemm_outer(40, 50, 32, 1, DPU_PIM_DTYPE_INT32, false)) return 1;
+    // One band of 8 rows per tasklet and a long inner dimension make new frames pick the outer-product GEMM
+    if (check_gemm_outer(128, 96, 24, 1, DPU_PIM_DTYPE_INT16, true)) return 1;
+
+    // Slices wider than the bands fall back to the tiled GEMM
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(1, 0, 8, 16, 16, 520, 8, 520,
+                                                                                            DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT16, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    int16_t* data2 = calloc(16 * 520, sizeof(int16_t));
+    ASSERT_TRUE(data2 != NULL, "Data allocation failed");
+    ASSERT_EQ(pim_matrix_multiplication_frame_load_second_matrix_strided(frame, data2, 520, false), 0, "Strided load");
+    ASSERT_TRUE(!pim_matrix_multiplication_frame_supports_gemm_variant(frame, DPU_PIM_GEMM_OUTER), "Slices should exceed the bands");
+    ASSERT_TRUE(pim_matrix_multiplication_frame_supports_gemm_variant(frame, DPU_PIM_GEMM_TILED), "Tiled GEMM serves any operands");
+
+    // A plan claiming wider bands than the binary has makes the host run the outer-product GEMM, which the DPUs reject
+    int16_t data1[8 * 16] = {0};
+    ASSERT_EQ(pim_matrix_multiplication_frame_load_first_matrix_strided(frame, data1, 16, false), 0, "Strided load");
+    uint32_t outer_cols = frame->kernel_plan.gemm_outer_cols;
+    frame->kernel_plan.gemm_outer_cols = 1024;
+    ASSERT_EQ(pim_matrix_multiplication_frame_set_gemm_variant(frame, DPU_PIM_GEMM_OUTER), 0, "Set variant");
+    ASSERT_EQ(pim_matrix_multiplication_frame_execute(frame), -1, "Over-wide bands should fail on the DPUs");
+    ASSERT_TRUE(!frame->result_valid, "A failed launch should leave no valid result");
+    ASSERT_TRUE(pim_matrix_multiplication_frame_get_result(frame) == NULL, "A failed launch should have no result");
+    frame->kernel_plan.gemm_outer_cols = outer_cols;
+    ASSERT_EQ(pim_matrix_multiplication_frame_execute(frame), 0, "The tiled GEMM should run instead");
+    ASSERT_TRUE(frame->result_valid, "Result should be valid");
+    free(data2);
+    destroy_pim_matrix_multiplication_frame(frame);
+    return 0;
+}
+
 int test_pim_identity_square_matrix_multiplication() {
     printf("Running test_pim_identity_square_matrix_multiplication...\n");
     // Create two sample matrices 16x16
@@ -335,6 +925,115 @@ int test_pim_square_prime_number_of_dpus() {
     return 0;
 }
 
+int test_pim_frame_stats() {
+    printf("Running test_pim_frame_stats...\n");
+    uint8_t data1[12*15], data2[15*8];
+    for (int i = 0; i < 12*15; i++) data1[i] = i % 7;
+    for (int i = 0; i < 15*8; i++) data2[i] = i % 5;
+    Matrix* matrix1 = matrix_create_from_row_major_array(12, 15, (void*)data1, sizeof(uint8_t));
+    Matrix* matrix2 = matrix_create_from_row_major_array(15, 8, (void*)data2, sizeof(uint8_t));
+    ASSERT_TRUE(matrix1 != NULL && matrix2 != NULL, "Matrix creation failed");
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame(4, 0, 12, 15, 15, 8, 12, 8,
+                                                                                      sizeof(uint8_t), sizeof(uint8_t), sizeof(uint16_t));
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    pim_matrix_multiplication_frame_load_first_matrix(frame, matrix1);
+    pim_matrix_multiplication_frame_load_second_matrix(frame, matrix2);
+    pim_matrix_multiplication_frame_execute(frame);
+    Matrix* result = pim_matrix_multiplication_frame_get_result(frame);
+    ASSERT_TRUE(result != NULL, "Result matrix should not be NULL");
+
+    pim_stats_t stats;
+#if PIM_ENABLE_STATS
+    ASSERT_EQ(pim_matrix_multiplication_frame_get_stats(frame, &stats), 0, "Get stats");
+    for (int phase = 0; phase < PIM_STATS_NUM_PHASES; phase++) {
+        ASSERT_EQ(stats.phases[phase].calls, phase == PIM_STATS_PUSH_EPILOGUE ? 0 : 1, pim_stats_phase_name(phase));
+    }
+    ASSERT_EQ(stats.phases[PIM_STATS_PACK_MATRIX1].payload_bytes, 12*15, "First matrix payload");
+    ASSERT_EQ(stats.phases[PIM_STATS_PUSH_MATRIX1].payload_bytes, frame->num_work_groups * 12*15, "First matrix push payload");
+    ASSERT_EQ(stats.phases[PIM_STATS_PUSH_MATRIX2].payload_bytes, frame->work_group_size * 15*8, "Second matrix push payload");
+    ASSERT_EQ(stats.phases[PIM_STATS_PULL_RESULT].payload_bytes, 12*8*sizeof(uint16_t), "Result payload");
+    // Every DPU receives a whole padded slice, so transfers are multiples of 8 bytes per DPU
+    ASSERT_EQ((stats.phases[PIM_STATS_PUSH_MATRIX1].payload_bytes + stats.phases[PIM_STATS_PUSH_MATRIX1].padding_bytes) % (8 * frame->num_dpus), 0,
+              "First matrix transfer size");
+    ASSERT_TRUE(stats.phases[PIM_STATS_PUSH_MATRIX1].padding_bytes > 0, "15 columns of uint8 need padding");
+    ASSERT_TRUE(stats.phases[PIM_STATS_LAUNCH].nanoseconds > 0, "Launch should take time");
+
+    pim_matrix_multiplication_frame_reset_stats(frame);
+    ASSERT_EQ(pim_matrix_multiplication_frame_get_stats(frame, &stats), 0, "Get stats after reset");
+    for (int phase = 0; phase < PIM_STATS_NUM_PHASES; phase++) {
+        ASSERT_EQ(stats.phases[phase].calls, 0, "Calls after reset");
+        ASSERT_EQ(stats.phases[phase].nanoseconds, 0, "Time after reset");
+    }
+#else
+    ASSERT_EQ(pim_matrix_multiplication_frame_get_stats(frame, &stats), -1, "Stats are compiled out");
+#endif
+    destroy_pim_matrix_multiplication_frame(frame);
+    matrix_free(result);
+    matrix_free(matrix1);
+    matrix_free(matrix2);
+    return 0;
+}
+
+int test_pim_frame_dpu_stats() {
+    printf("Running test_pim_frame_dpu_stats...\n");
+    uint8_t data1[20*24], data2[24*16];
+    for (int i = 0; i < 20*24; i++) data1[i] = i % 11;
+    for (int i = 0; i < 24*16; i++) data2[i] = i % 13;
+    Matrix* matrix1 = matrix_create_from_row_major_array(20, 24, (void*)data1, sizeof(uint8_t));
+    Matrix* matrix2 = matrix_create_from_row_major_array(24, 16, (void*)data2, sizeof(uint8_t));
+    ASSERT_TRUE(matrix1 != NULL && matrix2 != NULL, "Matrix creation failed");
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame(4, 0, 20, 24, 24, 16, 20, 16,
+                                                                                      sizeof(uint8_t), sizeof(uint8_t), sizeof(uint16_t));
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    pim_dpu_stats_t dpu_stats;
+    ASSERT_EQ(pim_matrix_multiplication_frame_get_dpu_stats(frame, &dpu_stats), -1, "No DPU stats before execution");
+    pim_matrix_multiplication_frame_load_first_matrix(frame, matrix1);
+    pim_matrix_multiplication_frame_load_second_matrix(frame, matrix2);
+    pim_matrix_multiplication_frame_execute(frame);
+
+    ASSERT_EQ(pim_matrix_multiplication_frame_get_dpu_stats(frame, &dpu_stats), 0, "Get DPU stats");
+    ASSERT_EQ(dpu_stats.num_dpus, frame->num_dpus, "DPU count");
+    ASSERT_EQ(dpu_stats.nr_tasklets, frame->kernel.nr_tasklets, "Tasklet count");
+    ASSERT_TRUE(dpu_stats.dpu_cycles_min <= dpu_stats.dpu_cycles_mean && dpu_stats.dpu_cycles_mean <= dpu_stats.dpu_cycles_max,
+                "DPU cycles mean should lie between min and max");
+    ASSERT_TRUE(dpu_stats.tasklet_cycles_min <= dpu_stats.tasklet_cycles_mean && dpu_stats.tasklet_cycles_mean <= dpu_stats.tasklet_cycles_max,
+                "Tasklet cycles mean should lie between min and max");
+    ASSERT_TRUE(dpu_stats.tasklet_cycles_max <= dpu_stats.dpu_cycles_max, "A DPU lasts as long as its slowest tasklet");
+#if PIM_ENABLE_STATS
+    ASSERT_TRUE(dpu_stats.dpu_cycles_max > 0, "DPUs should report cycles");
+    // Phase cycles are disjoint parts of a tasklet's run
+    for (uint32_t i = 0; i < dpu_stats.num_dpus * dpu_stats.nr_tasklets; i++) {
+        const dpu_pim_tasklet_stats_t* tasklet = &dpu_stats.tasklets[i];
+        ASSERT_TRUE(tasklet->mram_read_cycles + tasklet->compute_cycles + tasklet->mram_write_cycles <= tasklet->total_cycles,
+                    "Phase cycles should not exceed the tasklet cycles");
+    }
+#endif
+    pim_dpu_stats_print(&dpu_stats, stdout);
+    pim_dpu_stats_free(&dpu_stats);
+    destroy_pim_matrix_multiplication_frame(frame);
+    matrix_free(matrix1);
+    matrix_free(matrix2);
+    return 0;
+}
+
+int test_pim_frame_kernel_plan() {
+    printf("Running test_pim_frame_kernel_plan...\n");
+    pim_matrix_multiplication_frame_t* frame = create_pim_matrix_multiplication_frame_typed(2, 0, 16, 32, 32, 16, 16, 16,
+                                                                                            DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT8, DPU_PIM_DTYPE_INT32);
+    ASSERT_TRUE(frame != NULL, "Frame creation failed");
+    const dpu_pim_kernel_plan_t* plan = &frame->kernel_plan;
+    ASSERT_EQ(plan->result_dtype, DPU_PIM_DTYPE_INT32, "Plan result type");
+    ASSERT_EQ(plan->nr_tasklets, frame->kernel.nr_tasklets, "Plan tasklets adopted by the kernel");
+    ASSERT_EQ(plan->tile_rows, frame->kernel.tile_rows, "Plan tile rows adopted by the kernel");
+    ASSERT_EQ(plan->tile_cols, frame->kernel.tile_cols, "Plan tile columns adopted by the kernel");
+    ASSERT_TRUE(plan->gemm_block_elements >= 8 && plan->gemm_block_elements % 8 == 0, "GEMM block should be whole 8-element groups");
+    ASSERT_TRUE(plan->gemm_wram_bytes > 0 && plan->gemm_wram_bytes <= plan->wram_heap_budget, "GEMM plan should fit the heap");
+    ASSERT_TRUE(plan->gemv_wram_bytes > 0 && plan->gemv_wram_bytes <= plan->wram_heap_budget, "GEMV plan should fit the heap");
+    ASSERT_TRUE(plan->fetch_tasklets < plan->nr_tasklets, "Pipelined GEMM should keep a compute tasklet");
+    destroy_pim_matrix_multiplication_frame(frame);
+    return 0;
+}
+
 int main() {
     uint32_t fails = 0;
     printf("Running PIM Matrix Multiplication Frame Unittests...\n");
@@ -344,6 +1043,22 @@ int main() {
     fails += test_pim_frame_misaligned_matrix_multiplication();
     fails += test_pim_rectangular_matrix_multiplication();
     fails += test_pim_square_prime_number_of_dpus();
+    fails += test_pim_int8_int32_accumulation();
+    fails += test_pim_int16_multiplication();
+    fails += test_pim_int32_multiplication();
+    fails += test_pim_unsupported_dtype_combination();
+    fails += test_pim_epilogue_requantize();
+    fails += test_pim_epilogue_bias_clamp();
+    fails += test_pim_gemm_variants();
+    fails += test_pim_gemm_large_slice();
+    fails += test_pim_gemm_kernel_builds();
+    fails += test_pim_gemm_lut();
+    fails += test_pim_row_major_second_matrix();
+    fails += test_pim_staging_region_reserved_on_row_major_load();
+    fails += test_pim_gemm_outer();
+    fails += test_pim_frame_stats();
+    fails += test_pim_frame_dpu_stats();
+    fails += test_pim_frame_kernel_plan();
     if (fails == 0) {
         printf("[PASS] All PIM matrix tests passed!\n");
         return 0;
@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "test_assertions.h"
+
+#include "pim_xfer_model.h"
+
+#define ASSERT_NEAR(expr, expected, msg) \
+    if (fabs((double)(expr) - (double)(expected)) > 1e-6) { \
+        printf("[FAIL] %s (expected %f, got %f)\n", msg, (double)(expected), (double)(expr)); \
+        return 1; \
+    }
+
+static const char* write_test_calibration() {
+    static char path[] = "/tmp/pim_xfer_model_test_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    FILE* calibration = fdopen(fd, "w");
+    fprintf(calibration, "# direction num_dpus bytes_per_dpu nanoseconds\n");
+    fprintf(calibration, "to 8 1024 2000\n");
+    fprintf(calibration, "to 8 4096 5000\n");
+    fprintf(calibration, "to 64 4096 20000\n");
+    fprintf(calibration, "from 8 1024 3000\n");
+    fprintf(calibration, "sideways 8 1024 3000\n");
+    fprintf(calibration, "to 8 1024\n");
+    fprintf(calibration, "to 0 1024 100\n");
+    fclose(calibration);
+    return path;
+}
+
+int test_pim_xfer_model_uncalibrated() {
+    printf("Running test_pim_xfer_model_uncalibrated...\n");
+    pim_xfer_model_clear();
+    ASSERT_TRUE(!pim_xfer_model_calibrated(), "Cleared model should be uncalibrated");
+    ASSERT_NEAR(pim_xfer_model_estimate_ns(PIM_XFER_TO_DPU, 4, 1000), 4000, "One nanosecond per byte");
+    ASSERT_STR_EQ(pim_xfer_direction_name(PIM_XFER_BROADCAST), "broadcast", "Direction name");
+    pim_xfer_direction_t direction;
+    ASSERT_EQ(pim_xfer_direction_from_name("from", &direction), 0, "Parse direction");
+    ASSERT_EQ(direction, PIM_XFER_FROM_DPU, "Parsed direction");
+    ASSERT_EQ(pim_xfer_direction_from_name("sideways", &direction), -1, "Unknown direction");
+    return 0;
+}
+
+int test_pim_xfer_model_load_and_estimate() {
+    printf("Running test_pim_xfer_model_load_and_estimate...\n");
+    const char* path = write_test_calibration();
+    ASSERT_TRUE(path != NULL, "Calibration creation failed");
+    ASSERT_EQ(pim_xfer_model_load(path), 4, "Loaded measurements");
+    ASSERT_TRUE(pim_xfer_model_calibrated(), "Model should be calibrated");
+    // Exact measurement, interpolation, fixed cost below the smallest size and bandwidth above the largest
+    ASSERT_NEAR(pim_xfer_model_estimate_ns(PIM_XFER_TO_DPU, 8, 1024), 2000, "Measured size");
+    ASSERT_NEAR(pim_xfer_model_estimate_ns(PIM_XFER_TO_DPU, 8, 2048), 3000, "Interpolated size");
+    ASSERT_NEAR(pim_xfer_model_estimate_ns(PIM_XFER_TO_DPU, 8, 64), 2000, "Small size");
+    ASSERT_NEAR(pim_xfer_model_estimate_ns(PIM_XFER_TO_DPU, 8, 8192), 10000, "Large size");
+    // The closest DPU count is used and scaled
+    ASSERT_NEAR(pim_xfer_model_estimate_ns(PIM_XFER_TO_DPU, 64, 4096), 20000, "Measured DPU count");
+    ASSERT_NEAR(pim_xfer_model_estimate_ns(PIM_XFER_TO_DPU, 16, 4096), 10000, "Scaled DPU count");
+    // Kinds without measurements fall back to the uncalibrated estimate
+    ASSERT_NEAR(pim_xfer_model_estimate_ns(PIM_XFER_FROM_DPU, 8, 1024), 3000, "Pull measurement");
+    ASSERT_NEAR(pim_xfer_model_estimate_ns(PIM_XFER_BROADCAST, 2, 100), 200, "Uncalibrated kind");
+    ASSERT_EQ(pim_xfer_model_load("/nonexistent/calibration.txt"), -1, "Missing file");
+    pim_xfer_model_clear();
+    remove(path);
+    return 0;
+}
+
+int main() {
+    int fails = 0;
+    fails += test_pim_xfer_model_uncalibrated();
+    fails += test_pim_xfer_model_load_and_estimate();
+    if (fails == 0) {
+        printf("[PASS] All transfer model tests passed!\n");
+        return 0;
+    } else {
+        printf("[FAIL] %d transfer model tests failed.\n", fails);
+        return 1;
+    }
+}